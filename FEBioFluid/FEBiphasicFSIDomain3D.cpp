@@ -103,6 +103,20 @@ void FEBiphasicFSIDomain3D::Activate()
     }
 }
 
+//-----------------------------------------------------------------------------
+bool FEBiphasicFSIDomain3D::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEElasticMaterialPoint>();
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+    CacheMaterialPointData<FEBiphasicFSIMaterialPoint>();
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Initialize element data
 void FEBiphasicFSIDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
@@ -129,9 +143,9 @@ void FEBiphasicFSIDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
                 rt = el.Evaluate(xt, j);
                 
                 FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-                FEElasticMaterialPoint& et = *mp.ExtractData<FEElasticMaterialPoint>();
-                FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
-                FEBiphasicFSIMaterialPoint& ft = *mp.ExtractData<FEBiphasicFSIMaterialPoint>();
+                FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), j);
+                FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
+                FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), j);
                 et.m_Wp = et.m_Wt;
                 
                 if ((pt.m_Jf <= 0) || (et.m_J <= 0)) {
@@ -246,9 +260,9 @@ void FEBiphasicFSIDomain3D::ElementInternalForce(FESolidElement& el, vector<doub
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEElasticMaterialPoint& et = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicFSIMaterialPoint& ft = *(mp.ExtractData<FEBiphasicFSIMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjact(el, Ji, n, tp.alphaf)*gw[n];
@@ -354,7 +368,7 @@ void FEBiphasicFSIDomain3D::ElementBodyForce(FEBodyForce& BF, FESolidElement& el
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEBiphasicFSIMaterialPoint& ft = *mp.ExtractData<FEBiphasicFSIMaterialPoint>();
+        FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         double densf = m_pMat->FluidDensity(mp);
         double densTs = m_pMat->TrueSolidDensity(mp);
         double denss = m_pMat->SolidDensity(mp);
@@ -403,8 +417,8 @@ void FEBiphasicFSIDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEl
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
-        FEBiphasicFSIMaterialPoint& ft = *mp.ExtractData<FEBiphasicFSIMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjact(el, Ji, n, tp.alphaf)*gw[n]*tp.alphaf;
@@ -518,9 +532,9 @@ void FEBiphasicFSIDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, con
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& et = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEBiphasicFSIMaterialPoint& fpt = *(mp.ExtractData<FEBiphasicFSIMaterialPoint>());
+        FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& fpt = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         
         // get the tangents
         mat3ds ss = et.m_s;
@@ -778,9 +792,9 @@ void FEBiphasicFSIDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, co
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& et = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEBiphasicFSIMaterialPoint& fpt = *(mp.ExtractData<FEBiphasicFSIMaterialPoint>());
+        FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& fpt = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         
         double densf = m_pMat->FluidDensity(mp);
         double denss = m_pMat->SolidDensity(mp);
@@ -931,9 +945,9 @@ void FEBiphasicFSIDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEElasticMaterialPoint& ept = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicFSIMaterialPoint& ft = *(mp.ExtractData<FEBiphasicFSIMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEElasticMaterialPoint& ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         
         // elastic material point data
         ept.m_r0 = el.Evaluate(r0, n);
@@ -1041,9 +1055,9 @@ void FEBiphasicFSIDomain3D::ElementInertialForce(FESolidElement& el, vector<doub
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEElasticMaterialPoint& ept = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicFSIMaterialPoint& ft = *(mp.ExtractData<FEBiphasicFSIMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEElasticMaterialPoint& ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicFSIMaterialPoint& ft = *MaterialPointData<FEBiphasicFSIMaterialPoint>(el.GetLocalID(), n);
         double densTf = m_pMat->TrueFluidDensity(mp);
         double densTs = m_pMat->TrueSolidDensity(mp);
         
@@ -93,6 +93,9 @@ bool FEFluidDomain2D::Init()
 {
     // initialize base class
 	FEDomain2D::Init();
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEFluidMaterialPoint>();
     
     // check for initially inverted elements
     int ninverted = 0;
@@ -145,7 +148,7 @@ void FEFluidDomain2D::PreSolveUpdate(const FETimeInfo& timeInfo)
         for (int j=0; j<n; ++j)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+            FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = el.Evaluate(x0, j);
             
             if (pt.m_Jf <= 0) {
@@ -214,7 +217,7 @@ void FEFluidDomain2D::ElementInternalForce(FEElement2D& el, vector<double>& fe)
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjac0(el, Ji, n)*gw[n];
@@ -305,7 +308,7 @@ void FEFluidDomain2D::ElementBodyForce(FEBodyForce& BF, FEElement2D& el, vector<
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -346,7 +349,7 @@ void FEFluidDomain2D::ElementBodyForceStiffness(FEBodyForce& BF, FEElement2D &el
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n];
@@ -414,7 +417,7 @@ void FEFluidDomain2D::ElementMaterialStiffness(FEElement2D &el, matrix &ke)
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // get the tangents
         double dpdJ = m_pMat->Tangent_Pressure_Strain(mp);
@@ -601,7 +604,7 @@ void FEFluidDomain2D::ElementMassMatrix(FEElement2D& el, matrix& ke)
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
 		double dt = GetFEModel()->GetTime().timeIncrement;
         double dens = m_pMat->Density(mp);
@@ -700,7 +703,7 @@ void FEFluidDomain2D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // material point data
         pt.m_vft = el.Evaluate(vt, n)*alphaf + el.Evaluate(vp, n)*(1-alphaf);
@@ -772,7 +775,7 @@ void FEFluidDomain2D::ElementInertialForce(FEElement2D& el, vector<double>& fe)
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         // calculate the jacobian
@@ -98,6 +98,18 @@ void FEFluidDomain3D::Activate()
     }
 }
 
+//-----------------------------------------------------------------------------
+bool FEFluidDomain3D::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Initialize element data
 void FEFluidDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
@@ -118,7 +130,7 @@ void FEFluidDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
         for (int j=0; j<n; ++j)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+            FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = el.Evaluate(x0, j);
             
             if (pt.m_Jf <= 0) {
@@ -205,7 +217,7 @@ void FEFluidDomain3D::ElementInternalForce(FESolidElement& el, vector<double>& f
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjac0(el, Ji, n)*gw[n];
@@ -300,7 +312,7 @@ void FEFluidDomain3D::ElementBodyForce(FEBodyForce& BF, FESolidElement& el, vect
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -342,7 +354,7 @@ void FEFluidDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidElement
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
 
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n]*tp.alphaf;
@@ -411,7 +423,7 @@ void FEFluidDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, const FET
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // get the tangents
         mat3ds svJ = m_pMat->GetViscous()->Tangent_Strain(mp);
@@ -597,7 +609,7 @@ void FEFluidDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, const FE
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         double dens = m_pMat->Density(mp);
         
@@ -703,7 +715,7 @@ void FEFluidDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // material point data
         pt.m_vft = el.Evaluate(vt, n)*alphaf + el.Evaluate(vp, n)*(1-alphaf);
@@ -770,7 +782,7 @@ void FEFluidDomain3D::ElementInertialForce(FESolidElement& el, vector<double>& f
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         // calculate the jacobian
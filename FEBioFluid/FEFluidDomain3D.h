@@ -47,6 +47,9 @@ public:
     //! activate
     void Activate() override;
 
+    //! initialize class
+    bool Init() override;
+
     //! initialize elements
     void PreSolveUpdate(const FETimeInfo& timeInfo) override;
     
@@ -104,6 +104,20 @@ void FEFluidFSIDomain3D::Activate()
     }
 }
 
+//-----------------------------------------------------------------------------
+bool FEFluidFSIDomain3D::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEElasticMaterialPoint>();
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+    CacheMaterialPointData<FEFSIMaterialPoint>();
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Initialize element data
 void FEFluidFSIDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
@@ -130,9 +144,9 @@ void FEFluidFSIDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
                 rt = el.Evaluate(xt, j);
                 
                 FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-                FEElasticMaterialPoint& et = *mp.ExtractData<FEElasticMaterialPoint>();
-                FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
-                FEFSIMaterialPoint& ft = *mp.ExtractData<FEFSIMaterialPoint>();
+                FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), j);
+                FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
+                FEFSIMaterialPoint& ft = *MaterialPointData<FEFSIMaterialPoint>(el.GetLocalID(), j);
                 et.m_Wp = et.m_Wt;
                 
                 if ((pt.m_Jf <= 0) || (et.m_J <= 0)) {
@@ -248,9 +262,9 @@ void FEFluidFSIDomain3D::ElementInternalForce(FESolidElement& el, vector<double>
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEElasticMaterialPoint& et = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEFSIMaterialPoint& ft = *(mp.ExtractData<FEFSIMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEFSIMaterialPoint& ft = *MaterialPointData<FEFSIMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjact(el, Ji, n, tp.alphaf)*gw[n];
@@ -391,7 +405,7 @@ void FEFluidFSIDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEleme
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjact(el, Ji, n, tp.alphaf)*gw[n]*tp.alphaf;
@@ -479,9 +493,9 @@ void FEFluidFSIDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, const
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& et = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEFSIMaterialPoint& fpt = *(mp.ExtractData<FEFSIMaterialPoint>());
+        FEElasticMaterialPoint& et = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEFSIMaterialPoint& fpt = *MaterialPointData<FEFSIMaterialPoint>(el.GetLocalID(), n);
         
         // get the tangents
         mat3ds ss = m_pMat->Solid()->Stress(mp);
@@ -703,8 +717,8 @@ void FEFluidFSIDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, const
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEFSIMaterialPoint& fpt = *(mp.ExtractData<FEFSIMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEFSIMaterialPoint& fpt = *MaterialPointData<FEFSIMaterialPoint>(el.GetLocalID(), n);
         
         double dens = m_pMat->Fluid()->Density(mp);
         
@@ -821,9 +835,9 @@ void FEFluidFSIDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-		FEElasticMaterialPoint& ept = *(mp.ExtractData<FEElasticMaterialPoint>());
-		FEFSIMaterialPoint& ft = *(mp.ExtractData<FEFSIMaterialPoint>());
+		FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+		FEElasticMaterialPoint& ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+		FEFSIMaterialPoint& ft = *MaterialPointData<FEFSIMaterialPoint>(el.GetLocalID(), n);
 
 		// elastic material point data
 		ept.m_r0 = el.Evaluate(r0, n);
@@ -918,7 +932,7 @@ void FEFluidFSIDomain3D::ElementInertialForce(FESolidElement& el, vector<double>
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Fluid()->Density(mp);
         
         // calculate the jacobian
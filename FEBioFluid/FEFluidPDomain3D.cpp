@@ -89,6 +89,18 @@ void FEFluidPDomain3D::SetMaterial(FEMaterial* pmat)
     else m_pMat = 0;
 }
 
+//-----------------------------------------------------------------------------
+bool FEFluidPDomain3D::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Initialize element data
 void FEFluidPDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
@@ -109,7 +121,7 @@ void FEFluidPDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
         for (int j=0; j<n; ++j)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+            FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = el.Evaluate(x0, j);
             
             if (pt.m_Jf <= 0) {
@@ -178,7 +190,7 @@ void FEFluidPDomain3D::ElementInternalForce(FESolidElement& el, vector<double>&
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = invjac0(el, Ji, n)*gw[n];
@@ -273,7 +285,7 @@ void FEFluidPDomain3D::ElementBodyForce(FEBodyForce& BF, FESolidElement& el, vec
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Fluid()->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -315,7 +327,7 @@ void FEFluidPDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidElement
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n]*tp.alphaf;
@@ -385,7 +397,7 @@ void FEFluidPDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, const FE
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // get the tangents
         mat3ds svJ = m_pMat->Fluid()->GetViscous()->Tangent_Strain(mp);
@@ -576,7 +588,7 @@ void FEFluidPDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, const F
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         double dens = m_pMat->Fluid()->Density(mp);
         
@@ -683,7 +695,7 @@ void FEFluidPDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // material point data
         pt.m_vft = el.Evaluate(vt, n)*alphaf + el.Evaluate(vp, n)*(1-alphaf);
@@ -750,7 +762,7 @@ void FEFluidPDomain3D::ElementInertialForce(FESolidElement& el, vector<double>&
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Fluid()->Density(mp);
         
         // calculate the jacobian
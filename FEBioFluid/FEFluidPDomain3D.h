@@ -44,6 +44,9 @@ public:
     //! assignment operator
     FEFluidPDomain3D& operator = (FEFluidPDomain3D& d);
     
+    //! initialize class
+    bool Init() override;
+
     //! initialize elements
     void PreSolveUpdate(const FETimeInfo& timeInfo) override;
     
@@ -96,6 +96,10 @@ bool FEFluidSolutesDomain3D::Init()
 {
     // initialize base class
     if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+    CacheMaterialPointData<FEFluidSolutesMaterialPoint>();
     
     const int nsol = m_pMat->Solutes();
     
@@ -131,7 +135,7 @@ void FEFluidSolutesDomain3D::Reset()
         for (int n=0; n<nint; ++n)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-            FEFluidSolutesMaterialPoint& ps = *(mp.ExtractData<FEFluidSolutesMaterialPoint>());
+            FEFluidSolutesMaterialPoint& ps = *MaterialPointData<FEFluidSolutesMaterialPoint>(el.GetLocalID(), n);
             
             // initialize solutes
             ps.m_nsol = nsol;
@@ -202,7 +206,7 @@ void FEFluidSolutesDomain3D::InitMaterialPoints()
         for (int n = 0; n<nint; ++n)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-            FEFluidSolutesMaterialPoint& ps = *(mp.ExtractData<FEFluidSolutesMaterialPoint>());
+            FEFluidSolutesMaterialPoint& ps = *MaterialPointData<FEFluidSolutesMaterialPoint>(el.GetLocalID(), n);
             
             // initialize solutes
             ps.m_nsol = nsol;
@@ -239,7 +243,7 @@ void FEFluidSolutesDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
         for (int j=0; j<n; ++j)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+            FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = el.Evaluate(x0, j);
             
             if (pt.m_Jf <= 0) {
@@ -314,8 +318,8 @@ void FEFluidSolutesDomain3D::ElementInternalForce(FESolidElement& el, vector<dou
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEFluidSolutesMaterialPoint& spt = *(mp.ExtractData<FEFluidSolutesMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEFluidSolutesMaterialPoint& spt = *MaterialPointData<FEFluidSolutesMaterialPoint>(el.GetLocalID(), n);
 
         // calculate the jacobian
         detJ = invjac0(el, Ji, n)*gw[n];
@@ -416,7 +420,7 @@ void FEFluidSolutesDomain3D::ElementBodyForce(FEBodyForce& BF, FESolidElement& e
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Fluid()->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -458,7 +462,7 @@ void FEFluidSolutesDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidE
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n];
@@ -529,8 +533,8 @@ void FEFluidSolutesDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, co
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEFluidSolutesMaterialPoint& spt = *(mp.ExtractData<FEFluidSolutesMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEFluidSolutesMaterialPoint& spt = *MaterialPointData<FEFluidSolutesMaterialPoint>(el.GetLocalID(), n);
 
         // get the tangents
         mat3ds svJ = m_pMat->Fluid()->GetViscous()->Tangent_Strain(mp);
@@ -739,7 +743,7 @@ void FEFluidSolutesDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, c
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         double dens = m_pMat->Fluid()->Density(mp);
         
@@ -860,8 +864,8 @@ void FEFluidSolutesDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEFluidSolutesMaterialPoint& spt = *(mp.ExtractData<FEFluidSolutesMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEFluidSolutesMaterialPoint& spt = *MaterialPointData<FEFluidSolutesMaterialPoint>(el.GetLocalID(), n);
 
         // material point data
         pt.m_vft = el.Evaluate(vt, n)*alphaf + el.Evaluate(vp, n)*(1-alphaf);
@@ -942,7 +946,7 @@ void FEFluidSolutesDomain3D::ElementInertialForce(FESolidElement& el, vector<dou
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Fluid()->Density(mp);
         
         // calculate the jacobian
@@ -77,6 +77,9 @@ bool FESolutesDomain::Init()
 	// initialize base class
 	if (FESolidDomain::Init() == false) return false;
 
+	// cache the material point data that is needed in the element loops
+	CacheMaterialPointData<FESolutesMaterial::Point>();
+
 	const int nsol = m_pMat->Solutes();
 
 	// set the active degrees of freedom list
@@ -110,7 +113,7 @@ void FESolutesDomain::Reset()
 		for (int n = 0; n<nint; ++n)
 		{
 			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-			FESolutesMaterial::Point& ps = *(mp.ExtractData<FESolutesMaterial::Point>());
+			FESolutesMaterial::Point& ps = *MaterialPointData<FESolutesMaterial::Point>(el.GetLocalID(), n);
 
 			// initialize solutes
 			ps.m_nsol = nsol;
@@ -170,7 +173,7 @@ void FESolutesDomain::InitMaterialPoints()
 		for (int n = 0; n<nint; ++n)
 		{
 			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-			FESolutesMaterial::Point& ps = *(mp.ExtractData<FESolutesMaterial::Point>());
+			FESolutesMaterial::Point& ps = *MaterialPointData<FESolutesMaterial::Point>(el.GetLocalID(), n);
 
 			// initialize solutes
 			ps.m_nsol = nsol;
@@ -267,7 +270,7 @@ void FESolutesDomain::ElementInternalForce(FESolidElement& el, vector<double>& f
 	for (int n = 0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FESolutesMaterial::Point& spt = *(mp.ExtractData<FESolutesMaterial::Point>());
+		FESolutesMaterial::Point& spt = *MaterialPointData<FESolutesMaterial::Point>(el.GetLocalID(), n);
 
 		// calculate the jacobian
 		double detJ = invjac0(el, Ji, n)*gw[n];
@@ -338,7 +341,7 @@ void FESolutesDomain::ElementStiffness(FESolidElement &el, matrix &ke, const FET
 		// setup the material point
 		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FESolutesMaterial::Point& spt = *(mp.ExtractData<FESolutesMaterial::Point>());
+		FESolutesMaterial::Point& spt = *MaterialPointData<FESolutesMaterial::Point>(el.GetLocalID(), n);
 
 		// evaluate spatial gradient of shape functions
 		for (int i = 0; i<neln; ++i)
@@ -466,7 +469,7 @@ void FESolutesDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 	for (int n = 0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FESolutesMaterial::Point& spt = *(mp.ExtractData<FESolutesMaterial::Point>());
+		FESolutesMaterial::Point& spt = *MaterialPointData<FESolutesMaterial::Point>(el.GetLocalID(), n);
 
 		// material point data
 		for (int isol = 0; isol < nsol; ++isol) {
@@ -93,6 +93,19 @@ void FEThermoFluidDomain3D::SetMaterial(FEMaterial* pmat)
     m_Tr = GetFEModel()->GetGlobalConstant("T");
 }
 
+//-----------------------------------------------------------------------------
+bool FEThermoFluidDomain3D::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEFluidMaterialPoint>();
+    CacheMaterialPointData<FEThermoFluidMaterialPoint>();
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Initialize element data
 void FEThermoFluidDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
@@ -113,7 +126,7 @@ void FEThermoFluidDomain3D::PreSolveUpdate(const FETimeInfo& timeInfo)
         for (int j=0; j<n; ++j)
         {
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+            FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = el.Evaluate(x0, j);
             
             if (pt.m_Jf <= 0) {
@@ -183,8 +196,8 @@ void FEThermoFluidDomain3D::ElementInternalForce(FESolidElement& el, vector<doub
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEThermoFluidMaterialPoint& tf = *(mp.ExtractData<FEThermoFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEThermoFluidMaterialPoint& tf = *MaterialPointData<FEThermoFluidMaterialPoint>(el.GetLocalID(), n);
 
         // calculate the jacobian
         detJ = invjac0(el, Ji, n)*gw[n];
@@ -292,7 +305,7 @@ void FEThermoFluidDomain3D::ElementBodyForce(FEBodyForce& BF, FESolidElement& el
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -364,7 +377,7 @@ void FEThermoFluidDomain3D::ElementHeatSupply(FEFluidHeatSupply& BF, FESolidElem
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         pt.m_r0 = el.Evaluate(r0, n);
@@ -404,7 +417,7 @@ void FEThermoFluidDomain3D::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEl
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
 
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n]*tp.alphaf;
@@ -451,7 +464,7 @@ void FEThermoFluidDomain3D::ElementHeatSupplyStiffness(FEFluidHeatSupply& BF, FE
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *mp.ExtractData<FEFluidMaterialPoint>();
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
 
         // calculate the jacobian
         detJ = detJ0(el, n)*gw[n]*tp.alphaf;
@@ -519,8 +532,8 @@ void FEThermoFluidDomain3D::ElementStiffness(FESolidElement &el, matrix &ke, con
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEThermoFluidMaterialPoint& tf = *(mp.ExtractData<FEThermoFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEThermoFluidMaterialPoint& tf = *MaterialPointData<FEThermoFluidMaterialPoint>(el.GetLocalID(), n);
 
         // get the tangents
         mat3ds sv   = m_pMat->GetViscous()->Stress(mp);
@@ -770,7 +783,7 @@ void FEThermoFluidDomain3D::ElementMassMatrix(FESolidElement& el, matrix& ke, co
         // setup the material point
         // NOTE: deformation gradient and determinant have already been evaluated in the stress routine
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         
         double dens = m_pMat->Density(mp);
         
@@ -882,8 +895,8 @@ void FEThermoFluidDomain3D::UpdateElementStress(int iel, const FETimeInfo& tp)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
-        FEThermoFluidMaterialPoint& tf = *(mp.ExtractData<FEThermoFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
+        FEThermoFluidMaterialPoint& tf = *MaterialPointData<FEThermoFluidMaterialPoint>(el.GetLocalID(), n);
         
         // material point data
         pt.m_vft = el.Evaluate(vt, n)*alphaf + el.Evaluate(vp, n)*(1-alphaf);
@@ -957,7 +970,7 @@ void FEThermoFluidDomain3D::ElementInertialForce(FESolidElement& el, vector<doub
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEFluidMaterialPoint& pt = *(mp.ExtractData<FEFluidMaterialPoint>());
+        FEFluidMaterialPoint& pt = *MaterialPointData<FEFluidMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         
         // calculate the jacobian
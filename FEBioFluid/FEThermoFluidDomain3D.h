@@ -44,6 +44,9 @@ public:
     //! assignment operator
     FEThermoFluidDomain3D& operator = (FEThermoFluidDomain3D& d);
     
+    //! initialize class
+    bool Init() override;
+
     //! initialize elements
     void PreSolveUpdate(const FETimeInfo& timeInfo) override;
     
@@ -131,6 +131,7 @@ FEBioModel::FEBioModel()
 	m_ntotalReforms = 0;
 
 	m_pltCompression = 0;
+	m_pltIndex = false;
 	m_pltAppendOnRestart = true;
 
 	// Add the output callback
@@ -346,6 +347,9 @@ bool FEBioModel::Input(const char* szfile)
 
 		// set compression
 		m_pltCompression = fim.m_nplot_compression;
+		if (fim.m_bplot_delta  ) m_pltCompression |= FEBioPlotFile::PLT_FILTER_DELTA;
+		if (fim.m_bplot_shuffle) m_pltCompression |= FEBioPlotFile::PLT_FILTER_SHUFFLE;
+		m_pltIndex = fim.m_bplot_index;
 
 		// define the plot file variables
 		FEModel& fem = *GetFEModel();
@@ -741,6 +745,7 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		ar << npltfmt;
 
 		ar << m_pltCompression;
+		ar << m_pltIndex;
 		ar << m_pltData;
 
 		// data records
@@ -771,6 +776,7 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		assert(npltfmt == 2);
 
 		ar >> m_pltCompression;
+		ar >> m_pltIndex;
 		ar >> m_pltData;
 
 		// remove the plot file (if any)
@@ -783,6 +789,7 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		if (m_pltAppendOnRestart)
 		{
 			// Open for appending
+			pplt->SetStateIndex(m_pltIndex);
 			if (m_plot->Append(*this, m_splot.c_str()) == false)
 			{
 				printf("FATAL ERROR: Failed reopening plot database %s\n", m_splot.c_str());
@@ -793,6 +800,7 @@ void FEBioModel::SerializeIOData(DumpStream &ar)
 		{
 			// create a new plot file
 			pplt->SetCompression(m_pltCompression);
+			pplt->SetStateIndex(m_pltIndex);
 
 			// add plot variables
 			for (FEPlotVariable& vi : m_pltData)
@@ -883,6 +891,7 @@ bool FEBioModel::Init()
 
 			// set compression
 			pplt->SetCompression(m_pltCompression);
+			pplt->SetStateIndex(m_pltIndex);
 
 			// add plot variables
 			for (FEPlotVariable& vi : m_pltData)
@@ -222,6 +222,7 @@ protected: // file names
 protected:
 	vector<FEPlotVariable>	m_pltData;
 	int						m_pltCompression;
+	bool					m_pltIndex;
 	bool					m_pltAppendOnRestart;
 
 private:
@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FECore/FEModel.h"
 #include "FECore/FESolver.h"
 #include "FECore/FEAnalysis.h"
+#include "FECore/log.h"
 
 BEGIN_FECORE_CLASS(FEContactInterface, FESurfacePairConstraint)
 	ADD_PARAMETER(m_laugon, "laugon"        );
@@ -49,6 +50,9 @@ FEContactInterface::FEContactInterface(FEModel* pfem) : FESurfacePairConstraint(
 	m_laugon = 0;	// penalty method by default
     m_psf = 1.0;    // default scale factor is 1
     m_psfmax = 0;   // default max scale factor is not set
+	m_bpatch = false;
+	m_nlocal = 0;
+	m_nglobal = 0;
 }
 
 FEContactInterface::~FEContactInterface()
@@ -105,6 +109,21 @@ double FEContactInterface::AutoPenalty(FESurfaceElement& el, FESurface &s)
 	return eps*A/V;
 }
 
+//-----------------------------------------------------------------------------
+void FEContactInterface::ResetSearchStats()
+{
+	m_nlocal = 0;
+	m_nglobal = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FEContactInterface::ReportSearchStats()
+{
+	int ntotal = m_nlocal + m_nglobal;
+	if ((m_bpatch == false) || (ntotal == 0)) return;
+	feLog(" contact interface # %d: %d of %d points found by local search (%.1lf%%)\n", GetID(), m_nlocal, ntotal, 100.0*m_nlocal / ntotal);
+}
+
 //-----------------------------------------------------------------------------
 void FEContactInterface::Serialize(DumpStream& ar)
 {
@@ -75,11 +75,22 @@ protected:
 
     //! cale the penalty factor during Lagrange augmentation
     double GetPenaltyScaleFactor();
+
+	//! reset the counters of the contact search
+	void ResetSearchStats();
+
+	//! print the fraction of contact points that were found with a local search
+	void ReportSearchStats();
     
 public:
 	int		m_laugon;	//!< contact enforcement method
     double  m_psf;      //!< penalty scale factor during Lagrange augmentation
     double  m_psfmax;   //!< max allowable penalty scale factor during laugon
+	bool	m_bpatch;	//!< search the previous master facet and its neighbors before doing a global search
+
+protected:
+	int		m_nlocal;	//!< number of contact points found by a local search
+	int		m_nglobal;	//!< number of global contact searches
 
 	DECLARE_FECORE_CLASS();
 };
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEContactSurface.h"
 #include "FECore/FEModel.h"
+#include "FECore/FEElemElemList.h"
 #include "FEBioMech/FEElasticMaterial.h"
 #include <assert.h>
 
@@ -39,10 +40,11 @@ FEContactSurface::FEContactSurface(FEModel* pfem) : FESurface(pfem), m_pfem(pfem
 	m_dofX = -1;
 	m_dofY = -1;
 	m_dofZ = -1;
+	m_EEL = nullptr;
 }
 
 //-----------------------------------------------------------------------------
-FEContactSurface::~FEContactSurface() { m_pSibling = 0; m_pContactInterface = 0; }
+FEContactSurface::~FEContactSurface() { m_pSibling = 0; m_pContactInterface = 0; delete m_EEL; }
 
 //-----------------------------------------------------------------------------
 bool FEContactSurface::Init()
@@ -53,6 +55,9 @@ bool FEContactSurface::Init()
 	m_dofY = dofs.GetDOF("y");
 	m_dofZ = dofs.GetDOF("z");
 
+	// the neighbor list needs to be rebuilt
+	delete m_EEL; m_EEL = nullptr;
+
 	return FESurface::Init();
 }
 
@@ -73,6 +78,56 @@ void FEContactSurface::SetSibling(FEContactSurface* ps) { m_pSibling = ps; }
 //-----------------------------------------------------------------------------
 void FEContactSurface::SetContactInterface(FEContactInterface* ps) { m_pContactInterface = ps; }
 
+//-----------------------------------------------------------------------------
+void FEContactSurface::InitNeighborSearch()
+{
+	if (m_EEL == nullptr)
+	{
+		m_EEL = new FEElemElemList;
+		m_EEL->Create(this);
+	}
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceElement* FEContactSurface::FindNeighborProjection(FESurfaceElement& el, const vec3d& x, vec3d& q, vec2d& rs, double tol)
+{
+	assert(m_EEL);
+	int nf = el.facet_edges();
+	for (int i=0; i<nf; ++i)
+	{
+		FESurfaceElement* pn = static_cast<FESurfaceElement*>(m_EEL->Neighbor(el.m_lid, i));
+		if (pn)
+		{
+			double r = 0, s = 0;
+			vec3d qn = ProjectToSurface(*pn, x, r, s);
+			if (IsInsideElement(*pn, r, s, tol))
+			{
+				q = qn;
+				rs = vec2d(r, s);
+				return pn;
+			}
+		}
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceElement* FEContactSurface::FindNeighborIntersection(FESurfaceElement& el, const vec3d& r, const vec3d& n, double rs[2], double& g, double tol)
+{
+	assert(m_EEL);
+	int nf = el.facet_edges();
+	for (int i=0; i<nf; ++i)
+	{
+		FESurfaceElement* pn = static_cast<FESurfaceElement*>(m_EEL->Neighbor(el.m_lid, i));
+		if (pn)
+		{
+			rs[0] = rs[1] = 0.0;
+			if (Intersect(*pn, r, n, rs, g, tol)) return pn;
+		}
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void FEContactSurface::GetVectorGap(int nface, vec3d& pg) {}
 
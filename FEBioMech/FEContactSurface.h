@@ -33,6 +33,8 @@ SOFTWARE.*/
 #include "FEContactInterface.h"
 #include "febiomech_api.h"
 
+class FEElemElemList;
+
 //-----------------------------------------------------------------------------
 // Stores material point data for contact interfaces
 class FEBIOMECH_API FEContactMaterialPoint : public FESurfaceMaterialPoint
@@ -106,10 +108,24 @@ public:
 
 	FEModel* GetFEModel() { return m_pfem; }
 
+public:
+	//! Build the facet neighbor list used by the local searches below. 
+	//! This must be called before the local searches are used in a parallel loop.
+	void InitNeighborSearch();
+
+	//! Find a neighbor of facet el that contains the closest point projection of x.
+	//! Returns null if x does not project onto any of the neighbors.
+	FESurfaceElement* FindNeighborProjection(FESurfaceElement& el, const vec3d& x, vec3d& q, vec2d& rs, double tol);
+
+	//! Find a neighbor of facet el that is intersected by the ray (r, n).
+	//! Returns null if the ray does not intersect any of the neighbors.
+	FESurfaceElement* FindNeighborIntersection(FESurfaceElement& el, const vec3d& r, const vec3d& n, double rs[2], double& g, double tol);
+
 protected:
 	FEContactSurface* m_pSibling;
     FEContactInterface* m_pContactInterface;
 	FEModel*	m_pfem;
+	FEElemElemList*	m_EEL;	//!< facet neighbors (used for local searches)
 
 	int	m_dofX;
 	int	m_dofY;
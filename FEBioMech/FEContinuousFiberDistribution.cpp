@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEContinuousFiberDistribution.h"
+#include <FECore/FEModel.h>
 
 BEGIN_FECORE_CLASS(FEContinuousFiberDistribution, FEElasticMaterial)
 
@@ -36,6 +37,8 @@ BEGIN_FECORE_CLASS(FEContinuousFiberDistribution, FEElasticMaterial)
 	ADD_PROPERTY(m_pFDD, "distribution");
 	ADD_PROPERTY(m_pFint, "scheme");
 
+	ADD_PARAMETER(m_bcache, "cache_densities");
+
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -44,6 +47,7 @@ FEContinuousFiberDistribution::FEContinuousFiberDistribution(FEModel* pfem) : FE
 	m_pFmat = 0;
 	m_pFDD = 0;
 	m_pFint = 0;
+	m_bcache = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -58,6 +62,12 @@ bool FEContinuousFiberDistribution::Init()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+FEMaterialPoint* FEContinuousFiberDistribution::CreateMaterialPointData()
+{
+	return new FEFiberMaterialPoint(FEElasticMaterial::CreateMaterialPointData());
+}
+
 //-----------------------------------------------------------------------------
 //! Serialization
 void FEContinuousFiberDistribution::Serialize(DumpStream& ar)
@@ -70,6 +80,15 @@ void FEContinuousFiberDistribution::Serialize(DumpStream& ar)
 //! calculate stress at material point
 mat3ds FEContinuousFiberDistribution::Stress(FEMaterialPoint& mp)
 { 
+	// evaluate all fibers in one batch if the densities are cached
+	FEFiberMaterialPoint* fp = FiberDensities(mp);
+	if (fp)
+	{
+		int nint = m_pFint->FixedRulePoints();
+		mat3ds s = m_pFmat->FiberStressSum(mp, nint, m_pFint->FixedRuleFibers(), &fp->m_Rw[0]);
+		return s / fp->m_IFD;
+	}
+
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
 	// calculate stress
@@ -113,6 +132,15 @@ mat3ds FEContinuousFiberDistribution::Stress(FEMaterialPoint& mp)
 //! calculate tangent stiffness at material point
 tens4ds FEContinuousFiberDistribution::Tangent(FEMaterialPoint& mp)
 {
+	// evaluate all fibers in one batch if the densities are cached
+	FEFiberMaterialPoint* fp = FiberDensities(mp);
+	if (fp)
+	{
+		int nint = m_pFint->FixedRulePoints();
+		tens4ds c = m_pFmat->FiberTangentSum(mp, nint, m_pFint->FixedRuleFibers(), &fp->m_Rw[0]);
+		return c / fp->m_IFD;
+	}
+
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 
 	// get the local coordinate systems
@@ -222,3 +250,47 @@ double FEContinuousFiberDistribution::IntegratedFiberDensity(FEMaterialPoint& mp
 
 	return IFD;
 }
+
+//-----------------------------------------------------------------------------
+// Returns the material point data with the fiber densities, evaluated for the current time. 
+// This returns null if the integration scheme doesn't have a fixed rule, or if the cache is disabled.
+FEFiberMaterialPoint* FEContinuousFiberDistribution::FiberDensities(FEMaterialPoint& mp)
+{
+	if (m_bcache == false) return nullptr;
+
+	int nint = m_pFint->FixedRulePoints();
+	if (nint == 0) return nullptr;
+
+	FEFiberMaterialPoint* fp = mp.ExtractData<FEFiberMaterialPoint>();
+	if (fp == nullptr) return nullptr;
+
+	// see if the cached values are still valid
+	double time = GetFEModel()->GetTime().currentTime;
+	if (fp->IsValid(time) && ((int)fp->m_Rw.size() == nint)) return fp;
+
+	// get the local coordinate systems
+	mat3d Qt = GetLocalCS(mp).transpose();
+
+	// evaluate the fiber densities
+	const vec3d* fiber = m_pFint->FixedRuleFibers();
+	const double* w = m_pFint->FixedRuleWeights();
+	fp->m_Rw.resize(nint);
+	for (int i = 0; i < nint; ++i)
+	{
+		// convert to local coordinates
+		vec3d n0 = Qt*fiber[i];
+
+		// evaluate ellipsoidally distributed material coefficients
+		double R = m_pFDD->FiberDensity(mp, n0);
+
+		fp->m_Rw[i] = R*w[i];
+	}
+
+	// get integrated fiber density
+	fp->m_IFD = IntegratedFiberDensity(mp);
+
+	fp->m_time = time;
+	fp->m_bvalid = true;
+
+	return fp;
+}
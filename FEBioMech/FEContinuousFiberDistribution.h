@@ -45,6 +45,9 @@ public:
     // Initialization
     bool Init() override;
 
+	//! create material point data
+	FEMaterialPoint* CreateMaterialPointData() override;
+
 public:
 	//! calculate stress at material point
 	mat3ds Stress(FEMaterialPoint& pt) override;
@@ -61,10 +64,15 @@ public:
 protected:
 	double IntegratedFiberDensity(FEMaterialPoint& mp);
 
+	//! returns the cached fiber densities, or null if the fibers must be evaluated with an iterator
+	FEFiberMaterialPoint* FiberDensities(FEMaterialPoint& mp);
+
 protected:
     FEElasticFiberMaterial*     m_pFmat;    // pointer to fiber material
 	FEFiberDensityDistribution* m_pFDD;     // pointer to fiber density distribution
 	FEFiberIntegrationScheme*   m_pFint;    // pointer to fiber integration scheme
 
+	bool	m_bcache;	//!< cache the fiber densities at the material points
+
 	DECLARE_FECORE_CLASS();
 };
@@ -57,3 +57,19 @@ vec3d FEElasticFiberMaterial::FiberVector(FEMaterialPoint& mp)
 
 	return a0;
 }
+
+//-----------------------------------------------------------------------------
+mat3ds FEElasticFiberMaterial::FiberStressSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w)
+{
+	mat3ds s; s.zero();
+	for (int i = 0; i < n; ++i) s += FiberStress(mp, a0[i])*w[i];
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEElasticFiberMaterial::FiberTangentSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w)
+{
+	tens4ds c; c.zero();
+	for (int i = 0; i < n; ++i) c += FiberTangent(mp, a0[i])*w[i];
+	return c;
+}
@@ -49,6 +49,12 @@ public:
 	//! Strain energy density
 	virtual double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) = 0;
 
+	// Batched versions, which return the weighted sum over n fiber directions a0[i] with weights w[i]. 
+	// The default implementations call FiberStress and FiberTangent for each fiber. Fiber materials
+	// can override these to evaluate all fibers in one pass.
+	virtual mat3ds FiberStressSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w);
+	virtual tens4ds FiberTangentSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w);
+
 private:
 	// These are made private since fiber materials should implement the functions above instead. 
 	// The functions can still be reached when a fiber material is used in an elastic mixture. 
@@ -36,6 +36,8 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioMech.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementTraits.h>
+#include <typeinfo>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -47,6 +49,7 @@ FEElasticSolidDomain::FEElasticSolidDomain(FEModel* pfem) : FESolidDomain(pfem),
     m_alphaf = m_beta = 1;
     m_alpham = 2;
 	m_update_dynamic = true; // default for backward compatibility
+	m_kernelType = -1;
 
 	// TODO: Move this elsewhere since there is no error checking
 	m_dofU.AddVariable(FEBioMech::GetVariableName(FEBioMech::DISPLACEMENT));
@@ -93,6 +96,55 @@ void FEElasticSolidDomain::SetMaterial(FEMaterial* pmat)
 	else m_pMat = 0;
 }
 
+//-----------------------------------------------------------------------------
+bool FEElasticSolidDomain::Init()
+{
+	if (FESolidDomain::Init() == false) return false;
+
+	// cache the elastic material point data, so that the element loops don't need to look it up
+	CacheMaterialPointData<FEElasticMaterialPoint>();
+
+	// see if we can use the fixed-size element loops
+	UpdateKernelType();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticSolidDomain::UpdateKernelType()
+{
+	m_kernelType = -1;
+
+	// The fixed-size loops bypass the virtual element routines (e.g. ElementStiffness), 
+	// so they are only used by this class and not by any derived domain, which may 
+	// override those routines.
+	if (typeid(*this) != typeid(FEElasticSolidDomain)) return;
+
+	int NE = Elements();
+	if (NE == 0) return;
+
+	// all elements must be of the same type
+	int ntype = m_Elem[0].Type();
+	for (int i = 1; i < NE; ++i)
+	{
+		if (m_Elem[i].Type() != ntype) return;
+	}
+
+	// only these element types have fixed-size loops
+	switch (ntype)
+	{
+	case FE_HEX8G8:
+	case FE_TET4G1:
+	case FE_TET4G4:
+	case FE_TET10G4:
+	case FE_TET10G8:
+	case FE_HEX20G8:
+	case FE_HEX20G27:
+		m_kernelType = ntype;
+		break;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::Activate()
 {
@@ -124,6 +176,8 @@ void FEElasticSolidDomain::Serialize(DumpStream& ar)
 	ar & m_alpham;
 	ar & m_beta;
 	ar & m_update_dynamic;
+
+	if (ar.IsLoading()) UpdateKernelType();
 }
 
 //-----------------------------------------------------------------------------
@@ -144,7 +198,7 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 			for (int j = 0; j < n; ++j)
 			{
 				FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-				FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+				FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>((int)i, j);
 				pt.m_Wp = pt.m_Wt;
 
 				mp.Update(timeInfo);
@@ -153,9 +207,236 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// The fixed-size element loops below do the same calculations as the generic versions
+// (in the same order), but the element vectors and matrices live on the stack and all
+// loop counts are known at compile time.
+template <class T> void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, double* fe)
+{
+	const int NELN = T::NELN;
+	const int NINT = T::NINT;
+
+	const double* gw = el.GaussWeights();
+
+	vec3d G[NELN];
+	for (int n = 0; n < NINT; ++n)
+	{
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+
+		// calculate the jacobian and global gradients of the shape functions
+		// (this uses the kinematics cache when it is valid)
+		double detJt = (m_update_dynamic ? ShapeGradient(el, n, G, m_alphaf) : ShapeGradient(el, n, G));
+		detJt *= gw[n];
+
+		// get the stress vector for this integration point
+		const mat3ds& s = pt.m_s;
+
+		for (int i = 0; i < NELN; ++i)
+		{
+			const double Gx = G[i].x;
+			const double Gy = G[i].y;
+			const double Gz = G[i].z;
+
+			fe[3*i  ] -= (Gx*s.xx() + Gy*s.xy() + Gz*s.xz())*detJt;
+			fe[3*i+1] -= (Gy*s.yy() + Gx*s.xy() + Gz*s.yz())*detJt;
+			fe[3*i+2] -= (Gz*s.zz() + Gy*s.yz() + Gx*s.xz())*detJt;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class T> void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
+{
+	const int NDOF = 3*T::NELN;
+
+	int NE = Elements();
+	#pragma omp parallel shared(NE)
+	{
+		// the element vectors are reused for all elements of this thread
+		vector<double> fe(NDOF);
+		vector<int> lm;
+
+		#pragma omp for
+		for (int i = 0; i < NE; ++i)
+		{
+			FESolidElement& el = m_Elem[i];
+			if (el.isActive())
+			{
+				for (int j = 0; j < NDOF; ++j) fe[j] = 0.0;
+				ElementInternalForce<T>(el, &fe[0]);
+
+				UnpackLM(el, lm);
+				R.Assemble(el.m_node, lm, fe);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Calculates the geometrical and material stiffness of an element. The matrix ke
+// is stored row-wise and must be zeroed by the caller. The shape function gradients 
+// at all integration points are stored in the work array Gw (of size NINT*NELN).
+template <class T> void FEElasticSolidDomain::ElementStiffness(FESolidElement& el, double* ke, vec3d* G)
+{
+	const int NELN = T::NELN;
+	const int NINT = T::NINT;
+	const int NDOF = 3*NELN;
+
+	const double* gw = el.GaussWeights();
+
+	// integration weights at all integration points
+	double w[NINT];
+
+	// geometrical stiffness
+	for (int n = 0; n < NINT; ++n)
+	{
+		// shape function gradients (this uses the kinematics cache when it is valid)
+		vec3d* Gn = G + n*NELN;
+		w[n] = ShapeGradient(el, n, Gn, m_alphaf)*gw[n]*m_alphaf;
+
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+		const mat3ds& s = pt.m_s;
+
+		for (int i = 0; i < NELN; ++i)
+		{
+			double* ki = ke + 3*i*NDOF;
+			for (int j = 0; j < NELN; ++j)
+			{
+				double kab = (Gn[i] * (s * Gn[j]))*w[n];
+
+				ki[3*j            ] += kab;
+				ki[3*j + 1 +   NDOF] += kab;
+				ki[3*j + 2 + 2*NDOF] += kab;
+			}
+		}
+	}
+
+	// material stiffness
+	double D[6][6];
+	double DBL[6][3];
+	for (int n = 0; n < NINT; ++n)
+	{
+		// get the 'D' matrix
+		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+		tens4dmm C = m_pMat->m_secant ? m_pMat->SecantTangent(mp) : m_pMat->Tangent(mp);
+		C.extract(D);
+
+		const vec3d* Gn = G + n*NELN;
+
+		const double detJt = w[n];
+		for (int i = 0; i < NELN; ++i)
+		{
+			const double Gxi = Gn[i].x;
+			const double Gyi = Gn[i].y;
+			const double Gzi = Gn[i].z;
+
+			double* k0 = ke + 3*i*NDOF;
+			double* k1 = k0 + NDOF;
+			double* k2 = k1 + NDOF;
+			for (int j = 0; j < NELN; ++j)
+			{
+				const double Gxj = Gn[j].x;
+				const double Gyj = Gn[j].y;
+				const double Gzj = Gn[j].z;
+
+				// calculate D*BL matrices
+				for (int k = 0; k < 6; ++k)
+				{
+					DBL[k][0] = (D[k][0]*Gxj + D[k][3]*Gyj + D[k][5]*Gzj);
+					DBL[k][1] = (D[k][1]*Gyj + D[k][3]*Gxj + D[k][4]*Gzj);
+					DBL[k][2] = (D[k][2]*Gzj + D[k][4]*Gyj + D[k][5]*Gxj);
+				}
+
+				k0[3*j  ] += (Gxi*DBL[0][0] + Gyi*DBL[3][0] + Gzi*DBL[5][0])*detJt;
+				k0[3*j+1] += (Gxi*DBL[0][1] + Gyi*DBL[3][1] + Gzi*DBL[5][1])*detJt;
+				k0[3*j+2] += (Gxi*DBL[0][2] + Gyi*DBL[3][2] + Gzi*DBL[5][2])*detJt;
+
+				k1[3*j  ] += (Gyi*DBL[1][0] + Gxi*DBL[3][0] + Gzi*DBL[4][0])*detJt;
+				k1[3*j+1] += (Gyi*DBL[1][1] + Gxi*DBL[3][1] + Gzi*DBL[4][1])*detJt;
+				k1[3*j+2] += (Gyi*DBL[1][2] + Gxi*DBL[3][2] + Gzi*DBL[4][2])*detJt;
+
+				k2[3*j  ] += (Gzi*DBL[2][0] + Gyi*DBL[4][0] + Gxi*DBL[5][0])*detJt;
+				k2[3*j+1] += (Gzi*DBL[2][1] + Gyi*DBL[4][1] + Gxi*DBL[5][1])*detJt;
+				k2[3*j+2] += (Gzi*DBL[2][2] + Gyi*DBL[4][2] + Gxi*DBL[5][2])*detJt;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class T> void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
+{
+	const int NDOF = 3*T::NELN;
+
+	LS.BeginColoredAssembly();
+	UpdateScatterMaps(LS);
+
+	const int NC = ElementColors();
+	#pragma omp parallel
+	{
+		// The element matrix and work arrays are reused for all elements of this thread.
+		// They are allocated on the heap since they are too large for the worker stacks
+		// (e.g. 28.8 KB for the HEX20 matrix).
+		vector<int> lm;
+		FEElementMatrix ke;
+		ke.resize(NDOF, NDOF);
+		vector<double> kd(NDOF*NDOF);
+		vector<vec3d> G(T::NINT*T::NELN);
+
+		for (int ncol = 0; ncol < NC; ++ncol)
+		{
+			const vector<int>& elemList = ElementColor(ncol);
+			const int NE = (int)elemList.size();
+
+			// (the implicit barrier at the end of this loop separates the colors)
+			#pragma omp for
+			for (int n = 0; n < NE; ++n)
+			{
+				int iel = elemList[n];
+				FESolidElement& el = m_Elem[iel];
+				if (el.isActive())
+				{
+					for (int i = 0; i < NDOF*NDOF; ++i) kd[i] = 0.0;
+					ElementStiffness<T>(el, &kd[0], &G[0]);
+
+					for (int i = 0; i < NDOF; ++i)
+					{
+						double* ki = ke[i];
+						const double* kdi = &kd[i*NDOF];
+						for (int j = 0; j < NDOF; ++j) ki[j] = kdi[j];
+					}
+
+					UnpackLM(el, lm);
+					ke.SetNodes(el.m_node);
+					ke.SetIndices(lm);
+					ke.SetScatterMap(nullptr);
+					ke.SetConstrained(el.isConstrained());
+
+					SetScatterMap(iel, ke, LS);
+					LS.Assemble(ke);
+				}
+			}
+		}
+	}
+
+	LS.EndColoredAssembly();
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 {
+	// use the fixed-size loops if we can
+	switch (m_kernelType)
+	{
+	case FE_HEX8G8   : InternalForces<FEHex8G8  >(R); return;
+	case FE_TET4G1   : InternalForces<FETet4G1  >(R); return;
+	case FE_TET4G4   : InternalForces<FETet4G4  >(R); return;
+	case FE_TET10G4  : InternalForces<FETet10G4 >(R); return;
+	case FE_TET10G8  : InternalForces<FETet10G8 >(R); return;
+	case FE_HEX20G8  : InternalForces<FEHex20G8 >(R); return;
+	case FE_HEX20G27 : InternalForces<FEHex20G27>(R); return;
+	}
+
 	int NE = Elements();
 	#pragma omp parallel for shared (NE)
 	for (int i=0; i<NE; ++i)
@@ -189,8 +470,8 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 
 void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
 {
-	// jacobian matrix, inverse jacobian matrix and determinants
-	double Ji[3][3];
+	// spatial shape function gradients
+	vec3d G[FEElement::MAX_NODES];
 
 	int nint = el.GaussPoints();
 	int neln = el.Nodes();
@@ -201,27 +482,22 @@ void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<doubl
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
 
-		// calculate the jacobian
-		double detJt = (m_update_dynamic ? invjact(el, Ji, n, m_alphaf) : invjact(el, Ji, n));
+		// calculate the jacobian and the global gradient of the shape functions
+		// (these come from the kinematics cache if it is enabled)
+		double detJt = (m_update_dynamic ? ShapeGradient(el, n, G, m_alphaf) : ShapeGradient(el, n, G));
 
 		detJt *= gw[n];
 
 		// get the stress vector for this integration point
         const mat3ds& s = pt.m_s;
 
-		const double* Gr = el.Gr(n);
-		const double* Gs = el.Gs(n);
-		const double* Gt = el.Gt(n);
-
 		for (int i=0; i<neln; ++i)
 		{
-			// calculate global gradient of shape functions
-			// note that we need the transposed of Ji, not Ji itself !
-			double Gx = Ji[0][0]*Gr[i]+Ji[1][0]*Gs[i]+Ji[2][0]*Gt[i];
-			double Gy = Ji[0][1]*Gr[i]+Ji[1][1]*Gs[i]+Ji[2][1]*Gt[i];
-			double Gz = Ji[0][2]*Gr[i]+Ji[1][2]*Gs[i]+Ji[2][2]*Gt[i];
+			double Gx = G[i].x;
+			double Gy = G[i].y;
+			double Gz = G[i].z;
 
 			// calculate internal force
 			// the '-' sign is so that the internal forces get subtracted
@@ -292,7 +568,7 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 
 		// get the material point data
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
 
 		// element's Cauchy-stress tensor at gauss point n
 		mat3ds& s = pt.m_s;
@@ -410,45 +686,66 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
-	// repeat over all solid elements
-	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
+	// use the fixed-size loops if we can
+	switch (m_kernelType)
 	{
-		FESolidElement& el = m_Elem[iel];
+	case FE_HEX8G8   : StiffnessMatrix<FEHex8G8  >(LS); return;
+	case FE_TET4G1   : StiffnessMatrix<FETet4G1  >(LS); return;
+	case FE_TET4G4   : StiffnessMatrix<FETet4G4  >(LS); return;
+	case FE_TET10G4  : StiffnessMatrix<FETet10G4 >(LS); return;
+	case FE_TET10G8  : StiffnessMatrix<FETet10G8 >(LS); return;
+	case FE_HEX20G8  : StiffnessMatrix<FEHex20G8 >(LS); return;
+	case FE_HEX20G27 : StiffnessMatrix<FEHex20G27>(LS); return;
+	}
 
-		if (el.isActive()) {
+	// The elements are processed one color at a time. Elements of the same
+	// color do not share nodes, so they can be assembled without locking.
+	LS.BeginColoredAssembly();
 
-			// get the element's LM vector
-			vector<int> lm;
-			UnpackLM(el, lm);
+	// make sure the cached element scatter maps match the global matrix
+	UpdateScatterMaps(LS);
+
+	const int NC = ElementColors();
+	for (int ncol = 0; ncol < NC; ++ncol)
+	{
+		const vector<int>& elemList = ElementColor(ncol);
+		int NE = (int)elemList.size();
+
+		#pragma omp parallel for shared (NE)
+		for (int n = 0; n < NE; ++n)
+		{
+			int iel = elemList[n];
+			FESolidElement& el = m_Elem[iel];
 
-			// element stiffness matrix
-			FEElementMatrix ke(el, lm);
+			if (el.isActive()) {
 
-			// create the element's stiffness matrix
-			int ndof = 3 * el.Nodes();
-			ke.resize(ndof, ndof);
-			ke.zero();
-
-			// calculate geometrical stiffness
-			ElementGeometricalStiffness(el, ke);
-
-			// calculate material stiffness
-			ElementMaterialStiffness(el, ke);
-
-/*			// assign symmetic parts
-			// TODO: Can this be omitted by changing the Assemble routine so that it only
-			// grabs elements from the upper diagonal matrix?
-			for (int i = 0; i < ndof; ++i)
-				for (int j = i + 1; j < ndof; ++j)
-					ke[j][i] = ke[i][j];
-*/
-			// assemble element matrix in global stiffness matrix
-			LS.Assemble(ke);
+				// get the element's LM vector
+				vector<int> lm;
+				UnpackLM(el, lm);
+
+				// element stiffness matrix
+				FEElementMatrix ke(el, lm);
+
+				// create the element's stiffness matrix
+				int ndof = 3 * el.Nodes();
+				ke.resize(ndof, ndof);
+				ke.zero();
+
+				// calculate geometrical stiffness
+				ElementGeometricalStiffness(el, ke);
+
+				// calculate material stiffness
+				ElementMaterialStiffness(el, ke);
+
+				// assemble element matrix in global stiffness matrix
+				SetScatterMap(iel, ke, LS);
+				LS.Assemble(ke);
+			}
 		}
 	}
+
+	// this assembles the linear constraint and rigid body contributions
+	LS.EndColoredAssembly();
 }
 
 //-----------------------------------------------------------------------------
@@ -607,7 +904,7 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
 
 		// material point coordinates
 		pt.m_rt = el.Evaluate(r, n);
@@ -744,7 +1041,7 @@ void FEElasticSolidDomain::ElementInertialForce(FESolidElement& el, vector<doubl
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
         double dens = m_pMat->Density(mp);
         double J0 = detJ0(el, n)*gw[n];
         
@@ -47,6 +47,9 @@ public:
 	//! activate
 	void Activate() override;
 
+	//! initialize the domain
+	bool Init() override;
+
 	//! initialize elements
 	void PreSolveUpdate(const FETimeInfo& timeInfo) override;
 
@@ -115,7 +118,24 @@ public:
 
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
-    
+
+protected:
+	// Fixed-size versions of the element loops. The template parameter is one of the
+	// element traits classes (e.g. FEHex8G8), which defines the number of nodes and 
+	// integration points at compile time. 
+	template <class T> void InternalForces(FEGlobalVector& R);
+	template <class T> void StiffnessMatrix(FELinearSystem& LS);
+	template <class T> void ElementInternalForce(FESolidElement& el, double* fe);
+	template <class T> void ElementStiffness(FESolidElement& el, double* ke, vec3d* G);
+
+	//! Find the element type for which the fixed-size element loops can be used. 
+	void UpdateKernelType();
+
+	// The element type of the fixed-size element loops, or -1 if the generic loops are used.
+	// NOTE: The fixed-size loops do not call the virtual element routines, so they are 
+	//       never used for classes derived from this one (see UpdateKernelType).
+	int		m_kernelType;
+
 protected:
     double              m_alphaf;
     double              m_alpham;
@@ -156,6 +156,95 @@ double FEFiberExpPow::FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d&
 }
 
 
+//-----------------------------------------------------------------------------
+// The fibers are processed in blocks. The fiber invariants of a block are evaluated 
+// first, so that this loop can be vectorized, and only the fibers in tension 
+// are evaluated further.
+#define FIBER_BLOCK_SIZE	64
+
+//-----------------------------------------------------------------------------
+mat3ds FEFiberExpPow::FiberStressSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	// deformation gradient
+	const mat3d& F = pt.m_F;
+	const double J = pt.m_J;
+	const mat3ds C = pt.RightCauchyGreen();
+
+	mat3ds s; s.zero();
+
+	double In_1[FIBER_BLOCK_SIZE];
+	for (int i0 = 0; i0 < n; i0 += FIBER_BLOCK_SIZE)
+	{
+		const int nb = (n - i0 < FIBER_BLOCK_SIZE ? n - i0 : FIBER_BLOCK_SIZE);
+		const vec3d* n0 = a0 + i0;
+
+		// Calculate In = n0*C*n0
+		for (int i = 0; i < nb; ++i) In_1[i] = n0[i]*(C*n0[i]) - 1.0;
+
+		for (int i = 0; i < nb; ++i)
+		{
+			// only take fibers in tension into consideration
+			if (In_1[i] >= 0)
+			{
+				// get the global spatial fiber direction in current configuration
+				vec3d nt = F*n0[i];
+
+				// calculate strain energy derivative
+				double Wl = m_ksi*pow(In_1[i], m_beta - 1.0)*exp(m_alpha*pow(In_1[i], m_beta));
+
+				// add the fiber stress
+				s += dyad(nt)*(2.0*Wl/J)*w[i0 + i];
+			}
+		}
+	}
+
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEFiberExpPow::FiberTangentSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w)
+{
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+
+	// deformation gradient
+	const mat3d& F = pt.m_F;
+	const double J = pt.m_J;
+	const mat3ds C = pt.RightCauchyGreen();
+
+	tens4ds c; c.zero();
+
+	double In_1[FIBER_BLOCK_SIZE];
+	for (int i0 = 0; i0 < n; i0 += FIBER_BLOCK_SIZE)
+	{
+		const int nb = (n - i0 < FIBER_BLOCK_SIZE ? n - i0 : FIBER_BLOCK_SIZE);
+		const vec3d* n0 = a0 + i0;
+
+		// Calculate In = n0*C*n0
+		for (int i = 0; i < nb; ++i) In_1[i] = n0[i]*(C*n0[i]) - 1.0;
+
+		for (int i = 0; i < nb; ++i)
+		{
+			// only take fibers in tension into consideration
+			if (In_1[i] >= 0)
+			{
+				// get the global spatial fiber direction in current configuration
+				vec3d nt = F*n0[i];
+
+				// calculate strain energy 2nd derivative
+				double tmp = m_alpha*pow(In_1[i], m_beta);
+				double Wll = m_ksi*pow(In_1[i], m_beta - 2.0)*((tmp + 1)*m_beta - 1.0)*exp(tmp);
+
+				// add the fiber tangent
+				c += dyad1s(dyad(nt))*(4.0*Wll/J)*w[i0 + i];
+			}
+		}
+	}
+
+	return c;
+}
+
 //-----------------------------------------------------------------------------
 // FEFiberExponentialPower
 //-----------------------------------------------------------------------------
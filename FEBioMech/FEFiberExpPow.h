@@ -46,6 +46,12 @@ public:
 	
 	//! Strain energy density
 	double FiberStrainEnergyDensity(FEMaterialPoint& mp, const vec3d& a0) override;
+
+	//! weighted sum of fiber stresses
+	mat3ds FiberStressSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w) override;
+
+	//! weighted sum of fiber tangents
+	tens4ds FiberTangentSum(FEMaterialPoint& mp, int n, const vec3d* a0, const double* w) override;
     
 protected:
 	double	m_alpha;	// coefficient of (In-1) in exponential
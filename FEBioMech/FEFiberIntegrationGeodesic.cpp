@@ -144,6 +144,9 @@ void FEFiberIntegrationGeodesic::InitIntegrationRule()
 		m_sph[n] = sin(phi[n]);
 		m_w[n] = w[n];
 	}
+
+	// the integration points do not depend on the material point
+	UpdateFixedRule();
 }
 
 //-----------------------------------------------------------------------------
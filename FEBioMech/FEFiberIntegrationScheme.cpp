@@ -32,3 +32,23 @@ SOFTWARE.*/
 FEFiberIntegrationScheme::FEFiberIntegrationScheme(FEModel* pfem) : FEMaterial(pfem)
 {
 }
+
+//-----------------------------------------------------------------------------
+void FEFiberIntegrationScheme::UpdateFixedRule()
+{
+	m_fiber.clear();
+	m_weight.clear();
+
+	// the iterator doesn't depend on the material point
+	FEFiberIntegrationSchemeIterator* it = GetIterator(nullptr);
+	if (it->IsValid())
+	{
+		do
+		{
+			m_fiber.push_back(it->m_fiber);
+			m_weight.push_back(it->m_weight);
+		}
+		while (it->Next());
+	}
+	delete it;
+}
@@ -69,4 +69,23 @@ public:
 	// In general, the integration scheme may depend on the material point.
 	// The passed material point pointer will be zero when evaluating the integrated fiber density
 	virtual FEFiberIntegrationSchemeIterator* GetIterator(FEMaterialPoint* mp = 0) = 0;
+
+public:
+	// Schemes whose integration points do not depend on the material point store them
+	// in a fixed rule, so that all points can be evaluated in one batch. 
+	// This returns zero if the scheme does not have a fixed rule. 
+	int FixedRulePoints() const { return (int) m_weight.size(); }
+
+	// fiber directions and weights of the fixed rule
+	const vec3d* FixedRuleFibers() const { return &m_fiber[0]; }
+	const double* FixedRuleWeights() const { return &m_weight[0]; }
+
+protected:
+	// Derived classes call this to store their integration points in the fixed rule.
+	// This must be called each time the integration rule changes.
+	void UpdateFixedRule();
+
+private:
+	vector<vec3d>	m_fiber;	// fiber directions of fixed rule
+	vector<double>	m_weight;	// integration weights of fixed rule
 };
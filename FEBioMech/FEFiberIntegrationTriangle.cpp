@@ -90,6 +90,7 @@ END_FECORE_CLASS();
 FEFiberIntegrationTriangle::FEFiberIntegrationTriangle(FEModel* pfem) : FEFiberIntegrationScheme(pfem)
 { 
 	m_nres = 0; 
+	m_nint = 0;
 }
 
 FEFiberIntegrationTriangle::~FEFiberIntegrationTriangle()
@@ -358,6 +359,9 @@ void FEFiberIntegrationTriangle::InitIntegrationRule()
             }
             break;
     }
+
+	// the integration points do not depend on the material point
+	UpdateFixedRule();
 }
 
 //-----------------------------------------------------------------------------
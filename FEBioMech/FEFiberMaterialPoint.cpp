@@ -26,4 +26,42 @@ SOFTWARE.*/
 
 
 
+#include "stdafx.h"
 #include "FEFiberMaterialPoint.h"
+#include <FECore/DumpStream.h>
+
+//-----------------------------------------------------------------------------
+FEFiberMaterialPoint::FEFiberMaterialPoint(FEMaterialPoint* pt) : FEMaterialPoint(pt)
+{
+	m_bvalid = false;
+	m_time = 0.0;
+	m_IFD = 1.0;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPoint* FEFiberMaterialPoint::Copy()
+{
+	FEFiberMaterialPoint* pt = new FEFiberMaterialPoint(*this);
+	if (m_pNext) pt->m_pNext = m_pNext->Copy();
+	return pt;
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberMaterialPoint::Init()
+{
+	// the densities will be re-evaluated when they are needed
+	m_bvalid = false;
+	m_Rw.clear();
+
+	// don't forget to initialize the base class
+	FEMaterialPoint::Init();
+}
+
+//-----------------------------------------------------------------------------
+void FEFiberMaterialPoint::Serialize(DumpStream& ar)
+{
+	FEMaterialPoint::Serialize(ar);
+
+	// the cached values are not stored, but they need to be re-evaluated after loading
+	if (ar.IsLoading()) m_bvalid = false;
+}
@@ -28,3 +28,30 @@ SOFTWARE.*/
 
 #pragma once
 #include "FECore/FEMaterial.h"
+#include "febiomech_api.h"
+
+//-----------------------------------------------------------------------------
+//! Material point data of a continuous fiber distribution. 
+//! The fiber densities only depend on the reference configuration, so they are
+//! evaluated once and stored here. Since the parameters of the distribution can still
+//! depend on time, the densities are re-evaluated when the time changes.
+class FEBIOMECH_API FEFiberMaterialPoint : public FEMaterialPoint
+{
+public:
+	FEFiberMaterialPoint(FEMaterialPoint* pt);
+
+	FEMaterialPoint* Copy() override;
+
+	void Init() override;
+
+	void Serialize(DumpStream& ar) override;
+
+	//! see if the cached densities are valid at time t
+	bool IsValid(double t) const { return (m_bvalid && (m_time == t)); }
+
+public:
+	bool			m_bvalid;	//!< are the cached values valid?
+	double			m_time;		//!< time at which the densities were evaluated
+	double			m_IFD;		//!< integrated fiber density
+	vector<double>	m_Rw;		//!< fiber density times integration weight for each integration point
+};
@@ -295,21 +295,30 @@ void FERigidSolver::RigidStiffness(SparseMatrix& K, vector<double>& ui, vector<d
 {
 	if (m_fem == nullptr) return;
 
+	if (m_fem->RigidBodies() == 0) return;
+
 	const vector<int>& en = ke.Nodes();
     int n = (int)en.size();
     FEMesh& mesh = m_fem->GetMesh();
     
+	// only nodes attached to a rigid body contribute, so we can skip
+	// the element (and the work arrays) if there are none.
+	bool brigid = false;
     bool bclamped_shell = false;
     for (int j = 0; j<n; ++j) 
 	{
 		if (en[j] >= 0)
 		{
-			if (mesh.Node(en[j]).HasFlags(FENode::SHELL) && mesh.Node(en[j]).HasFlags(FENode::RIGID_CLAMP)) {
+			FENode& node = mesh.Node(en[j]);
+			if (node.m_rid >= 0) brigid = true;
+			if (node.HasFlags(FENode::SHELL) && node.HasFlags(FENode::RIGID_CLAMP)) {
 				bclamped_shell = true;
 				break;
 			}
 		}
     }
+	if ((brigid == false) && (bclamped_shell == false)) return;
+
     if (bclamped_shell)
         RigidStiffnessShell(K, ui, F, en, ke.RowIndices(), ke.ColumnsIndices(), ke, alpha);
     else
@@ -79,6 +79,7 @@ BEGIN_FECORE_CLASS(FESlidingInterface, FEContactInterface)
 	ADD_PARAMETER(m_nsegup       , "seg_up"       );
 	ADD_PARAMETER(m_bself_contact, "self_contact" );
 	ADD_PARAMETER(m_sradius      , "search_radius");
+	ADD_PARAMETER(m_bpatch       , "patch_search" );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -506,6 +507,14 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 	cpp.HandleSpecialCases(true);
 	cpp.Init();
 
+	// the local search is not used for self-contact since it does not
+	// exclude the facets that contain the node itself
+	bool bpatch = (m_bpatch && (m_bself_contact == false));
+	if (bpatch) ms.InitNeighborSearch();
+
+	// count the nodes that were found without a global search
+	int nlocal = 0, nglobal = 0;
+
 	// loop over all slave nodes
 	for (int i=0; i<ss.Nodes(); ++i)
 	{
@@ -545,10 +554,17 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 					FESurfaceElement* pold = pme; 
 					ss.m_data[i].m_rs = vec2d(0,0);
 
-					if (m_bself_contact)
-						pme = cpp.Project(m, q, ss.m_data[i].m_rs);
+					// try the neighbors of the old master element first
+					pme = (bpatch ? ms.FindNeighborProjection(*pold, x, q, ss.m_data[i].m_rs, m_stol) : 0);
+					if (pme) ++nlocal;
 					else
-						pme = cpp.Project(x, q, ss.m_data[i].m_rs);
+					{
+						++nglobal;
+						if (m_bself_contact)
+							pme = cpp.Project(m, q, ss.m_data[i].m_rs);
+						else
+							pme = cpp.Project(x, q, ss.m_data[i].m_rs);
+					}
 
 					if (pme == 0)
 					{
@@ -566,12 +582,14 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 						MapFrictionData(i, ss, ms, en, eo, q);
 					}
 				}
+				else ++nlocal;
 			}
 		}
 		else if (bupseg)
 		{
 			// get the master element
 			// don't forget to initialize the search for the first node!
+			++nglobal;
 			ss.m_data[i].m_rs = vec2d(0,0);
 			if (m_bself_contact)
 				pme = cpp.Project(m, q, ss.m_data[i].m_rs);
@@ -631,6 +649,9 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 			ss.m_data[i].m_Lt[0] = ss.m_data[i].m_Lt[1] = 0;
 		}
 	}
+
+	m_nlocal += nlocal;
+	m_nglobal += nglobal;
 }
 
 //-----------------------------------------------------------------------------
@@ -646,10 +667,13 @@ void FESlidingInterface::Update()
 	// one pass!
 	bool bupdate = (m_bfirst || (m_nsegup == 0)? true : (niter <= m_nsegup));
 
+	ResetSearchStats();
+
 	// project slave surface onto master surface
 	// this also calculates the nodal gap functions
 	ProjectSurface(m_ss, m_ms, bupdate);
 	if (m_btwo_pass && (m_bself_contact == false)) ProjectSurface(m_ms, m_ss, bupdate);
+	ReportSearchStats();
 
 	// Update the net contact pressures
 	UpdateContactPressures();
@@ -57,6 +57,7 @@ BEGIN_FECORE_CLASS(FESlidingInterfaceBW, FEContactInterface)
 	ADD_PARAMETER(m_bflips   , "flip_slave"         );
     ADD_PARAMETER(m_bshellbm , "shell_bottom_master");
     ADD_PARAMETER(m_bshellbs , "shell_bottom_slave" );
+	ADD_PARAMETER(m_bpatch   , "patch_search"       );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -456,6 +457,7 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
     np.SetTolerance(m_stol);
     np.SetSearchRadius(R);
     np.Init();
+    if (m_bpatch) ms.InitNeighborSearch();
     
     double psf = GetPenaltyScaleFactor();
     
@@ -528,8 +530,11 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
         }
     }
     
+    // count the points that were found without a global search
+    int nlocal = 0, nglobal = 0;
+
     // loop over all integration points
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(dynamic) reduction(+:nlocal,nglobal)
     for (int i=0; i<ss.Elements(); ++i)
     {
         FESurfaceElement& el = ss.Element(i);
@@ -562,12 +567,15 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
                 }
                 else
                 {
-                    pme = 0;
+                    // see if the ray intersects one of the neighbors of the old face
+                    if (m_bpatch && bupseg) pme = ms.FindNeighborIntersection(*pme, r, nu, rs, g, m_stol);
+                    else pme = 0;
                 }
             }
             
             // find the intersection point with the master surface
-            if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+            if (pme == 0 && bupseg) { pme = np.Project(r, nu, rs); ++nglobal; }
+            else if (pme) ++nlocal;
             
             data.m_pme = pme;
             data.m_nu = nu;
@@ -606,6 +614,9 @@ void FESlidingInterfaceBW::ProjectSurface(FESlidingSurfaceBW& ss, FESlidingSurfa
             }
         }
     }
+
+    m_nlocal += nlocal;
+    m_nglobal += nglobal;
 }
 
 //-----------------------------------------------------------------------------
@@ -635,12 +646,15 @@ void FESlidingInterfaceBW::Update()
     //	Logfile& log = GetLogfile();
     //	log.printf("seg_up iteration # %d\n", niter+1);
     
+    ResetSearchStats();
+
     // project the surfaces onto each other
     // this will update the gap functions as well
     static bool bfirst = true;
     ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
     bfirst = false;
     if (m_btwo_pass) ProjectSurface(m_ms, m_ss, bupseg);
+    ReportSearchStats();
     
 	int nsolve_iter = GetFEModel()->GetCurrentStep()->GetFESolver()->m_niter;
     if (nsolve_iter == 0)
@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FESolidSolver.h"
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
 
 FESolidLinearSystem::FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidSolver, FEGlobalMatrix& K, std::vector<double>& F, std::vector<double>& u, bool bsymm, double alpha, int nreq) : FELinearSystem(solver, K, F, u, bsymm)
 {
@@ -39,6 +40,12 @@ FESolidLinearSystem::FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidS
 	m_stiffnessScale = 1.0;
 }
 
+FESolidLinearSystem::~FESolidLinearSystem()
+{
+	// The base class cannot call our AssembleDeferred, so we flush the buffers here.
+	FlushDeferred();
+}
+
 // scale factor for stiffness matrix
 void FESolidLinearSystem::StiffnessAssemblyScaleFactor(double a)
 {
@@ -72,13 +79,16 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		// get the vector that stores the prescribed BC values
 		vector<double>& ui = m_u;
 
-		// adjust for linear constraints
-		FEModel* fem = m_solver->GetFEModel();
-		FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
-		if (LCM.LinearConstraints() > 0)
+		// Only elements that touch a constrained or rigid node need the linear constraint 
+		// and rigid body assembly. Most elements are flagged as unconstrained when the 
+		// equations are initialized (see FESolver::InitElementFlags), so they skip the node checks.
+		bool blc = false, brigid = false;
+		if (ke.IsConstrained())
 		{
-			#pragma omp critical 
-			LCM.AssembleStiffness(m_K, m_F, m_u, ke.Nodes(), ke.RowIndices(), ke.ColumnsIndices(), ke);
+			FEModel* fem = m_solver->GetFEModel();
+			FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+			blc = (LCM.LinearConstraints() > 0) && LCM.HasConstrainedNodes(ke.Nodes());
+			brigid = HasRigidNodes(ke);
 		}
 
 		// adjust stiffness matrix for prescribed degrees of freedom
@@ -109,8 +119,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						if (I >= 0)
 						{
 							// dof i is not a prescribed degree of freedom
-							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							if (m_bcolored) m_F[I] -= ke[i][j] * ui[J];
+							else
+							{
+								#pragma omp atomic
+								m_F[I] -= ke[i][j] * ui[J];
+							}
 						}
 					}
 
@@ -120,8 +134,36 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 			}
 		}
 
-		// see if there are any rigid body dofs here
-		#pragma omp critical 
+		// the linear constraint and rigid body contributions couple to equations 
+		// outside of the element, so they are buffered when assembling concurrently
+		if (blc || brigid) DeferAssembly(ke);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESolidLinearSystem::AssembleDeferred(const FEElementMatrix& ke)
+{
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	if (LCM.LinearConstraints() > 0)
+	{
+		LCM.AssembleStiffness(m_K, m_F, m_u, ke.Nodes(), ke.RowIndices(), ke.ColumnsIndices(), ke);
+	}
+
+	if (HasRigidNodes(ke))
+	{
 		m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
 	}
 }
+
+//-----------------------------------------------------------------------------
+bool FESolidLinearSystem::HasRigidNodes(const FEElementMatrix& ke)
+{
+	FEMesh& mesh = m_solver->GetFEModel()->GetMesh();
+	const vector<int>& en = ke.Nodes();
+	for (size_t i = 0; i < en.size(); ++i)
+	{
+		if ((en[i] >= 0) && (mesh.Node(en[i]).m_rid >= 0)) return true;
+	}
+	return false;
+}
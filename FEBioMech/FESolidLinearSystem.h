@@ -36,6 +36,7 @@ class FEBIOMECH_API FESolidLinearSystem : public FELinearSystem
 {
 public:
 	FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidSolver, FEGlobalMatrix& K, std::vector<double>& F, std::vector<double>& u, bool bsymm, double alpha, int nreq);
+	~FESolidLinearSystem();
 
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -45,6 +46,13 @@ public:
 	// scale factor for stiffness matrix
 	void StiffnessAssemblyScaleFactor(double a);
 
+protected:
+	// assemble the linear constraint and rigid body contributions
+	void AssembleDeferred(const FEElementMatrix& ke) override;
+
+	// see if any of the element's nodes are attached to a rigid body
+	bool HasRigidNodes(const FEElementMatrix& ke);
+
 private:
 	FERigidSolver*	m_rigidSolver;
 	double			m_alpha;
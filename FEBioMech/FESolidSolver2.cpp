@@ -50,6 +50,7 @@ SOFTWARE.*/
 #include <FECore/vector.h>
 #include "FESolidLinearSystem.h"
 #include "FEBioMech.h"
+#include "FEMechModel.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -62,6 +63,9 @@ BEGIN_FECORE_CLASS(FESolidSolver2, FENewtonSolver)
 	ADD_PARAMETER(m_logSolve     , "logSolve"    );
 	ADD_PARAMETER(m_arcLength    , "arc_length"  );
 	ADD_PARAMETER(m_al_scale     , "arc_length_scale");
+	ADD_PARAMETER(m_bconcurrent  , "concurrent_assembly");
+	ADD_PARAMETER(m_btaskTiming  , "assembly_timing");
+	ADD_PARAMETER(m_bkinCache    , "kinematics_cache");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -82,6 +86,10 @@ m_dofU(pfem), m_dofV(pfem), m_dofSQ(pfem), m_dofRQ(pfem), m_dofSU(pfem), m_dofSV
 
 	m_logSolve = false;
 
+	m_bconcurrent = true;
+	m_btaskTiming = false;
+	m_bkinCache = false;
+
 	// default Newmark parameters (trapezoidal rule)
     m_rhoi = -2;
     m_alpha = m_alphaf = 1.0;
@@ -195,6 +203,10 @@ bool FESolidSolver2::Init()
 
 	FEModel& fem = *GetFEModel();
 
+	// setup the assembly task list
+	m_tasks.SetConcurrent(m_bconcurrent);
+	m_tasks.SetTiming(m_btaskTiming);
+
     if (m_rhoi == -1) {
         // Euler integration
         m_alpha = m_alphaf = m_alpham = 1.0;
@@ -250,6 +262,13 @@ bool FESolidSolver2::Init()
         if (s) s->SetDynamicUpdateFlag(b);
 	}
 
+	// enable the kinematics cache on all solid domains
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FESolidDomain* d = dynamic_cast<FESolidDomain*>(&mesh.Domain(i));
+		if (d) d->SetKinematicsCache(m_bkinCache);
+	}
+
 	return true;
 }
 
@@ -281,6 +300,16 @@ void FESolidSolver2::Serialize(DumpStream& ar)
 		m_Fn.assign(m_neq, 0);
 		m_Fr.assign(m_neq, 0);
 //		m_Ui.assign(m_neq, 0);
+
+		m_tasks.SetConcurrent(m_bconcurrent);
+		m_tasks.SetTiming(m_btaskTiming);
+
+		FEMesh& mesh = GetFEModel()->GetMesh();
+		for (int i = 0; i < mesh.Domains(); ++i)
+		{
+			FESolidDomain* d = dynamic_cast<FESolidDomain*>(&mesh.Domain(i));
+			if (d) d->SetKinematicsCache(m_bkinCache);
+		}
 	}
 
 	// serialize rigid solver
@@ -423,6 +452,7 @@ void FESolidSolver2::UpdateKinematics(vector<double>& ui)
         node.m_dt = node.m_d0 + node.get_vec3d(m_dofU[0], m_dofU[1], m_dofU[2])
         - node.get_vec3d(m_dofSU[0], m_dofSU[1], m_dofSU[2]);
 	}
+	mesh.GeometryChanged();
 
 	// update velocity and accelerations
 	// for dynamic simulations
@@ -567,6 +597,7 @@ void FESolidSolver2::Update2(const vector<double>& ui)
         - (node.get_vec3d(m_dofSU[0], m_dofSU[1], m_dofSU[2]) + db);
         node.m_dt = dt;
 	}
+	mesh.GeometryChanged();
 
 	// update model state
 	UpdateModel();
@@ -726,6 +757,41 @@ void FESolidSolver2::PrepStep()
 	if (fem.NonlinearConstraints() != 0) m_baugment = true;
 }
 
+//-----------------------------------------------------------------------------
+//! Moves the model to the initial guess of the current time step. The guess
+//! is usually the converged solution at the same time point of an analysis
+//! with slightly different model parameters.
+void FESolidSolver2::ApplyInitialGuess()
+{
+	const vector<double>* pU = GetInitialGuess();
+	if (pU == nullptr) return;
+
+	// The rigid body updates depend on the history of the increments, so
+	// we can't just jump to a different state.
+	FEMechModel* fem = dynamic_cast<FEMechModel*>(GetFEModel());
+	if ((fem == nullptr) || (fem->RigidBodies() > 0)) return;
+
+	// increment that takes us from the current state to the initial guess
+	// NOTE: prescribed dofs are not part of the total solution vector, so this is zero for those.
+	const vector<double>& U = *pU;
+	vector<double> du(m_neq);
+	for (int i = 0; i < m_neq; ++i) du[i] = U[i] - m_Ut[i] - m_Ui[i];
+
+	// update the model
+	// Note that this also enforces the prescribed dofs for this time step.
+	Update(du);
+	UpdateIncrements(m_Ui, du, false);
+
+	// Since the prescribed dofs now have their final values, their increments must be recalculated.
+	zero(m_ui);
+	int nbc = fem->BoundaryConditions();
+	for (int i = 0; i<nbc; ++i)
+	{
+		FEBoundaryCondition& dc = *fem->BoundaryCondition(i);
+		if (dc.IsActive()) dc.PrepStep(m_ui);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // Performs the quasi-newton iterations.
 bool FESolidSolver2::Quasin()
@@ -764,6 +830,9 @@ bool FESolidSolver2::Quasin()
 	// prepare for the first iteration
 	PrepStep();
 
+	// start from the initial guess, if we have one
+	ApplyInitialGuess();
+
 	// Initialize the QN-method
 	if (QNInit() == false) return false;
 
@@ -796,9 +865,8 @@ bool FESolidSolver2::Quasin()
 
 		// calculate actual displacement increment
 		// NOTE: We don't apply the line search directly to m_ui since we need the unscaled search direction for the QN update below
-		int neq = (int)m_Ui.size();
 		vector<double> ui(m_ui);
-		for (int i = 0; i<neq; ++i) ui[i] *= s;
+		ui *= s;
 
 		// update total displacements
 		UpdateIncrements(m_Ui, ui, false);
@@ -1058,6 +1126,8 @@ void FESolidSolver2::DoArcLength()
 
 //-----------------------------------------------------------------------------
 //! Calculates global stiffness matrix.
+//! The contributions of the domains, loads, contact interfaces, etc. are independent
+//! of each other and are evaluated as tasks (see FETaskList), which may run concurrently.
 
 bool FESolidSolver2::StiffnessMatrix()
 {
@@ -1071,13 +1141,15 @@ bool FESolidSolver2::StiffnessMatrix()
 	// setup the linear system
 	FESolidLinearSystem LS(this, &m_rigidSolver, *m_pK, m_Fd, m_ui, (m_msymm == REAL_SYMMETRIC), m_alpha, m_nreq);
 
+	m_tasks.Clear();
+
 	// calculate the stiffness matrix for each domain
 	for (int i=0; i<mesh.Domains(); ++i) 
 	{
 		if (mesh.Domain(i).IsActive()) 
 		{
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
-			dom.StiffnessMatrix(LS);
+			m_tasks.AddTask("domain stiffness", i, [&dom, &LS]() { dom.StiffnessMatrix(LS); }, mesh.Domain(i).Elements());
 		}
 	}
 
@@ -1085,7 +1157,7 @@ bool FESolidSolver2::StiffnessMatrix()
 	for (int j = 0; j<fem.BodyLoads(); ++j)
 	{
 		FEBodyLoad* pbl =fem.GetBodyLoad(j);
-		if (pbl->IsActive()) pbl->StiffnessMatrix(LS, tp);
+		if (pbl->IsActive()) m_tasks.AddTask("body load stiffness", j, [=, &LS, &tp]() { pbl->StiffnessMatrix(LS, tp); }, BodyLoadCost(pbl));
 	}
     
     // TODO: add body force stiffness for rigid bodies
@@ -1106,38 +1178,55 @@ bool FESolidSolver2::StiffnessMatrix()
 			if (mat->IsRigid() == false)
 			{
 				FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
-				edom.MassMatrix(LS, a);
+				m_tasks.AddTask("mass matrix", i, [=, &edom, &LS]() { edom.MassMatrix(LS, a); }, dom.Elements());
 			}
 		}
 
-		m_rigidSolver.RigidMassMatrix(LS, tp);
+		m_tasks.AddExclusiveTask("rigid mass matrix", -1, [&]() { m_rigidSolver.RigidMassMatrix(LS, tp); });
 	}
 
 	// calculate contact stiffness
-	ContactStiffness(LS);
+	AddContactStiffnessTasks(LS);
 
 	// calculate stiffness matrices for surface loads
 	// for arclength method we need to apply the scale factor to all the 
-	// external forces stiffness matrix. 
-	if (m_arcLength > 0) LS.StiffnessAssemblyScaleFactor(m_al_lam);
+	// external forces stiffness matrix. Since the scale factor is a property
+	// of the linear system, these tasks cannot run concurrently with other tasks.
 	int nsl = fem.SurfaceLoads();
 	for (int i = 0; i<nsl; ++i)
 	{
 		FESurfaceLoad* psl = fem.SurfaceLoad(i);
 		if (psl->IsActive())
 		{
-			psl->StiffnessMatrix(LS, tp);
+			if (m_arcLength > 0)
+			{
+				m_tasks.AddExclusiveTask("surface load stiffness", i, [=, &LS, &tp]() {
+					LS.StiffnessAssemblyScaleFactor(m_al_lam);
+					psl->StiffnessMatrix(LS, tp);
+					LS.StiffnessAssemblyScaleFactor(1.0);
+				});
+			}
+			else m_tasks.AddTask("surface load stiffness", i, [=, &LS, &tp]() { psl->StiffnessMatrix(LS, tp); }, psl->GetSurface().Elements());
 		}
 	}
-	if (m_arcLength > 0) LS.StiffnessAssemblyScaleFactor(1.0);
 
 	// calculate nonlinear constraint stiffness
 	// note that this is the contribution of the 
 	// constrainst enforced with augmented lagrangian
-	NonLinearConstraintStiffness(LS, tp);
+	AddNonLinearConstraintStiffnessTasks(LS, tp);
 
 	// calculate the stiffness contributions for the rigid forces
-	for (int i = 0; i<fem.ModelLoads(); ++i) fem.ModelLoad(i)->StiffnessMatrix(LS, tp);
+	// (these modify rigid body data, so they are exclusive)
+	for (int i = 0; i<fem.ModelLoads(); ++i)
+	{
+		FEModelLoad* pml = fem.ModelLoad(i);
+		m_tasks.AddExclusiveTask("model load stiffness", i, [=, &LS, &tp]() { pml->StiffnessMatrix(LS, tp); });
+	}
+
+	m_tasks.Run();
+
+	// assemble the constraint contributions that the concurrent tasks buffered
+	LS.FlushDeferred();
 
 	// add contributions from rigid bodies
 	m_rigidSolver.StiffnessMatrix(*m_pK, tp);
@@ -1185,6 +1274,82 @@ void FESolidSolver2::ContactForces(FEGlobalVector& R)
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Add the stiffness contributions of the nonlinear constraints to the task list.
+//! Many of these constraints (e.g. rigid connectors) modify rigid body data, so 
+//! they are executed exclusively.
+void FESolidSolver2::AddNonLinearConstraintStiffnessTasks(FELinearSystem& LS, const FETimeInfo& tp)
+{
+	FEModel& fem = *GetFEModel();
+	int N = fem.NonlinearConstraints();
+	for (int i=0; i<N; ++i) 
+	{
+		FENLConstraint* plc = fem.NonlinearConstraint(i);
+		if (plc->IsActive()) m_tasks.AddExclusiveTask("constraint stiffness", i, [=, &LS, &tp]() { plc->StiffnessMatrix(LS, tp); });
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Add the contact stiffness matrices to the task list
+void FESolidSolver2::AddContactStiffnessTasks(FELinearSystem& LS)
+{
+	FEModel& fem = *GetFEModel();
+	const FETimeInfo& tp = fem.GetTime();
+	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
+	{
+		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
+		if (pci->IsActive()) m_tasks.AddTask("contact stiffness", i, [=, &LS, &tp]() { pci->StiffnessMatrix(LS, tp); }, ContactCost(pci));
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Add the contact forces to the task list
+void FESolidSolver2::AddContactForceTasks(FEGlobalVector& R)
+{
+	FEModel& fem = *GetFEModel();
+	const FETimeInfo& tp = fem.GetTime();
+	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
+	{
+		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
+		if (pci->IsActive()) m_tasks.AddTask("contact forces", i, [=, &R, &tp]() { pci->LoadVector(R, tp); }, ContactCost(pci));
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! estimated cost of a body load task
+double FESolidSolver2::BodyLoadCost(FEBodyLoad* pbl)
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	if (pbl->Domains() == 0) return mesh.Elements();
+	double cost = 0.0;
+	for (int i = 0; i < pbl->Domains(); ++i) cost += pbl->Domain(i)->Elements();
+	return cost;
+}
+
+//-----------------------------------------------------------------------------
+//! estimated cost of a contact task
+double FESolidSolver2::ContactCost(FEContactInterface* pci)
+{
+	double cost = 0.0;
+	FESurface* ps = pci->GetSlaveSurface();
+	FESurface* pm = pci->GetMasterSurface();
+	if (ps) cost += ps->Elements();
+	if (pm) cost += pm->Elements();
+	return cost;
+}
+
+//-----------------------------------------------------------------------------
+//! Print the task timings at the end of a step
+void FESolidSolver2::Clean()
+{
+	if (m_tasks.Timing())
+	{
+		m_tasks.PrintTimings(GetFEModel(), " A S S E M B L Y   T A S K   T I M I N G S");
+		m_tasks.ResetTimings();
+	}
+	FENewtonSolver::Clean();
+}
+
 //-----------------------------------------------------------------------------
 //! calculates the residual vector
 //! Note that the concentrated nodal forces are not calculated here.
@@ -1274,6 +1439,7 @@ bool FESolidSolver2::Residual(vector<double>& R)
 void FESolidSolver2::InternalForces(FEGlobalVector& R)
 {
 	FEMesh& mesh = GetFEModel()->GetMesh();
+	m_tasks.Clear();
 	for (int i = 0; i<mesh.Domains(); ++i)
 	{
 		FEDomain& dom = mesh.Domain(i);
@@ -1281,9 +1447,10 @@ void FESolidSolver2::InternalForces(FEGlobalVector& R)
 		if ((mat == nullptr) || (mat->IsRigid() == false))
 		{
 			FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
-			edom.InternalForces(R);
+			m_tasks.AddTask("internal forces", i, [&edom, &R]() { edom.InternalForces(R); }, dom.Elements());
 		}
 	}
+	m_tasks.Run();
 }
 
 //-----------------------------------------------------------------------------
@@ -1297,11 +1464,14 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	// add nodal loads
 	RHS += m_Fn;
 
+	// the remaining contributions are evaluated as tasks
+	m_tasks.Clear();
+
 	// calculate the body forces
 	for (int j = 0; j<fem.BodyLoads(); ++j)
 	{
 		FEBodyLoad* pbl = fem.GetBodyLoad(j);
-		if (pbl->IsActive()) pbl->LoadVector(RHS, tp);
+		if (pbl->IsActive()) m_tasks.AddTask("body load forces", j, [=, &RHS, &tp]() { pbl->LoadVector(RHS, tp); }, BodyLoadCost(pbl));
 	}
 
 	// calculate body forces for rigid bodies
@@ -1309,15 +1479,12 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	{
 		FEBodyForce* pbf = dynamic_cast<FEBodyForce*>(fem.GetBodyLoad(j));
 		if (pbf && pbf->IsActive())
-			m_rigidSolver.BodyForces(RHS, tp, *pbf);
+			m_tasks.AddExclusiveTask("rigid body forces", j, [=, &RHS, &tp]() { m_rigidSolver.BodyForces(RHS, tp, *pbf); });
 	}
 
 	// calculate inertial forces for dynamic problems
 	if (fem.GetCurrentStep()->m_nanalysis == FE_DYNAMIC)
 	{
-		// allocate F
-		vector<double> F;
-
 		// calculate the inertial forces for all elastic domains (except rigid domains)
 		for (int nd = 0; nd < mesh.Domains(); ++nd)
 		{
@@ -1326,12 +1493,15 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 			if (mat->IsRigid() == false)
 			{
 				FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
-				edom.InertialForces(RHS, F);
+				m_tasks.AddTask("inertial forces", nd, [&edom, &RHS]() {
+					vector<double> F;
+					edom.InertialForces(RHS, F);
+				}, dom.Elements());
 			}
 		}
 
 		// update rigid bodies
-		m_rigidSolver.InertialForces(RHS, tp);
+		m_tasks.AddExclusiveTask("rigid inertial forces", -1, [&]() { m_rigidSolver.InertialForces(RHS, tp); });
 	}
 
 	// calculate forces due to surface loads
@@ -1339,31 +1509,31 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	for (int i = 0; i<nsl; ++i)
 	{
 		FESurfaceLoad* psl = fem.SurfaceLoad(i);
-		if (psl->IsActive()) psl->LoadVector(RHS, tp);
+		if (psl->IsActive()) m_tasks.AddTask("surface load forces", i, [=, &RHS, &tp]() { psl->LoadVector(RHS, tp); }, psl->GetSurface().Elements());
 	}
 
 	// calculate contact forces
-	ContactForces(RHS);
+	AddContactForceTasks(RHS);
 
 	// calculate nonlinear constraint forces
 	// note that these are the linear constraints
 	// enforced using the augmented lagrangian
-	NonLinearConstraintForces(RHS, tp);
+	AddNonLinearConstraintForceTasks(RHS, tp);
 
 	// forces due to point constraints
 	//	for (i=0; i<(int) fem.m_PC.size(); ++i) fem.m_PC[i]->Residual(this, R);
 
 	// add model loads
+	// (these modify rigid body data, so they are exclusive)
 	int NML = fem.ModelLoads();
 	for (int i = 0; i<NML; ++i)
 	{
-		FEModelLoad& mli = *fem.ModelLoad(i);
-		if (mli.IsActive())
-		{
-			mli.LoadVector(RHS, tp);
-		}
+		FEModelLoad* pml = fem.ModelLoad(i);
+		if (pml->IsActive()) m_tasks.AddExclusiveTask("model load forces", i, [=, &RHS, &tp]() { pml->LoadVector(RHS, tp); });
 	}
 
+	m_tasks.Run();
+
 	// set the nodal reaction forces
 	// TODO: Is this a good place to do this?
 	for (int i = 0; i<mesh.Nodes(); ++i)
@@ -1398,3 +1568,18 @@ void FESolidSolver2::NonLinearConstraintForces(FEGlobalVector& R, const FETimeIn
 		if (plc->IsActive()) plc->LoadVector(R, tp);
 	}
 }
+
+//-----------------------------------------------------------------------------
+//! Add the nonlinear constraint forces to the task list.
+//! Many of these constraints (e.g. rigid connectors) modify rigid body data, so 
+//! they are executed exclusively.
+void FESolidSolver2::AddNonLinearConstraintForceTasks(FEGlobalVector& R, const FETimeInfo& tp)
+{
+	FEModel& fem = *GetFEModel();
+	int N = fem.NonlinearConstraints();
+	for (int i=0; i<N; ++i) 
+	{
+		FENLConstraint* plc = fem.NonlinearConstraint(i);
+		if (plc->IsActive()) m_tasks.AddExclusiveTask("constraint forces", i, [=, &R, &tp]() { plc->LoadVector(R, tp); });
+	}
+}
@@ -33,6 +33,10 @@ SOFTWARE.*/
 #include "FECore/FEGlobalVector.h"
 #include "FERigidSolver.h"
 #include <FECore/FEDofList.h>
+#include <FECore/FETaskList.h>
+
+class FEBodyLoad;
+class FEContactInterface;
 
 //-----------------------------------------------------------------------------
 //! The FESolidSolver2 class solves large deformation solid mechanics problems
@@ -58,6 +62,9 @@ public:
 	//! Initializes data structures
 	bool Init() override;
 
+	//! clean up (prints the assembly task timings)
+	void Clean() override;
+
 	//! initialize the step
 	bool InitStep(double time) override;
 
@@ -99,6 +106,9 @@ public:
 		//! Performs a Newton-Raphson iteration
 		bool Quasin() override;
 
+		//! Start the time step from the initial guess (if any). Call this after PrepStep.
+		void ApplyInitialGuess();
+
 		//! Apply arc-length
 		void DoArcLength();
 	//}
@@ -139,6 +149,10 @@ public:
 
 	bool	m_logSolve;		//!< flag to use Aggarwal's log method
 
+	bool	m_bconcurrent;	//!< evaluate independent assembly contributions concurrently
+	bool	m_btaskTiming;	//!< print the time spent in each assembly task at the end of each step
+	bool	m_bkinCache;	//!< cache the element kinematics of solid domains between mesh updates
+
 	// equation numbers
 	int		m_nreq;			//!< start of rigid body equations
 
@@ -171,8 +185,21 @@ protected:
 	FEDofList	m_dofRQ;
 	FEDofList	m_dofSU, m_dofSV, m_dofSA;
     
+protected:
+	//! add the contact and nonlinear constraint contributions to the task list
+	//! (used by StiffnessMatrix and ExternalForces, which run the list)
+	void AddContactStiffnessTasks(FELinearSystem& LS);
+	void AddNonLinearConstraintStiffnessTasks(FELinearSystem& LS, const FETimeInfo& tp);
+	void AddContactForceTasks(FEGlobalVector& R);
+	void AddNonLinearConstraintForceTasks(FEGlobalVector& R, const FETimeInfo& tp);
+
+	//! estimated cost of assembly tasks
+	double BodyLoadCost(FEBodyLoad* pbl);
+	double ContactCost(FEContactInterface* pci);
+
 protected:
     FERigidSolverNew	m_rigidSolver;
+	FETaskList			m_tasks;	//!< assembly tasks for residual and stiffness matrix
 
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
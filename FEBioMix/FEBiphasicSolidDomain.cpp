@@ -95,8 +95,8 @@ void FEBiphasicSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
             p = el.Evaluate(pn, j);
             
 			FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
-            FEBiphasicMaterialPoint& pb = *mp.ExtractData<FEBiphasicMaterialPoint>();
+			FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), j);
+            FEBiphasicMaterialPoint& pb = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), j);
 			pt.m_r0 = r0;
 			pt.m_rt = rt;
 
@@ -119,6 +119,10 @@ bool FEBiphasicSolidDomain::Init()
 {
 	// initialize base class
 	if (FESolidDomain::Init() == false) return false;
+
+	// cache the material point data that is needed in the element loops
+	CacheMaterialPointData<FEElasticMaterialPoint>();
+	CacheMaterialPointData<FEBiphasicMaterialPoint>();
     
     // initialize body forces
 	FEModel& fem = *GetFEModel();
@@ -296,8 +300,8 @@ void FEBiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<doub
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
         
 		// calculate the jacobian
 		double Jw = invjact(el, Ji, n)*gw[n];
@@ -421,8 +425,8 @@ void FEBiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector<do
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -581,8 +585,8 @@ bool FEBiphasicSolidDomain::ElementBiphasicStiffness(FESolidElement& el, matrix&
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
+        FEElasticMaterialPoint& ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& pt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         double detJ = invjact(el, Ji, n);
@@ -737,8 +741,8 @@ bool FEBiphasicSolidDomain::ElementBiphasicStiffnessSS(FESolidElement& el, matri
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
+        FEElasticMaterialPoint& ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& pt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         double detJ = invjact(el, Ji, n);
@@ -942,7 +946,7 @@ void FEBiphasicSolidDomain::UpdateElementStress(int iel)
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+		FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
 			
 		// material point coordinates
 		// TODO: I'm not entirly happy with this solution
@@ -958,7 +962,7 @@ void FEBiphasicSolidDomain::UpdateElementStress(int iel)
         pt.m_L = (pt.m_F - Fp)*Fi / dt;
 
 		// poroelasticity data
-		FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
+		FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
 			
 		// evaluate fluid pressure at gauss-point
 		ppt.m_p = el.Evaluate(degree_p, pn, n);
@@ -101,6 +101,20 @@ void FEBiphasicSoluteShellDomain::Activate()
     }
 }
 
+//-----------------------------------------------------------------------------
+bool FEBiphasicSoluteShellDomain::Init()
+{
+    // initialize base class
+    if (FESSIShellDomain::Init() == false) return false;
+    
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEElasticMaterialPoint>();
+    CacheMaterialPointData<FEBiphasicMaterialPoint>();
+    CacheMaterialPointData<FESolutesMaterialPoint>();
+    
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void FEBiphasicSoluteShellDomain::InitMaterialPoints()
 {
@@ -273,9 +287,9 @@ void FEBiphasicSoluteShellDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
             c = evaluate(el, cn, dn, j);
             
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
-            FEBiphasicMaterialPoint& pb = *mp.ExtractData<FEBiphasicMaterialPoint>();
-            FESolutesMaterialPoint&  ps = *(mp.ExtractData<FESolutesMaterialPoint >());
+            FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), j);
+            FEBiphasicMaterialPoint& pb = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), j);
+            FESolutesMaterialPoint&  ps = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = r0;
             pt.m_rt = rt;
             
@@ -361,9 +375,9 @@ void FEBiphasicSoluteShellDomain::ElementInternalForce(FEShellElement& el, vecto
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -490,9 +504,9 @@ void FEBiphasicSoluteShellDomain::ElementInternalForceSS(FEShellElement& el, vec
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -651,9 +665,9 @@ bool FEBiphasicSoluteShellDomain::ElementBiphasicSoluteStiffness(FEShellElement&
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -947,9 +961,9 @@ bool FEBiphasicSoluteShellDomain::ElementBiphasicSoluteStiffnessSS(FEShellElemen
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -1274,7 +1288,7 @@ void FEBiphasicSoluteShellDomain::UpdateElementStress(int iel)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
         
         // material point coordinates
         // TODO: I'm not entirly happy with this solution
@@ -1290,8 +1304,8 @@ void FEBiphasicSoluteShellDomain::UpdateElementStress(int iel)
         pt.m_L = (pt.m_F - Fp)*Fi / dt;
 
         // biphasic-solute data
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // evaluate fluid pressure at gauss-point
         ppt.m_p = evaluate(el, pn, qn, n);
@@ -57,6 +57,9 @@ public:
     //! Unpack solid element data (overridden from FEDomain)
     void UnpackLM(FEElement& el, vector<int>& lm) override;
     
+    //! initialize class
+    bool Init() override;
+    
     //! Activate
     void Activate() override;
     
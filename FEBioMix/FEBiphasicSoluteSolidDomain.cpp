@@ -105,6 +105,20 @@ void FEBiphasicSoluteSolidDomain::Activate()
     }
 }
 
+//-----------------------------------------------------------------------------
+bool FEBiphasicSoluteSolidDomain::Init()
+{
+    // initialize base class
+    if (FESolidDomain::Init() == false) return false;
+    
+    // cache the material point data that is needed in the element loops
+    CacheMaterialPointData<FEElasticMaterialPoint>();
+    CacheMaterialPointData<FEBiphasicMaterialPoint>();
+    CacheMaterialPointData<FESolutesMaterialPoint>();
+    
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void FEBiphasicSoluteSolidDomain::InitMaterialPoints()
 {
@@ -292,9 +306,9 @@ void FEBiphasicSoluteSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
             c = el.Evaluate(ct, j);
             
             FEMaterialPoint& mp = *el.GetMaterialPoint(j);
-            FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
-            FEBiphasicMaterialPoint& pb = *mp.ExtractData<FEBiphasicMaterialPoint>();
-            FESolutesMaterialPoint&  ps = *(mp.ExtractData<FESolutesMaterialPoint >());
+            FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), j);
+            FEBiphasicMaterialPoint& pb = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), j);
+            FESolutesMaterialPoint&  ps = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), j);
             pt.m_r0 = r0;
             pt.m_rt = rt;
             
@@ -375,9 +389,9 @@ void FEBiphasicSoluteSolidDomain::ElementInternalForce(FESolidElement& el, vecto
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -490,9 +504,9 @@ void FEBiphasicSoluteSolidDomain::ElementInternalForceSS(FESolidElement& el, vec
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -636,9 +650,9 @@ bool FEBiphasicSoluteSolidDomain::ElementBiphasicSoluteStiffness(FESolidElement&
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -851,9 +865,9 @@ bool FEBiphasicSoluteSolidDomain::ElementBiphasicSoluteStiffnessSS(FESolidElemen
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -1095,7 +1109,7 @@ void FEBiphasicSoluteSolidDomain::UpdateElementStress(int iel)
     for (int n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
         
         // material point coordinates
         // TODO: I'm not entirly happy with this solution
@@ -1111,8 +1125,8 @@ void FEBiphasicSoluteSolidDomain::UpdateElementStress(int iel)
         pt.m_L = (pt.m_F - Fp)*Fi / dt;
 
         // solute-poroelastic data
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // evaluate fluid pressure at gauss-point
         ppt.m_p = el.Evaluate(pn, n);
@@ -131,6 +131,11 @@ bool FEMultiphasicSolidDomain::Init()
 {
     // initialize base class
 	if (FESolidDomain::Init() == false) return false;
+
+	// cache the material point data that is needed in the element loops
+	CacheMaterialPointData<FEElasticMaterialPoint>();
+	CacheMaterialPointData<FEBiphasicMaterialPoint>();
+	CacheMaterialPointData<FESolutesMaterialPoint>();
     
     // extract the initial concentrations of the solid-bound molecules
     const int nsbm = m_pMat->SBMs();
@@ -548,9 +553,9 @@ void FEMultiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<d
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -694,9 +699,9 @@ void FEMultiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
-        FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& bpt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate the jacobian
         detJt = invjact(el, Ji, n);
@@ -874,9 +879,9 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffness(FESolidElement& el, m
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -1250,9 +1255,9 @@ bool FEMultiphasicSolidDomain::ElementMultiphasicStiffnessSS(FESolidElement& el,
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint&  ept = *(mp.ExtractData<FEElasticMaterialPoint >());
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint&  spt = *(mp.ExtractData<FESolutesMaterialPoint >());
+        FEElasticMaterialPoint&  ept = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint&  spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // calculate jacobian
         detJ = invjact(el, Ji, n)*gw[n];
@@ -1622,7 +1627,7 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-        FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+        FEElasticMaterialPoint& pt = *MaterialPointData<FEElasticMaterialPoint>(el.GetLocalID(), n);
         
         // material point coordinates
         // TODO: I'm not entirly happy with this solution
@@ -1638,8 +1643,8 @@ void FEMultiphasicSolidDomain::UpdateElementStress(int iel, double dt)
         pt.m_L = (pt.m_F - Fp)*Fi / dt;
 
         // multiphasic material point data
-        FEBiphasicMaterialPoint& ppt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
-        FESolutesMaterialPoint& spt = *(mp.ExtractData<FESolutesMaterialPoint>());
+        FEBiphasicMaterialPoint& ppt = *MaterialPointData<FEBiphasicMaterialPoint>(el.GetLocalID(), n);
+        FESolutesMaterialPoint& spt = *MaterialPointData<FESolutesMaterialPoint>(el.GetLocalID(), n);
         
         // update SBM referential densities
         pmb->UpdateSolidBoundMolecules(mp);
@@ -55,6 +55,7 @@ BEGIN_FECORE_CLASS(FESlidingInterface2, FEContactInterface)
 	ADD_PARAMETER(m_breloc   , "node_reloc"         );
     ADD_PARAMETER(m_bsmaug   , "smooth_aug"         );
     ADD_PARAMETER(m_bdupr    , "dual_proj"          );
+	ADD_PARAMETER(m_bpatch   , "patch_search"       );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -720,6 +721,7 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 	np.SetTolerance(m_stol);
 	np.SetSearchRadius(R);
 	np.Init();
+	if (m_bpatch) ms.InitNeighborSearch();
 
 	// if we need to project the nodes onto the master surface,
 	// let's do this first
@@ -773,6 +775,9 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 		}
 	}
 
+	// count the points that were found without a global search
+	int nlocal = 0, nglobal = 0;
+
 	// loop over all integration points
  //   #pragma omp parallel for shared(R, bupseg)
 	for (int i=0; i<ss.Elements(); ++i)
@@ -817,12 +822,15 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 				}
 				else
 				{
-					pme = 0;
+					// see if the ray intersects one of the neighbors of the old face
+					if (m_bpatch && bupseg) pme = ms.FindNeighborIntersection(*pme, r, nu, rs, g, m_stol);
+					else pme = 0;
 				}
 			}
-
+			
 			// find the intersection point with the master surface
-			if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+			if (pme == 0 && bupseg) { pme = np.Project(r, nu, rs); ++nglobal; }
+			else if (pme) ++nlocal;
 
 			pt.m_pme = pme;
 			pt.m_nu = nu;
@@ -885,6 +893,9 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 			}
 		}
 	}
+
+	m_nlocal += nlocal;
+	m_nglobal += nglobal;
 }
 
 //-----------------------------------------------------------------------------
@@ -918,11 +929,14 @@ void FESlidingInterface2::Update()
 //	Logfile& log = GetLogfile();
 //	log.printf("seg_up iteration # %d\n", niter+1);
 	
+	ResetSearchStats();
+
 	// project the surfaces onto each other
 	// this will update the gap functions as well
 	static bool bfirst = true;
 	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
 	if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+	ReportSearchStats();
 	bfirst = false;
 
 	// Update the net contact pressures
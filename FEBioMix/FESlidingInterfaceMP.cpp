@@ -63,6 +63,7 @@ BEGIN_FECORE_CLASS(FESlidingInterfaceMP, FEContactInterface)
 	ADD_PARAMETER(m_naugmax  , "maxaug"               );
 	ADD_PARAMETER(m_ambp     , "ambient_pressure"     );
 	ADD_PARAMETER(m_ambctmp  , "ambient_concentration");
+	ADD_PARAMETER(m_bpatch   , "patch_search"         );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -934,6 +935,7 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 	np.SetTolerance(m_stol);
 	np.SetSearchRadius(m_srad);
 	np.Init();
+	if (m_bpatch) ms.InitNeighborSearch();
 	
     // if we need to project the nodes onto the master surface,
     // let's do this first
@@ -987,6 +989,9 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
         }
     }
     
+	// count the points that were found without a global search
+	int nlocal = 0, nglobal = 0;
+
 	// loop over all integration points
 //    #pragma omp parallel for shared(R, bupseg)
 	for (int i=0; i<ss.Elements(); ++i)
@@ -1039,12 +1044,15 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 				}
 				else
 				{
-					pme = 0;
+					// see if the ray intersects one of the neighbors of the old face
+					if (m_bpatch && bupseg) pme = ms.FindNeighborIntersection(*pme, r, nu, rs, g, m_stol);
+					else pme = 0;
 				}
 			}
 			
 			// find the intersection point with the master surface
-			if (pme == 0 && bupseg) pme = np.Project(r, nu, rs);
+			if (pme == 0 && bupseg) { pme = np.Project(r, nu, rs); ++nglobal; }
+			else if (pme) ++nlocal;
 			
 			pt.m_pme = pme;
 			pt.m_nu = nu;
@@ -1117,6 +1125,9 @@ void FESlidingInterfaceMP::ProjectSurface(FESlidingSurfaceMP& ss, FESlidingSurfa
 			}
 		}
 	}
+
+	m_nlocal += nlocal;
+	m_nglobal += nglobal;
 }
 
 //-----------------------------------------------------------------------------
@@ -1172,11 +1183,14 @@ void FESlidingInterfaceMP::Update()
 	//	Logfile& log = GetLogfile();
 	//	log.printf("seg_up iteration # %d\n", niter+1);
 	
+	ResetSearchStats();
+
 	// project the surfaces onto each other
 	// this will update the gap functions as well
     static bool bfirst = true;
 	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
+	ReportSearchStats();
     bfirst = false;
 	
 	// Update the net contact pressures
@@ -42,6 +42,7 @@ BEGIN_FECORE_CLASS(FEConstrainedLMOptimizeMethod, FEOptimizeMethod)
 	ADD_PARAMETER(m_tau   , "tau"         );
 	ADD_PARAMETER(m_fdiff , "f_diff_scale");
 	ADD_PARAMETER(m_nmax  , "max_iter"    );
+	ADD_PARAMETER(m_nworkers, "fd_workers");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -59,17 +60,26 @@ void clevmar_cb(double *p, double *hx, int m, int n, void *adata)
 	// evaluate at a
 	vector<double> a(m);
 	for (int i = 0; i<m; ++i) a[i] = p[i];
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
+	vector<double> y(n, 0.0);
+	if (opt.FESolve(a, y) == false) throw FEErrorTermination();
 
 	// store the measurement vector
-	vector<double> y(n, 0.0);
-	opt.GetObjective().Evaluate(y);
 	for (int i=0; i<n; ++i) hx[i] = y[i];
 
 	// store the last calculated values
+	pLM->m_aopt = a;
 	pLM->m_yopt = y;
 }
 
+//-----------------------------------------------------------------------------
+// Calculates the jacobian with forward differences. This is only used when worker processes
+// are requested, since the forward difference solves can then be done concurrently.
+void clevmar_jac(double *p, double *jac, int m, int n, void *adata)
+{
+	FEConstrainedLMOptimizeMethod* pLM = (FEConstrainedLMOptimizeMethod*) adata;
+	pLM->Jacobian(p, jac, m, n);
+}
+
 //-----------------------------------------------------------------------------
 FEConstrainedLMOptimizeMethod::FEConstrainedLMOptimizeMethod()
 {
@@ -77,6 +87,7 @@ FEConstrainedLMOptimizeMethod::FEConstrainedLMOptimizeMethod()
 	m_objtol = 0.001;
 	m_fdiff  = 0.001;
 	m_nmax   = 100;
+	m_nworkers = 0;
     m_loglevel = LogLevel::LOG_NEVER;
 }
 
@@ -85,6 +96,7 @@ bool FEConstrainedLMOptimizeMethod::Solve(FEOptimizeData *pOpt, vector<double>&
 {
 	m_pOpt = pOpt;
 	FEOptimizeData& opt = *pOpt;
+	m_aopt.clear();
 
 	// set the variables
 	int ma = opt.InputParameters();
@@ -149,20 +161,28 @@ bool FEConstrainedLMOptimizeMethod::Solve(FEOptimizeData *pOpt, vector<double>&
 				b[i] = con.b;
 			}
 
-			int ret = dlevmar_blec_dif(clevmar_cb, p, q, ma, ndata, lb, ub, A, b, NC, 0, itmax, opts, 0, 0, 0, (void*) this);
+			int ret = 0;
+			if (m_nworkers > 0)
+				ret = dlevmar_blec_der(clevmar_cb, clevmar_jac, p, q, ma, ndata, lb, ub, A, b, NC, 0, itmax, opts, 0, 0, 0, (void*) this);
+			else
+				ret = dlevmar_blec_dif(clevmar_cb, p, q, ma, ndata, lb, ub, A, b, NC, 0, itmax, opts, 0, 0, 0, (void*) this);
 
 			delete [] b;
 			delete [] A;
 		}
 		else
 		{
-			int ret = dlevmar_bc_dif(clevmar_cb, p, q, ma, ndata, lb, ub, 0, itmax, opts, 0, 0, 0, (void*) this);
+			int ret = 0;
+			if (m_nworkers > 0)
+				ret = dlevmar_bc_der(clevmar_cb, clevmar_jac, p, q, ma, ndata, lb, ub, 0, itmax, opts, 0, 0, 0, (void*) this);
+			else
+				ret = dlevmar_bc_dif(clevmar_cb, p, q, ma, ndata, lb, ub, 0, itmax, opts, 0, 0, 0, (void*) this);
 		}
 
 		for (int i=0; i<ma; ++i) a[i] = p[i];
 
 		// store the optimal values
-		fret = obj.Evaluate(m_yopt);
+		fret = obj.ObjectiveValue(m_yopt);
 
 		delete [] q;
 		delete [] ub;
@@ -204,26 +224,55 @@ void FEConstrainedLMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a,
 		}
 	}
 	
-	// evaluate at a
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
-	opt.GetObjective().Evaluate(y);
-	m_yopt = y;
-
-	// now calculate the derivatives using forward differences
+	// Setup the parameter sets: the first one evaluates at a, the others are the
+	// forward differences for the derivatives. Since these solves are independent,
+	// they can be done concurrently.
 	int ndata = (int)x.size();
-	vector<double> a1(a);
-	vector<double> y1(ndata);
+	vector< vector<double> > as(ma + 1, a), ys;
 	for (int i=0; i<ma; ++i)
 	{
 		double b = opt.GetInputParameter(i)->ScaleFactor();
 
-		a1[i] = a1[i] + dir[i]*m_fdiff*(b + fabs(a[i]));
+		as[i + 1][i] = a[i] + dir[i]*m_fdiff*(b + fabs(a[i]));
+	}
 
-		if (opt.FESolve(a1) == false) throw FEErrorTermination();
-		opt.GetObjective().Evaluate(y1);
+	// levmar usually evaluates the function at a right before it asks for the jacobian,
+	// so we reuse that result instead of solving it again
+	if ((a == m_aopt) && ((int)m_yopt.size() == ndata))
+	{
+		vector< vector<double> > ad(as.begin() + 1, as.end());
+		if (opt.FESolveBatch(ad, ys, m_nworkers) == false) throw FEErrorTermination();
+		ys.insert(ys.begin(), m_yopt);
+	}
+	else
+	{
+		// solve all
+		if (opt.FESolveBatch(as, ys, m_nworkers) == false) throw FEErrorTermination();
+	}
+
+	y = ys[0];
+	m_aopt = a;
+	m_yopt = y;
+
+	// now calculate the derivatives using forward differences
+	for (int i=0; i<ma; ++i)
+	{
+		const vector<double>& a1 = as[i + 1];
+		const vector<double>& y1 = ys[i + 1];
 		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/(a1[i] - a[i]);
-		a1[i] = a[i];
 	}
 }
 
+//-----------------------------------------------------------------------------
+void FEConstrainedLMOptimizeMethod::Jacobian(double* p, double* jac, int m, int n)
+{
+	vector<double> x(n), a(p, p + m), y(n);
+	matrix dyda(n, m);
+	ObjFun(x, a, y, dyda);
+
+	// levmar expects the jacobian in row-major order
+	for (int i=0; i<n; ++i)
+		for (int j=0; j<m; ++j) jac[i*m + j] = dyda[i][j];
+}
+
 #endif
@@ -41,6 +41,9 @@ public:
 
 	FEOptimizeData* GetOptimizeData() { return m_pOpt; }
 
+	// calculate the jacobian at p (in the row-major layout of levmar)
+	void Jacobian(double* p, double* jac, int m, int n);
+
 protected:
 	FEOptimizeData* m_pOpt;
 
@@ -54,9 +57,11 @@ public:
 	double	m_objtol;	// objective tolerance
 	double	m_fdiff;	// forward difference step size
 	int		m_nmax;		// maximum number of iterations
+	int		m_nworkers;	// nr of worker processes for the forward difference solves (0 = let levmar do the differences)
     int     m_loglevel; // log file output level
 
 public:
+	vector<double>	m_aopt;	// parameters of the last evaluation
 	vector<double>	m_yopt;	// optimal y-values
 
 	DECLARE_FECORE_CLASS();
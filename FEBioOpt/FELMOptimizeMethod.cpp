@@ -39,6 +39,7 @@ BEGIN_FECORE_CLASS(FELMOptimizeMethod, FEOptimizeMethod)
 	ADD_PARAMETER(m_fdiff , "f_diff_scale");
 	ADD_PARAMETER(m_nmax  , "max_iter"    );
 	ADD_PARAMETER(m_bcov  , "print_cov"   );
+	ADD_PARAMETER(m_nworkers, "fd_workers");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -75,6 +76,7 @@ FELMOptimizeMethod::FELMOptimizeMethod()
 	m_fdiff  = 0.001;
 	m_nmax   = 100;
 	m_bcov   = 0;
+	m_nworkers = 0;
 	m_loglevel = LogLevel::LOG_NEVER;
 }
 
@@ -196,30 +198,34 @@ void FELMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<dou
 		}
 	}
 	
-	// evaluate at a
-	if (opt.FESolve(a) == false) throw FEErrorTermination();
-	
-	opt.GetObjective().Evaluate(y);
-	m_yopt = y;
-
-	// now calculate the derivatives using forward differences
+	// Setup the parameter sets: the first one evaluates at a, the others are the
+	// forward differences for the derivatives. Since these solves are independent,
+	// they can be done concurrently.
 	int ndata = (int)x.size();
-	vector<double> a1(a);
-	vector<double> y1(ndata);
 	int ma = (int)a.size();
+	vector< vector<double> > as(ma + 1, a), ys;
 	for (int i=0; i<ma; ++i)
 	{
 		FEInputParameter& var = *opt.GetInputParameter(i);
 
 		double b = var.ScaleFactor();
 
-		a1[i] = a1[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
-		assert(a1[i] != a[i]);
+		as[i + 1][i] = a[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
+		assert(as[i + 1][i] != a[i]);
+	}
+
+	// solve all
+	if (opt.FESolveBatch(as, ys, m_nworkers) == false) throw FEErrorTermination();
 
-		if (opt.FESolve(a1) == false) throw FEErrorTermination();
-		opt.GetObjective().Evaluate(y1);
+	y = ys[0];
+	m_yopt = y;
+
+	// now calculate the derivatives using forward differences
+	for (int i=0; i<ma; ++i)
+	{
+		const vector<double>& a1 = as[i + 1];
+		const vector<double>& y1 = ys[i + 1];
 		for (int j=0; j<ndata; ++j) dyda[j][i] = (y1[j] - y[j])/(a1[i] - a[i]);
-		a1[i] = a[i];
 	}
 }
 
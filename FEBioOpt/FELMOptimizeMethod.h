@@ -53,6 +53,7 @@ public:
 	double			m_fdiff;	// forward difference step size
 	int				m_nmax;		// maximum number of iterations
 	bool			m_bcov;		// flag to print covariant matrix
+	int				m_nworkers;	// nr of worker processes for the forward difference solves (0 = solve serially)
 
 protected:
 	vector<double>	m_yopt;	// optimal y-values
@@ -34,6 +34,16 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/log.h>
+#include <FECore/FENewtonSolver.h>
+#ifndef WIN32
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/wait.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -102,6 +112,8 @@ FEOptimizeData::FEOptimizeData(FEModel* fem) : m_fem(fem)
 	m_pTask = 0;
 	m_niter = 0;
 	m_obj = 0;
+	m_bcache = false;
+	m_nwarm = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -200,17 +212,9 @@ bool FEOptimizeData::RunTask()
 }
 
 //-----------------------------------------------------------------------------
-//! solve the FE problem with a new set of parameters
-bool FEOptimizeData::FESolve(const vector<double>& a)
+//! set the input parameters
+bool FEOptimizeData::SetInputParameters(const vector<double>& a)
 {
-	// increase iterator counter
-	m_niter++;
-
-	// reset objective function data
-	FEObjectiveFunction& obj = GetObjective();
-	obj.Reset();
-
-	// set the input parameters
 	int nvar = InputParameters();
 	if (nvar != (int)a.size()) return false;
 	for (int i = 0; i<nvar; ++i)
@@ -218,24 +222,364 @@ bool FEOptimizeData::FESolve(const vector<double>& a)
 		FEInputParameter& var = *GetInputParameter(i);
 		var.SetValue(a[i]);
 	}
+	return true;
+}
 
-	// report the new values
-	feLog("\n----- Iteration: %d -----\n", m_niter);
+//-----------------------------------------------------------------------------
+//! write the parameter values to the log
+void FEOptimizeData::LogParameters(const vector<double>& a)
+{
+	int nvar = InputParameters();
 	for (int i = 0; i<nvar; ++i)
 	{
 		FEInputParameter& var = *GetInputParameter(i);
 		string name = var.GetName();
-		feLog("%-15s = %lg\n", name.c_str(), var.GetValue());
+		feLog("%-15s = %lg\n", name.c_str(), a[i]);
 	}
+}
+
+//-----------------------------------------------------------------------------
+//! solve the FE problem with a new set of parameters
+bool FEOptimizeData::FESolve(const vector<double>& a)
+{
+	// increase iterator counter
+	m_niter++;
+
+	// reset objective function data
+	FEObjectiveFunction& obj = GetObjective();
+	obj.Reset();
+
+	// set the input parameters
+	if (SetInputParameters(a) == false) return false;
+
+	// report the new values
+	feLog("\n----- Iteration: %d -----\n", m_niter);
+	LogParameters(a);
 
 	// reset the FEM data
 	FEModel& fem = *GetFEModel();
 	fem.Reset();
 
 	// solve the FE problem
+	InitWarmStart(a);
 	fem.BlockLog();
 	bool bret = RunTask();
 	fem.UnBlockLog();
+	FinishWarmStart(bret);
 
 	return bret;
 }
+
+//-----------------------------------------------------------------------------
+//! solve the FE problem with a new set of parameters and evaluate the function values
+bool FEOptimizeData::FESolve(const vector<double>& a, vector<double>& y, double* fobj)
+{
+	double f = 0.0;
+	if (FindCached(a, y)) f = ReportCached(a, y);
+	else
+	{
+		if (FESolve(a) == false) return false;
+		f = GetObjective().Evaluate(y);
+		AddToCache(a, y);
+	}
+	if (fobj) *fobj = f;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Solve the FE problem in a worker process. The log stays blocked since 
+//! the parent process reports the results. The data records are turned off 
+//! as well, since the worker shares their files with the parent.
+bool FEOptimizeData::WorkerSolve(const vector<double>& a, vector<double>& y)
+{
+	FEModel& fem = *GetFEModel();
+	fem.BlockLog();
+	for (int i = 0; i < fem.Steps(); ++i)
+	{
+		fem.GetStep(i)->SetOutputLevel(FE_OUTPUT_NEVER);
+	}
+
+	FEObjectiveFunction& obj = GetObjective();
+	obj.Reset();
+
+	if (SetInputParameters(a) == false) return false;
+
+	fem.Reset();
+	InitWarmStart(a);
+	if (RunTask() == false) return false;
+
+	obj.Evaluate(y);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Looks up the function values of a parameter set in the cache
+bool FEOptimizeData::FindCached(const vector<double>& a, vector<double>& y)
+{
+	if (m_bcache == false) return false;
+	map< vector<double>, vector<double> >::iterator it = m_cache.find(a);
+	if (it == m_cache.end()) return false;
+	y = it->second;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEOptimizeData::AddToCache(const vector<double>& a, const vector<double>& y)
+{
+	if (m_bcache) m_cache[a] = y;
+}
+
+//-----------------------------------------------------------------------------
+//! report a cached evaluation in the log and return its objective value
+double FEOptimizeData::ReportCached(const vector<double>& a, const vector<double>& y)
+{
+	feLog("\n----- Cached evaluation -----\n");
+	LogParameters(a);
+	return GetObjective().ObjectiveValue(y);
+}
+
+//-----------------------------------------------------------------------------
+//! Sets up the solvers for a warm start of the parameter set a. The initial guesses
+//! come from the stored evaluation that is nearest to a, and the converged states
+//! of this solve are stored as a new evaluation.
+void FEOptimizeData::InitWarmStart(const vector<double>& a)
+{
+	if (m_nwarm <= 0) return;
+
+	// find the nearest evaluation (the distance is measured relative to the parameter scale factors)
+	const FESolutionHistory* guess = nullptr;
+	double dmin = 0.0;
+	int nvar = InputParameters();
+	for (list<WARM_START>::iterator it = m_warm.begin(); it != m_warm.end(); ++it)
+	{
+		double d = 0.0;
+		for (int i = 0; i < nvar; ++i)
+		{
+			double s = GetInputParameter(i)->ScaleFactor();
+			if (s == 0.0) s = 1.0;
+			double di = (a[i] - it->a[i]) / s;
+			d += di*di;
+		}
+		if ((guess == nullptr) || (d < dmin))
+		{
+			guess = &it->history;
+			dmin = d;
+		}
+	}
+
+	// add a new evaluation for storing the converged states
+	m_warm.push_back(WARM_START());
+	WARM_START& ws = m_warm.back();
+	ws.a = a;
+
+	FEModel& fem = *GetFEModel();
+	for (int i = 0; i < fem.Steps(); ++i)
+	{
+		FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(fem.GetStep(i)->GetFESolver());
+		if (solver)
+		{
+			solver->SetInitialGuess(guess);
+			solver->SetSolutionHistory(&ws.history);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Cleans up after a warm start. Failed solves are not kept and only the last 
+//! m_nwarm evaluations are kept.
+void FEOptimizeData::FinishWarmStart(bool bsuccess)
+{
+	if (m_nwarm <= 0) return;
+
+	FEModel& fem = *GetFEModel();
+	for (int i = 0; i < fem.Steps(); ++i)
+	{
+		FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(fem.GetStep(i)->GetFESolver());
+		if (solver)
+		{
+			solver->SetInitialGuess(nullptr);
+			solver->SetSolutionHistory(nullptr);
+		}
+	}
+
+	if ((bsuccess == false) && (m_warm.empty() == false)) m_warm.pop_back();
+	while ((int)m_warm.size() > m_nwarm) m_warm.pop_front();
+}
+
+#ifndef WIN32
+//-----------------------------------------------------------------------------
+// read n bytes from a pipe. Returns false if the pipe was closed before all data was read.
+static bool read_pipe(int fd, void* pd, size_t n)
+{
+	char* p = (char*)pd;
+	while (n > 0)
+	{
+		ssize_t m = read(fd, p, n);
+		if ((m < 0) && (errno == EINTR)) continue;
+		if (m <= 0) return false;
+		p += m;
+		n -= m;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// write n bytes to a pipe
+static bool write_pipe(int fd, const void* pd, size_t n)
+{
+	const char* p = (const char*)pd;
+	while (n > 0)
+	{
+		ssize_t m = write(fd, p, n);
+		if ((m < 0) && (errno == EINTR)) continue;
+		if (m <= 0) return false;
+		p += m;
+		n -= m;
+	}
+	return true;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+bool FEOptimizeData::FESolveBatch(const vector< vector<double> >& a, vector< vector<double> >& y, int nworkers)
+{
+	int N = (int)a.size();
+	y.resize(N);
+	if (N == 0) return true;
+
+	FEObjectiveFunction& obj = GetObjective();
+
+	// see which parameter sets were evaluated before
+	vector<bool> cached(N, false);
+	vector<int> todo;
+	for (int i = 0; i < N; ++i)
+	{
+		cached[i] = FindCached(a[i], y[i]);
+		if (cached[i] == false) todo.push_back(i);
+	}
+
+#ifndef WIN32
+	if ((nworkers > 0) && (todo.size() > 1))
+	{
+		int ndata = obj.Measurements();
+		int NT = (int)todo.size();
+
+		// process ID and read end of the result pipe of each worker
+		vector<pid_t> pid(NT, -1);
+		vector<int> fd(NT, -1);
+
+		// start a worker process for parameter set todo[n]
+		auto launch = [&](int n) -> bool {
+			// make sure the worker doesn't inherit (and flush) buffered output
+			fflush(0);
+
+			int p[2];
+			if (pipe(p) != 0) return false;
+			pid_t id = fork();
+			if (id < 0) { close(p[0]); close(p[1]); return false; }
+			if (id == 0)
+			{
+				// This is the worker. The concurrency comes from the workers, so each worker
+				// runs single-threaded. (The OpenMP thread pool of the parent does not exist
+				// in the child anyway.)
+				close(p[0]);
+#ifdef _OPENMP
+				omp_set_num_threads(1);
+#endif
+				vector<double> yi(ndata, 0.0);
+				int status = 0;
+				try {
+					status = (WorkerSolve(a[todo[n]], yi) ? 1 : 0);
+				}
+				catch (...) { status = 0; }
+				bool bok = write_pipe(p[1], &status, sizeof(int));
+				if (bok && (ndata > 0)) bok = write_pipe(p[1], &yi[0], ndata*sizeof(double));
+				_exit(bok ? 0 : 1);
+			}
+			close(p[1]);
+			pid[n] = id;
+			fd[n] = p[0];
+			return true;
+		};
+
+		// start the first batch of workers
+		bool bret = true;
+		int next = 1;
+		for (; (next < NT) && (next <= nworkers); ++next)
+		{
+			if (launch(next) == false) { bret = false; break; }
+		}
+
+		// report the cached evaluations that come before the first set
+		int n0 = todo[0];
+		if (bret)
+		{
+			for (int i = 0; i < n0; ++i) ReportCached(a[i], y[i]);
+		}
+
+		// solve the first parameter set in this process while the workers are running
+		if (bret)
+		{
+			bret = FESolve(a[n0]);
+			if (bret) obj.Evaluate(y[n0]);
+		}
+
+		// collect the results in order, and keep the workers busy
+		for (int n = 1; n < NT; ++n)
+		{
+			if (pid[n] < 0) continue;
+
+			if (bret)
+			{
+				vector<double>& yi = y[todo[n]];
+				int status = 0;
+				yi.assign(ndata, 0.0);
+				bool bok = read_pipe(fd[n], &status, sizeof(int)) && (status == 1);
+				if (bok && (ndata > 0)) bok = read_pipe(fd[n], &yi[0], ndata*sizeof(double));
+				if (bok == false) bret = false;
+			}
+			else kill(pid[n], SIGKILL);
+
+			close(fd[n]);
+			waitpid(pid[n], 0, 0);
+
+			if (bret && (next < NT))
+			{
+				if (launch(next)) ++next; else bret = false;
+			}
+		}
+		if (bret == false) return false;
+
+		// report the remaining results in the same order as the serial solves would
+		for (int i = n0 + 1; i < N; ++i)
+		{
+			if (cached[i]) ReportCached(a[i], y[i]);
+			else
+			{
+				m_niter++;
+				feLog("\n----- Iteration: %d -----\n", m_niter);
+				LogParameters(a[i]);
+				obj.ObjectiveValue(y[i]);
+			}
+		}
+
+		for (int n = 0; n < NT; ++n) AddToCache(a[todo[n]], y[todo[n]]);
+
+		return true;
+	}
+#endif
+
+	// solve all parameter sets in this process
+	for (int i = 0; i < N; ++i)
+	{
+		if (cached[i]) ReportCached(a[i], y[i]);
+		else
+		{
+			if (FESolve(a[i]) == false) return false;
+			obj.Evaluate(y[i]);
+			AddToCache(a[i], y[i]);
+		}
+	}
+	return true;
+}
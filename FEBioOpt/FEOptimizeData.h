@@ -30,9 +30,12 @@ SOFTWARE.*/
 #include <FEBioXML/XMLReader.h>
 #include <FECore/FEModel.h>
 #include <FECore/FECoreTask.h>
+#include <FECore/FESolutionHistory.h>
 #include "FEObjectiveFunction.h"
 #include <vector>
 #include <string>
+#include <map>
+#include <list>
 using namespace std;
 
 //-----------------------------------------------------------------------------
@@ -144,6 +147,18 @@ public:
 	//! solve the FE problem with a new set of parameters
 	bool FESolve(const vector<double>& a);
 
+	//! Solve the FE problem with a new set of parameters and evaluate the function values y
+	//! and (optionally) the objective value. This uses the evaluation cache (if enabled).
+	bool FESolve(const vector<double>& a, vector<double>& y, double* fobj = 0);
+
+	//! Solve the FE problem for several sets of parameters and evaluate the objective
+	//! function values y for each set. The first set is solved in this process. If nworkers > 0
+	//! the other sets are solved concurrently by up to nworkers worker processes that are
+	//! forked from this process. The results are gathered in the order of the parameter sets
+	//! so they do not depend on the number of workers. Sets that are found in the evaluation
+	//! cache (if enabled) are not solved again.
+	bool FESolveBatch(const vector< vector<double> >& a, vector< vector<double> >& y, int nworkers);
+
 public:
 	// return the number of input parameters
 	int InputParameters() { return (int)m_Var.size(); }
@@ -174,6 +189,35 @@ public:
 
 	bool RunTask();
 
+public:
+	//! Turn the evaluation cache on or off. When on, the function values of each parameter
+	//! set are stored so that parameter sets that are revisited are not solved again.
+	void SetEvaluationCache(bool b) { m_bcache = b; }
+
+	//! Set the number of evaluations whose converged states are kept for warm starts (0 = off).
+	//! When on, the time steps of a solve start from the converged states of the nearest
+	//! stored evaluation instead of the previous time step.
+	void SetWarmStart(int n) { m_nwarm = n; }
+
+protected:
+	//! set the input parameters
+	bool SetInputParameters(const vector<double>& a);
+
+	//! write the parameter values to the log
+	void LogParameters(const vector<double>& a);
+
+	//! solve the FE problem in a worker process and evaluate the function values
+	bool WorkerSolve(const vector<double>& a, vector<double>& y);
+
+	//! evaluation cache
+	bool FindCached(const vector<double>& a, vector<double>& y);
+	void AddToCache(const vector<double>& a, const vector<double>& y);
+	double ReportCached(const vector<double>& a, const vector<double>& y);
+
+	//! warm start
+	void InitWarmStart(const vector<double>& a);
+	void FinishWarmStart(bool bsuccess);
+
 public:
 	int	m_niter;	// nr of minor iterations (i.e. FE solves)
 
@@ -188,4 +232,17 @@ protected:
 
 	std::vector<FEInputParameter*>	    m_Var;
 	std::vector<OPT_LIN_CONSTRAINT>		m_LinCon;
+
+	// evaluation cache
+	bool	m_bcache;
+	std::map< vector<double>, vector<double> >	m_cache;
+
+	// stored evaluations for warm starts
+	struct WARM_START
+	{
+		vector<double>		a;			// parameter values
+		FESolutionHistory	history;	// converged states
+	};
+	int		m_nwarm;
+	std::list<WARM_START>	m_warm;
 };
@@ -137,6 +137,19 @@ void FEOptionsSection::Parse(XMLTag& tag)
 						else throw XMLReader::InvalidValue(tag);
 					}
 				}
+				else if (tag == "cache")
+				{
+					int n = 0;
+					tag.value(n);
+					m_opt->SetEvaluationCache(n != 0);
+				}
+				else if (tag == "warm_start")
+				{
+					int n = 0;
+					tag.value(n);
+					if (n < 0) throw XMLReader::InvalidValue(tag);
+					m_opt->SetWarmStart(n);
+				}
 				else throw XMLReader::InvalidTag(tag);
 			}
 			++tag;
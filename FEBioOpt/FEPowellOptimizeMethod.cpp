@@ -86,17 +86,13 @@ double FEPowellOptimizeMethod::ObjFun(double *p)
 	vector<double> a(nvar);
 	for (int i=0; i<nvar; ++i) a[i] = p[i];
 
-	// solve the FE problem with the new parameters
-	if (opt.FESolve(a) == false)
+	// solve the FE problem with the new parameters and evaluate the objective function
+	vector<double> y;
+	double fobj = 0.0;
+	if (opt.FESolve(a, y, &fobj) == false)
 	{
 		feLogEx(fem, "\n\n\nAAAAAAAAARRRRRRRRRGGGGGGGGHHHHHHHHHHH !!!!!!!!!!!!!\n\n\n\n");
 		return 0;
 	}
-	else
-	{
-		// evaluate objective function
-		FEObjectiveFunction& obj = opt.GetObjective();
-		double fobj = obj.Evaluate();
-		return fobj;
-	}
+	else return fobj;
 }
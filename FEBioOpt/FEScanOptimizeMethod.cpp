@@ -43,7 +43,6 @@ bool FEScanOptimizeMethod::Solve(FEOptimizeData* pOpt, vector<double>& amin, vec
 {
 	if (pOpt == 0) return false;
 	FEOptimizeData& opt = *pOpt;
-	FEObjectiveFunction& obj = opt.GetObjective();
 
 	// set the intial values for the variables
 	int ma = opt.InputParameters();
@@ -61,10 +60,9 @@ bool FEScanOptimizeMethod::Solve(FEOptimizeData* pOpt, vector<double>& amin, vec
 	do
 	{
 		// solve the problem with the new input parameters
-		if (opt.FESolve(a) == false) return false;
-
-		// calculate objective function
-		double fobj = obj.Evaluate(y);
+		// and calculate objective function
+		double fobj = 0.0;
+		if (opt.FESolve(a, y, &fobj) == false) return false;
 
 		// update minimum
 		if ((fmin == 0.0) || (fobj < fmin))
@@ -34,6 +34,12 @@ SOFTWARE.*/
 #include "FECore/FEMaterial.h"
 #include <FEBioLib/version.h>
 #include <FECore/FESurface.h>
+#include <FECore/log.h>
+#include "PltReader.h"
+
+// When the delta filter is used, every so many states are stored without 
+// the delta, so that a reader does not need to go back too far to decode a state.
+#define PLT_DELTA_KEY_INTERVAL	16
 
 FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM()
 {
@@ -495,6 +501,9 @@ void FEBioPlotFile::Dictionary::Clear()
 FEBioPlotFile::FEBioPlotFile(FEModel& fem) : m_fem(fem)
 {
 	m_ncompress = 0;
+	m_nbuf = 0;
+	m_nkey = 0;
+	m_bindex = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -554,6 +563,12 @@ void FEBioPlotFile::SetCompression(int n)
 	m_ncompress = n;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::SetStateIndex(bool b)
+{
+	m_bindex = b;
+}
+
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::IsValid() const
 {
@@ -563,14 +578,48 @@ bool FEBioPlotFile::IsValid() const
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::Close()
 {
+	// the index is written when the file is closed
+	if (m_bindex && m_ar.IsValid()) WriteStateIndex();
+
 	m_ar.Close();
 }
 
+//-----------------------------------------------------------------------------
+// Writes the state index at the end of the file. The index must be the last
+// chunk in the file, and its last child stores the location of the index.
+void FEBioPlotFile::WriteStateIndex()
+{
+	// this waits until all the states are written
+	long long nindex = m_ar.Tell();
+
+	m_ar.SetCompression(0);
+	m_ar.BeginChunk(PLT_INDEX);
+	{
+		for (size_t i = 0; i < m_index.size(); ++i)
+		{
+			StateIndex& si = m_index[i];
+			if (si.ntree >= 0) si.offset = m_ar.TreeOffset(si.ntree);
+
+			m_ar.BeginChunk(PLT_INDEX_STATE);
+			{
+				m_ar.WriteChunk(PLT_INDEX_STATE_OFFSET, si.offset);
+				m_ar.WriteChunk(PLT_INDEX_STATE_TIME, si.time);
+				if (si.vars.empty() == false) m_ar.WriteChunk(PLT_INDEX_STATE_VARS, si.vars);
+			}
+			m_ar.EndChunk();
+		}
+		m_ar.WriteChunk(PLT_INDEX_OFFSET, nindex);
+	}
+	m_ar.EndChunk();
+}
+
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::Open(FEModel &fem, const char *szfile)
 {
 	// open the archive
 	m_ar.Create(szfile);
+	m_prevNodeData.clear();
+	m_index.clear();
 
 	try
 	{
@@ -1178,14 +1227,27 @@ bool FEBioPlotFile::Write(FEModel &fem, float ftime)
 	// store the fem pointer
 	m_pfem = &fem;
 
+	// evaluate all the plot variables
+	EvaluateData(fem);
+
 	// compress these sections if requested
-	m_ar.SetCompression(m_ncompress);
+	m_ar.SetCompression(m_ncompress & PLT_COMPRESS_MASK);
 	m_ar.BeginChunk(PLT_STATE);
 	{
 		// state header
 		m_ar.BeginChunk(PLT_STATE_HEADER);
 		{
 			m_ar.WriteChunk(PLT_STATE_HDR_TIME, ftime);
+
+			// The first state after the file is opened does not use the previous state, 
+			// since we don't have it when appending to an existing file.
+			if (m_ncompress & PLT_FILTER_DELTA)
+			{
+				if (m_nkey >= PLT_DELTA_KEY_INTERVAL) m_prevNodeData.clear();
+				int ndelta = (m_prevNodeData.empty() ? 0 : 1);
+				m_ar.WriteChunk(PLT_STATE_HDR_DELTA, ndelta);
+				m_nkey = (ndelta ? m_nkey + 1 : 1);
+			}
 		}
 		m_ar.EndChunk();
 
@@ -1239,12 +1301,170 @@ bool FEBioPlotFile::Write(FEModel &fem, float ftime)
 			}
 		}
 		m_ar.EndChunk();
+
+		// add the state to the index. The file offset is only known after
+		// the state is written, so for now we store the chunk tree number.
+		if (m_bindex)
+		{
+			StateIndex si;
+			si.ntree = m_ar.Trees();
+			si.offset = 0;
+			si.time = ftime;
+			m_ar.GetChunkOffsets(PLT_STATE_VARIABLE, si.vars);
+			m_index.push_back(si);
+		}
 	}
 	m_ar.EndChunk();
 
+	// we don't need the data anymore
+	m_buf.clear();
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Evaluates the data of all the plot variables of the current state. The data
+// is stored in the data buffers, in the order in which it will be written to the file.
+// Since evaluating some plot variables is expensive (e.g. stresses), the buffers are 
+// filled in parallel. Each buffer is filled by a single thread, so the output does not 
+// depend on the number of threads.
+void FEBioPlotFile::EvaluateData(FEModel& fem)
+{
+	FEMesh& m = fem.GetMesh();
+	m_buf.clear();
+	m_nbuf = 0;
+
+	DataBuffer buf;
+	buf.bok = false;
+
+	// node data
+	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Node.begin();
+	for (int i = 0; i < (int)m_dic.m_Node.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		// loop over all node sets
+		// write now there is only one, namely the master node set
+		// so we just pass the mesh
+		buf.pd = pd;
+		buf.nregion = 0;
+		buf.nsize = pd->VarSize(pd->DataType())*m.Nodes();
+		m_buf.push_back(buf);
+	}
+
+	// domain data
+	it = m_dic.m_Elem.begin();
+	for (int i = 0; i < (int)m_dic.m_Elem.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		// if the item list is empty, store all domains
+		vector<int> item = pd->GetItemList();
+		if (item.empty())
+		{
+			for (int j = 0; j < m.Domains(); ++j) item.push_back(j);
+		}
+
+		// loop over all domains in the item list
+		for (int j = 0; j < (int)item.size(); ++j)
+		{
+			// get the domain
+			FEDomain& D = m.Domain(item[j]);
+
+			// calculate the size of the data vector
+			int nsize = pd->VarSize(pd->DataType());
+			switch (pd->StorageFormat())
+			{
+			case FMT_NODE: nsize *= D.Nodes(); break;
+			case FMT_ITEM: nsize *= D.Elements(); break;
+			case FMT_MULT:
+			{
+				// since all elements have the same type within a domain
+				// we just grab the number of nodes of the first element 
+				// to figure out how much storage we need
+				FEElement& e = D.ElementRef(0);
+				int n = e.Nodes();
+				nsize *= n*D.Elements();
+			}
+			break;
+			case FMT_REGION:
+				// one value for this domain so nsize remains unchanged
+				break;
+			default:
+				assert(false);
+			}
+			assert(nsize > 0);
+
+			buf.pd = pd;
+			buf.nregion = item[j];
+			buf.nsize = nsize;
+			m_buf.push_back(buf);
+		}
+	}
+
+	// surface data
+	it = m_dic.m_Face.begin();
+	for (int i = 0; i < (int)m_dic.m_Face.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		// loop over all surfaces
+		for (int j = 0; j < m.Surfaces(); ++j)
+		{
+			FESurface& S = m.Surface(j);
+
+			Surface& surf = m_Surf[j];
+			assert(surf.surf == &S);
+
+			// Determine data size.
+			// Note that for the FMT_MULT case we are 
+			// assuming 9 data entries per facet
+			// regardless of the nr of nodes a facet really has
+			// this is because for surfaces, all elements are not
+			// necessarily of the same type
+			// TODO: Fix the assumption of the FMT_MULT
+			int nsize = pd->VarSize(pd->DataType());
+			switch (pd->StorageFormat())
+			{
+			case FMT_NODE: nsize *= S.Nodes(); break;
+			case FMT_ITEM: nsize *= S.Elements(); break;
+			case FMT_MULT: nsize *= surf.maxNodes * S.Elements(); break;
+			case FMT_REGION:
+				// one value per surface so nsize remains unchanged
+				break;
+			default:
+				assert(false);
+			}
+
+			buf.pd = pd;
+			buf.nregion = j;
+			buf.nsize = nsize;
+			m_buf.push_back(buf);
+		}
+	}
+
+	// fill the buffers
+	int NB = (int)m_buf.size();
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int i = 0; i < NB; ++i)
+	{
+		DataBuffer& b = m_buf[i];
+		FEPlotData* pd = b.pd;
+		b.a.reserve(b.nsize);
+		switch (pd->RegionType())
+		{
+		case FE_REGION_NODE   : b.bok = pd->Save(m, b.a); break;
+		case FE_REGION_DOMAIN : b.bok = pd->Save(m.Domain(b.nregion), b.a); break;
+		case FE_REGION_SURFACE: b.bok = pd->Save(m.Surface(b.nregion), b.a); break;
+		default:
+			assert(false);
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteGlobalData(FEModel& fem)
 {
@@ -1314,18 +1534,54 @@ void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
 {
-	// loop over all node sets
-	// write now there is only one, namely the master node set
-	// so we just pass the mesh
-	int ndata = pd->VarSize(pd->DataType());
-
-	int N = fem.GetMesh().Nodes();
-	FEDataStream a; a.reserve(ndata*N);
-	if (pd->Save(fem.GetMesh(), a))
+	// the data was already evaluated in EvaluateData
+	DataBuffer& b = m_buf[m_nbuf++];
+	assert(b.pd == pd);
+	if (b.bok)
 	{
-		assert(a.size() == N*ndata);
-		m_ar.WriteData(0, a.data());
+		assert(b.a.size() == b.nsize);
+		vector<float>& a = b.a.data();
+
+		if (m_ncompress & PLT_FILTER_DELTA)
+		{
+			// Most node data changes little between states, so the xor with the previous 
+			// state has many zero bits, which compress well. Since the xor is done on the
+			// bit patterns, this is lossless.
+			vector<float>& prev = m_prevNodeData[pd];
+			vector<float> tmp(a);
+			if (prev.size() == a.size())
+			{
+				unsigned int* pa = (unsigned int*)&a[0];
+				const unsigned int* pp = (const unsigned int*)&prev[0];
+				for (size_t i = 0; i < a.size(); ++i) pa[i] ^= pp[i];
+			}
+			prev.swap(tmp);
+		}
+
+		WriteStateData(0, a);
 	}
+	else m_prevNodeData.erase(pd);
+}
+
+//-----------------------------------------------------------------------------
+// Applies the shuffle filter (if requested) and adds the data to the state.
+void FEBioPlotFile::WriteStateData(int nid, vector<float>& a)
+{
+	if ((m_ncompress & PLT_FILTER_SHUFFLE) && (a.empty() == false))
+	{
+		// The exponent and high mantissa bytes of similar values are often identical,
+		// so grouping the bytes by position helps the compression.
+		const size_t N = a.size();
+		const unsigned char* src = (const unsigned char*)&a[0];
+		vector<float> b(N);
+		unsigned char* dst = (unsigned char*)&b[0];
+		for (size_t i = 0; i < N; ++i)
+		{
+			for (size_t k = 0; k < sizeof(float); ++k) dst[k*N + i] = src[i*sizeof(float) + k];
+		}
+		m_ar.WriteData(nid, b);
+	}
+	else m_ar.WriteData(nid, a);
 }
 
 //-----------------------------------------------------------------------------
@@ -1337,41 +1593,23 @@ void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 	for (int i = 0; i<NS; ++i)
 	{
 		FESurface& S = m.Surface(i);
-
 		Surface& surf = m_Surf[i];
-		assert(surf.surf == &S);
-
-		// Determine data size.
-		// Note that for the FMT_MULT case we are 
-		// assuming 9 data entries per facet
-		// regardless of the nr of nodes a facet really has
-		// this is because for surfaces, all elements are not
-		// necessarily of the same type
-		// TODO: Fix the assumption of the FMT_MULT
-		int datasize = pd->VarSize(pd->DataType());
-		int nsize = datasize;
-		switch (pd->StorageFormat())
-		{
-		case FMT_NODE: nsize *= S.Nodes(); break;
-		case FMT_ITEM: nsize *= S.Elements(); break;
-		case FMT_MULT: nsize *= surf.maxNodes * S.Elements(); break;
-		case FMT_REGION:
-			// one value per surface so nsize remains unchanged
-			break;
-		default:
-			assert(false);
-		}
 
-		// save data
-		FEDataStream a; a.reserve(nsize);
-		if (pd->Save(S, a))
+		// the data was already evaluated in EvaluateData
+		DataBuffer& buf = m_buf[m_nbuf++];
+		assert((buf.pd == pd) && (buf.nregion == i));
+		if (buf.bok)
 		{
+			FEDataStream& a = buf.a;
+			int nsize = buf.nsize;
+			int datasize = pd->VarSize(pd->DataType());
+
 			// in FEBio 3.0, the data streams are assumed to have no padding, but for now we still need to pad 
 			// the data stream before we write it to the file
 			if (a.size() == nsize)
 			{
 				// assumed padding is already there, or not needed
-				m_ar.WriteData(i + 1, a.data());
+				WriteStateData(i + 1, a.data());
 			}
 			else
 			{
@@ -1393,7 +1631,7 @@ void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
 				}
 
 				// write the padded data
-				m_ar.WriteData(i + 1, b.data());
+				WriteStateData(i + 1, b.data());
 			}
 		}
 	}
@@ -1414,42 +1652,15 @@ void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
 
 	// loop over all domains in the item list
 	int N = (int)item.size();
-	for (int i = 0; i<ND; ++i)
+	for (int i = 0; i<N; ++i)
 	{
-		// get the domain
-		FEDomain& D = m.Domain(item[i]);
-
-		// calculate the size of the data vector
-		int nsize = pd->VarSize(pd->DataType());
-		switch (pd->StorageFormat())
-		{
-		case FMT_NODE: nsize *= D.Nodes(); break;
-		case FMT_ITEM: nsize *= D.Elements(); break;
-		case FMT_MULT:
+		// the data was already evaluated in EvaluateData
+		DataBuffer& b = m_buf[m_nbuf++];
+		assert((b.pd == pd) && (b.nregion == item[i]));
+		if (b.bok)
 		{
-			// since all elements have the same type within a domain
-			// we just grab the number of nodes of the first element 
-			// to figure out how much storage we need
-			FEElement& e = D.ElementRef(0);
-			int n = e.Nodes();
-			nsize *= n*D.Elements();
-		}
-		break;
-		case FMT_REGION:
-			// one value for this domain so nsize remains unchanged
-			break;
-		default:
-			assert(false);
-		}
-		assert(nsize > 0);
-
-		// fill data vector and save
-		FEDataStream a;
-		a.reserve(nsize);
-		if (pd->Save(D, a))
-		{
-			assert(a.size() == nsize);
-			m_ar.WriteData(item[i] + 1, a.data());
+			assert(b.a.size() == b.nsize);
+			WriteStateData(item[i] + 1, b.a.data());
 		}
 	}
 }
@@ -1469,7 +1680,16 @@ bool FEBioPlotFile::Append(FEModel& fem, const char *szfile)
 	while (m_ar.OpenChunk() == IO_OK)
 	{
 		nid = m_ar.GetChunkID();
-		if (nid == PLT_DICTIONARY)
+		if (nid == PLT_HEADER)
+		{
+			// the new states must be compressed the same way as the existing ones
+			while (m_ar.OpenChunk() == IO_OK)
+			{
+				if (m_ar.GetChunkID() == PLT_HDR_COMPRESSION) m_ar.read(m_ncompress);
+				m_ar.CloseChunk();
+			}
+		}
+		else if (nid == PLT_DICTIONARY)
 		{
 			// read the dictionary
 			bok = ReadDictionary();
@@ -1481,13 +1701,44 @@ bool FEBioPlotFile::Append(FEModel& fem, const char *szfile)
 	// close it again ...
 	m_ar.Close();
 
+	// we don't have the data of the last state
+	m_prevNodeData.clear();
+
 	// rebuild the surface table
 	BuildSurfaceTable();
+	if (bok == false) return false;
+
+	// The new states always go after the existing ones, so an index at the end of the file is removed.
+	// If the state index was requested, the index of the existing states is kept (or rebuilt if the 
+	// file does not have one) and a new index is written when the file is closed.
+	m_index.clear();
+	PltReader plt;
+	if (plt.Open(szfile, m_bindex))
+	{
+		if (m_bindex)
+		{
+			for (int i = 0; i < plt.States(); ++i)
+			{
+				StateIndex si;
+				si.ntree = -1;
+				si.offset = plt.StateOffset(i);
+				si.time = plt.StateTime(i);
+				si.vars = plt.StateVariableOffsets(i);
+				m_index.push_back(si);
+			}
+		}
+		long long nindex = plt.IndexOffset();
+		plt.Close();
+		if (FileStream::Truncate(szfile, nindex) == false) return false;
+	}
+	else if (m_bindex)
+	{
+		feLogWarningEx((&fem), "Failed to build the state index of the existing states in %s.\nThe plot file will be written without a state index.", szfile);
+		m_bindex = false;
+	}
 
 	// ... and open for appending
-	if (bok) return m_ar.Append(szfile);
-
-	return false;
+	return m_ar.Append(szfile);
 }
 
 //-----------------------------------------------------------------------------
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "FECore/FEDiscreteDomain.h"
 #include "FECore/FEDomain2D.h"
 #include <list>
+#include <map>
 using namespace std;
 
 //-----------------------------------------------------------------------------
@@ -113,6 +114,7 @@ public:
 			PLT_STATE_HEADER			= 0x02010000,
 				PLT_STATE_HDR_ID		= 0x02010001,
 				PLT_STATE_HDR_TIME		= 0x02010002,
+				PLT_STATE_HDR_DELTA		= 0x02010003,	// only written when PLT_FILTER_DELTA is set
 			PLT_STATE_DATA				= 0x02020000,
 				PLT_STATE_VARIABLE		= 0x02020001,
 				PLT_STATE_VAR_ID		= 0x02020002,
@@ -123,8 +125,31 @@ public:
 				PLT_ELEMENT_DATA		= 0x02020400,
 				PLT_FACE_DATA			= 0x02020500,
 			PLT_MESH_STATE				= 0x02030000,
-				PLT_ELEMENT_STATE		= 0x02030001
+				PLT_ELEMENT_STATE		= 0x02030001,
+		PLT_INDEX						= 0x03000000,		// optional state index (see SetStateIndex)
+			PLT_INDEX_STATE				= 0x03010000,
+				PLT_INDEX_STATE_OFFSET	= 0x03010001,		// file offset of the state chunk (long long)
+				PLT_INDEX_STATE_TIME	= 0x03010002,		// time of the state (float)
+				PLT_INDEX_STATE_VARS	= 0x03010003,		// offsets of the PLT_STATE_VARIABLE chunks in the uncompressed state chunk
+			PLT_INDEX_OFFSET			= 0x03020000		// file offset of the PLT_INDEX chunk (long long). This is always the last 16 bytes of the file.
 	};
+	// --- compression flags (stored in PLT_HDR_COMPRESSION) ---
+	// The lower byte defines how the states are compressed. The remaining bits define 
+	// the filters that are applied to the state data arrays (i.e. the data of the 
+	// PLT_STATE_VAR_DATA chunks) before compression. Readers must undo the filters
+	// in reverse order, i.e. first undo the shuffle, then the delta.
+	enum {
+		PLT_COMPRESS_NONE		= 0x0000,	// states are not compressed
+		PLT_COMPRESS_ZLIB		= 0x0001,	// each state is one zlib stream
+		PLT_COMPRESS_BLOCKS		= 0x0002,	// each state is split in blocks that are compressed independently (see FileStream::WriteBlocks)
+		PLT_COMPRESS_MASK		= 0x00FF,
+
+		PLT_FILTER_DELTA		= 0x0100,	// node data is stored as the bitwise xor with the same variable of the previous state.
+											// This is only done when the PLT_STATE_HDR_DELTA chunk of the state is nonzero, and the 
+											// variable is stored in the previous state with the same size.
+		PLT_FILTER_SHUFFLE		= 0x0200	// the bytes of the floats are shuffled, i.e. first all the first bytes, then all the second bytes, etc.
+	};
+
 	// --- element types ---
 	enum Elem_Type { 
 		PLT_ELEM_HEX, 
@@ -234,6 +259,10 @@ public:
 	//! Set the compression level
 	void SetCompression(int n);
 
+	//! Write an index of the states at the end of the file, so that readers
+	//! can access states directly (see PltReader).
+	void SetStateIndex(bool b);
+
 	//! see if the plot file is valid
 	virtual bool IsValid() const;
 
@@ -273,6 +302,12 @@ protected:
 
 	void WriteMeshState(FEMesh& mesh);
 
+	void EvaluateData(FEModel& fem);
+
+	void WriteStateData(int nid, vector<float>& a);
+
+	void WriteStateIndex();
+
 protected:
 	bool ReadDictionary();
 	bool ReadDicList();
@@ -285,4 +320,33 @@ protected:
 	int			m_ncompress;	// compression level
 
 	vector<Surface>	m_Surf;
+
+protected:
+	// The data of one plot variable for one region (mesh, domain, or surface).
+	// All buffers of a state are filled in parallel by EvaluateData before the
+	// state is written, and are then written in the order in which they were created.
+	struct DataBuffer
+	{
+		FEPlotData*		pd;			// the plot variable
+		int				nregion;	// index of domain or surface (not used for node data)
+		int				nsize;		// expected size of the data
+		bool			bok;		// return value of FEPlotData::Save
+		FEDataStream	a;			// the evaluated data
+	};
+	vector<DataBuffer>	m_buf;	// data buffers of the current state
+	int					m_nbuf;	// next buffer to write
+
+	map<FEPlotData*, vector<float> >	m_prevNodeData;	// node data of the previous state (used by PLT_FILTER_DELTA)
+	int		m_nkey;		// number of states since the last state that does not use PLT_FILTER_DELTA
+
+	// index entry of a state
+	struct StateIndex
+	{
+		int						ntree;		// chunk tree of the state (-1 if the offset is known)
+		long long				offset;		// file offset of the state
+		float					time;		// state time
+		vector<unsigned int>	vars;		// offsets of the state variables
+	};
+	bool				m_bindex;	// write the state index?
+	vector<StateIndex>	m_index;	// the state index
 };
@@ -28,13 +28,29 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "PltArchive.h"
+#include <FECore/sys.h>
 #include <assert.h>
+#ifdef WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
 
 #ifdef HAVE_ZLIB
 #include "zlib.h"
-static z_stream strm;
+// Each archive streams from its own writer thread.
+static thread_local z_stream strm;
 #endif
 
+// Size of the blocks that are compressed independently when using COMPRESS_BLOCKS
+#define COMPRESS_BLOCK_SIZE	262144
+
+// Max number of chunk trees that can wait to be written. When the queue is full,
+// the solver waits for the writer, which bounds the memory used by pending states.
+#define MAX_WRITE_QUEUE	2
+
 //=============================================================================
 // FileStream
 //=============================================================================
@@ -45,6 +61,7 @@ FileStream::FileStream()
 	m_buf  = new unsigned char[m_bufsize];
 	m_pout = new unsigned char[m_bufsize];
 	m_ncompress = 0;
+	m_nthreads = 0;
 }
 
 FileStream::~FileStream()
@@ -66,7 +83,11 @@ bool FileStream::Open(const char* szfile)
 bool FileStream::Append(const char* szfile)
 {
 	m_fp = fopen(szfile, "a+b");
-	return (m_fp != 0);
+	if (m_fp == 0) return false;
+
+	// make sure tell64 returns the end of the file
+	fseek(m_fp, 0, SEEK_END);
+	return true;
 }
 
 bool FileStream::Create(const char* szfile)
@@ -83,6 +104,12 @@ void FileStream::Close()
 
 void FileStream::BeginStreaming()
 {
+	if (m_ncompress == COMPRESS_BLOCKS)
+	{
+		m_raw.clear();
+		return;
+	}
+
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
@@ -97,6 +124,12 @@ void FileStream::BeginStreaming()
 void FileStream::EndStreaming()
 {
 	Flush();
+	if (m_ncompress == COMPRESS_BLOCKS)
+	{
+		WriteBlocks();
+		return;
+	}
+
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
@@ -148,6 +181,14 @@ void FileStream::Write(void* pd, size_t Size, size_t Count)
 
 void FileStream::Flush()
 {
+	if (m_ncompress == COMPRESS_BLOCKS)
+	{
+		// the data is compressed in EndStreaming, so just collect it
+		m_raw.insert(m_raw.end(), m_buf, m_buf + m_current);
+		m_current = 0;
+		return;
+	}
+
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
@@ -181,6 +222,59 @@ void FileStream::Flush()
 	m_current = 0;
 }
 
+// Writes the data collected since BeginStreaming as a sequence of blocks that are
+// compressed independently, so that they can be compressed (and decompressed) in parallel.
+// The layout is:
+//   unsigned int nblocks
+//   for each block: unsigned int raw size, unsigned int stored size, stored bytes
+// A block is stored uncompressed when its stored size equals its raw size.
+void FileStream::WriteBlocks()
+{
+	const size_t total = m_raw.size();
+	const int nblocks = (int)((total + COMPRESS_BLOCK_SIZE - 1) / COMPRESS_BLOCK_SIZE);
+	vector< vector<unsigned char> > out(nblocks);
+
+	int nthreads = (m_nthreads > 0 ? m_nthreads : omp_get_max_threads());
+	if (nthreads > nblocks) nthreads = nblocks;
+	if (nthreads < 1) nthreads = 1;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+	for (int i = 0; i < nblocks; ++i)
+	{
+		const unsigned char* src = &m_raw[0] + (size_t)i*COMPRESS_BLOCK_SIZE;
+		size_t n = total - (size_t)i*COMPRESS_BLOCK_SIZE;
+		if (n > COMPRESS_BLOCK_SIZE) n = COMPRESS_BLOCK_SIZE;
+
+		vector<unsigned char>& bi = out[i];
+#ifdef HAVE_ZLIB
+		uLongf nout = compressBound((uLong)n);
+		bi.resize(nout);
+		if ((compress2(&bi[0], &nout, src, (uLong)n, Z_DEFAULT_COMPRESSION) == Z_OK) && (nout < n))
+		{
+			bi.resize(nout);
+			continue;
+		}
+#endif
+		// store the block as is
+		bi.assign(src, src + n);
+	}
+
+	unsigned int nb = (unsigned int)nblocks;
+	fwrite(&nb, sizeof(unsigned int), 1, m_fp);
+	for (int i = 0; i < nblocks; ++i)
+	{
+		size_t n = total - (size_t)i*COMPRESS_BLOCK_SIZE;
+		unsigned int nraw = (unsigned int)(n > COMPRESS_BLOCK_SIZE ? COMPRESS_BLOCK_SIZE : n);
+		unsigned int nout = (unsigned int)out[i].size();
+		fwrite(&nraw, sizeof(unsigned int), 1, m_fp);
+		fwrite(&nout, sizeof(unsigned int), 1, m_fp);
+		fwrite(&out[i][0], 1, nout, m_fp);
+	}
+	fflush(m_fp);
+
+	m_raw.clear();
+}
+
 size_t FileStream::read(void* pd, size_t Size, size_t Count)
 {
 	return fread(pd, Size, Count, m_fp);
@@ -196,6 +290,31 @@ void FileStream::seek(long noff, int norigin)
 	fseek(m_fp, noff, norigin);
 }
 
+long long FileStream::tell64()
+{
+#ifdef WIN32
+	long long npos = _ftelli64(m_fp);
+#else
+	long long npos = (long long) ftello(m_fp);
+#endif
+	// the buffered data is only written uncompressed when no compression is active
+	if (m_ncompress == COMPRESS_NONE) npos += (long long)m_current;
+	return npos;
+}
+
+bool FileStream::Truncate(const char* szfile, long long nsize)
+{
+#ifdef WIN32
+	int fd = -1;
+	if (_sopen_s(&fd, szfile, _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) return false;
+	bool bok = (_chsize_s(fd, nsize) == 0);
+	_close(fd);
+	return bok;
+#else
+	return (truncate(szfile, (off_t)nsize) == 0);
+#endif
+}
+
 
 //=============================================================================
 // PltArchive
@@ -207,6 +326,10 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+	m_bstop = false;
+	m_nwriterThreads = 1;
+	m_ntrees = 0;
 }
 
 PltArchive::~PltArchive()
@@ -219,6 +342,9 @@ void PltArchive::Close()
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+
+		// wait until all data is written
+		StopWriter();
 	}
 	else 
 	{
@@ -237,22 +363,132 @@ void PltArchive::Close()
 
 void PltArchive::SetCompression(int n)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	m_ncompress = n;
 }
 
 void PltArchive::Flush()
 {
 	if (m_fp && m_pRoot)
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		m_ntrees++;
+		if (m_writer.joinable())
+		{
+			// hand the tree to the writer thread, but wait if too many are pending
+			WriteJob job = { m_pRoot, m_ncompress };
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this]() { return (m_queue.size() < MAX_WRITE_QUEUE); });
+			m_queue.push_back(job);
+			lock.unlock();
+			m_cv.notify_all();
+			m_pRoot = 0;
+		}
+		else WriteTree(m_pRoot, m_ncompress, 0);
 	}
-	delete m_pRoot;
+	else delete m_pRoot;
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
 
+void PltArchive::WriteTree(OBranch* root, int ncompress, int nthreads)
+{
+	// record where this tree starts
+	long long npos = m_fp->tell64();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_treeOffset.push_back(npos);
+	}
+
+	m_fp->SetCompression(ncompress);
+	m_fp->SetCompressionThreads(nthreads);
+	m_fp->BeginStreaming();
+	root->Write(m_fp);
+	m_fp->EndStreaming();
+	delete root;
+}
+
+void PltArchive::Sync()
+{
+	if (m_writer.joinable() == false) return;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cv.wait(lock, [this]() { return m_queue.empty(); });
+}
+
+long long PltArchive::Tell()
+{
+	Sync();
+	return (m_fp ? m_fp->tell64() : 0);
+}
+
+// helper function for GetChunkOffsets
+static void collect_offsets(OChunk* pc, unsigned int noff, unsigned int nid, vector<unsigned int>& offsets)
+{
+	if (pc->GetID() == nid) offsets.push_back(noff);
+
+	OBranch* pb = dynamic_cast<OBranch*>(pc);
+	if (pb)
+	{
+		// skip the chunk ID and size
+		noff += 2*sizeof(unsigned int);
+		const list<OChunk*>& children = pb->Children();
+		for (list<OChunk*>::const_iterator it = children.begin(); it != children.end(); ++it)
+		{
+			collect_offsets(*it, noff, nid, offsets);
+			noff += (*it)->Size() + 2*sizeof(unsigned int);
+		}
+	}
+}
+
+void PltArchive::GetChunkOffsets(unsigned int nid, vector<unsigned int>& offsets)
+{
+	offsets.clear();
+	if (m_pRoot) collect_offsets(m_pRoot, 0, nid, offsets);
+}
+
+void PltArchive::StartWriter()
+{
+	assert(m_writer.joinable() == false);
+	m_bstop = false;
+
+	// The writer runs while the solver's thread team is busy, so it should only
+	// compress on the cores that the solver does not use.
+	int ncores = (int)std::thread::hardware_concurrency();
+	m_nwriterThreads = ncores - omp_get_max_threads();
+	if (m_nwriterThreads < 1) m_nwriterThreads = 1;
+	m_writer = std::thread(&PltArchive::WriterLoop, this);
+}
+
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable() == false) return;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bstop = true;
+	}
+	m_cv.notify_all();
+	m_writer.join();
+}
+
+void PltArchive::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_cv.wait(lock, [this]() { return (m_bstop || (m_queue.empty() == false)); });
+
+		// only stop after the queue is empty
+		if (m_queue.empty()) break;
+
+		// The job is removed after it is written so that the queue size
+		// includes the tree that is currently being written.
+		WriteJob job = m_queue.front();
+		lock.unlock();
+		WriteTree(job.root, job.ncompress, m_nwriterThreads);
+		lock.lock();
+		m_queue.pop_front();
+		m_cv.notify_all();
+	}
+}
+
 bool PltArchive::Create(const char* szfile)
 {
 	// attempt to create the file
@@ -265,6 +501,10 @@ bool PltArchive::Create(const char* szfile)
 	m_fp->Write(&ntag, sizeof(int), 1);
 
 	m_bSaving = true;
+	m_ntrees = 0;
+	m_treeOffset.clear();
+
+	StartWriter();
 
 	return true;
 }
@@ -328,6 +568,9 @@ bool PltArchive::Append(const char* szfile)
 	m_fp = new FileStream();
 	if (m_fp->Append(szfile) == false) return false;
 	m_bSaving = true;
+	m_ntrees = 0;
+	m_treeOffset.clear();
+	StartWriter();
 	return true;
 }
 
@@ -35,12 +35,24 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 using namespace std;
 
 //-----------------------------------------------------------------------------
 //! helper class for writing buffered data to file
 class FileStream
 {
+public:
+	// compression modes
+	enum {
+		COMPRESS_NONE	= 0,	// no compression
+		COMPRESS_ZLIB	= 1,	// the data between BeginStreaming and EndStreaming is written as one zlib stream
+		COMPRESS_BLOCKS	= 2		// the data is split in blocks that are compressed independently
+	};
+
 public:
 	FileStream();
 	~FileStream();
@@ -59,18 +71,33 @@ public:
 	long tell();
 	void seek(long noff, int norigin);
 
+	// file position that supports large files (includes buffered data that is not written yet)
+	long long tell64();
+
+	// cut off a file at the given size
+	static bool Truncate(const char* szfile, long long nsize);
+
 	void BeginStreaming();
 	void EndStreaming();
 
 	void SetCompression(int n) { m_ncompress = n; }
 
+	// set the number of threads used for block compression (0 = OpenMP default)
+	void SetCompressionThreads(int n) { m_nthreads = n; }
+
+private:
+	void WriteBlocks();
+
 private:
 	FILE*	m_fp;
 	size_t	m_bufsize;		//!< buffer size
 	size_t	m_current;		//!< current index
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
-	int		m_ncompress;	//!< compression level
+	int		m_ncompress;	//!< compression mode
+	int		m_nthreads;		//!< number of threads for block compression (0 = OpenMP default)
+
+	vector<unsigned char>	m_raw;	//!< uncompressed data (only used by COMPRESS_BLOCKS)
 };
 
 class OBranch;
@@ -126,6 +153,8 @@ public:
 
 	void AddChild(OChunk* pc) { m_child.push_back(pc); pc->SetParent(this); }
 
+	const list<OChunk*>& Children() const { return m_child; }
+
 protected:
 	list<OChunk*>	m_child;
 };
@@ -346,14 +375,59 @@ public:
 
 	bool IsValid() const { return (m_fp != 0); }
 
+public:
+	// --- State index support ---
+
+	// Get the offsets, relative to the start of the current chunk tree, of all the chunks
+	// with the given ID. This must be called before the root chunk of the tree is closed.
+	void GetChunkOffsets(unsigned int nid, vector<unsigned int>& offsets);
+
+	// number of chunk trees that were written (or queued) since the file was created or opened for appending
+	int Trees() const { return m_ntrees; }
+
+	// file offset of a chunk tree (only valid after Sync)
+	long long TreeOffset(int n) const { return m_treeOffset[n]; }
+
+	// wait until all the queued chunk trees are written
+	void Sync();
+
+	// current file position (calls Sync)
+	long long Tell();
+
+protected:
+	// The chunk trees are written to file by a separate thread, so that compression
+	// and file I/O can overlap with the calculation of the next state.
+	struct WriteJob
+	{
+		OBranch*	root;		// the chunk tree to write (deleted after writing)
+		int			ncompress;	// compression level
+	};
+
+	void StartWriter();
+	void StopWriter();
+	void WriterLoop();
+	void WriteTree(OBranch* root, int ncompress, int nthreads);
+
 protected:
 	FileStream*	m_fp;		// pointer to file stream
 	bool		m_bSaving;	// read or write mode?
+	int			m_ncompress;	// compression level of the next chunk tree
 
 	// write data
 	OBranch*	m_pRoot;	// chunk tree root
 	OBranch*	m_pChunk;	// current chunk
 
+	// writer thread
+	std::thread				m_writer;	// writes the queued chunk trees
+	std::mutex				m_mutex;	// protects the queue
+	std::condition_variable	m_cv;		// signals changes to the queue
+	std::deque<WriteJob>	m_queue;	// chunk trees waiting to be written
+	bool					m_bstop;	// tells the writer to finish
+	int						m_nwriterThreads;	// threads the writer may use for compression
+
+	int					m_ntrees;		// number of chunk trees that were flushed
+	vector<long long>	m_treeOffset;	// file offsets of the written chunk trees
+
 	// read data
 	bool			m_bend;		// chunk end flag
 	stack<CHUNK*>	m_Chunk;
@@ -0,0 +1,620 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "PltReader.h"
+#include "FEBioPlotFile.h"
+#include <string.h>
+#include <assert.h>
+
+#ifdef HAVE_ZLIB
+#include "zlib.h"
+#endif
+
+//-----------------------------------------------------------------------------
+// helper functions for large file support
+static int fseek64(FILE* fp, long long noff, int norigin)
+{
+#ifdef WIN32
+	return _fseeki64(fp, noff, norigin);
+#else
+	return fseeko(fp, (off_t)noff, norigin);
+#endif
+}
+
+static long long ftell64(FILE* fp)
+{
+#ifdef WIN32
+	return _ftelli64(fp);
+#else
+	return (long long)ftello(fp);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// helper class for walking over the chunks in a memory buffer
+class ChunkIterator
+{
+public:
+	ChunkIterator(const unsigned char* pd, size_t nsize) : m_p(pd), m_end(pd + nsize) { m_id = m_size = 0; m_pd = 0; }
+
+	// move to the next chunk. Returns false at the end of the buffer or if the data is corrupt.
+	bool Next()
+	{
+		if (m_p + 2*sizeof(unsigned int) > m_end) return false;
+		memcpy(&m_id  , m_p, sizeof(unsigned int));
+		memcpy(&m_size, m_p + sizeof(unsigned int), sizeof(unsigned int));
+		m_pd = m_p + 2*sizeof(unsigned int);
+		if (m_pd + m_size > m_end) return false;
+		m_p = m_pd + m_size;
+		return true;
+	}
+
+	unsigned int ID() const { return m_id; }
+	unsigned int Size() const { return m_size; }
+	const unsigned char* Data() const { return m_pd; }
+
+	template <typename T> T Value() const { T v; memcpy(&v, m_pd, sizeof(T)); return v; }
+
+private:
+	const unsigned char*	m_p;
+	const unsigned char*	m_end;
+	const unsigned char*	m_pd;
+	unsigned int	m_id;
+	unsigned int	m_size;
+};
+
+//-----------------------------------------------------------------------------
+PltReader::PltReader()
+{
+	m_fp = 0;
+	m_ncompress = 0;
+	m_index = 0;
+}
+
+//-----------------------------------------------------------------------------
+PltReader::~PltReader()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+void PltReader::Close()
+{
+	if (m_fp) fclose(m_fp);
+	m_fp = 0;
+	m_var.clear();
+	m_state.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::Open(const char* szfile, bool bscan)
+{
+	Close();
+	m_fp = fopen(szfile, "rb");
+	if (m_fp == 0) return false;
+
+	// read the master tag
+	unsigned int ntag = 0;
+	if ((fread(&ntag, sizeof(unsigned int), 1, m_fp) != 1) || (ntag != 0x00464542)) { Close(); return false; }
+
+	// read the header and dictionary
+	if (ReadRoot() == false) { Close(); return false; }
+	long long nroot = ftell64(m_fp);
+
+	// read the state index
+	if (ReadIndex() == false)
+	{
+		// the file does not have an index, so find the states ourselves
+		m_state.clear();
+		if ((bscan == false) || (ScanStates(nroot) == false)) { Close(); return false; }
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::ReadRoot()
+{
+	unsigned int nhdr[2];
+	if (fread(nhdr, sizeof(unsigned int), 2, m_fp) != 2) return false;
+	if (nhdr[0] != FEBioPlotFile::PLT_ROOT) return false;
+
+	std::vector<unsigned char> buf(nhdr[1]);
+	if (buf.empty() || (fread(&buf[0], 1, buf.size(), m_fp) != buf.size())) return false;
+
+	ChunkIterator root(&buf[0], buf.size());
+	while (root.Next())
+	{
+		if (root.ID() == FEBioPlotFile::PLT_HEADER)
+		{
+			ChunkIterator hdr(root.Data(), root.Size());
+			while (hdr.Next())
+			{
+				if (hdr.ID() == FEBioPlotFile::PLT_HDR_COMPRESSION) m_ncompress = hdr.Value<int>();
+			}
+		}
+		else if (root.ID() == FEBioPlotFile::PLT_DICTIONARY)
+		{
+			ChunkIterator dic(root.Data(), root.Size());
+			while (dic.Next())
+			{
+				VARIABLE var;
+				switch (dic.ID())
+				{
+				case FEBioPlotFile::PLT_DIC_NODAL  : var.region = NODE_DATA; break;
+				case FEBioPlotFile::PLT_DIC_DOMAIN : var.region = DOMAIN_DATA; break;
+				case FEBioPlotFile::PLT_DIC_SURFACE: var.region = SURFACE_DATA; break;
+				default:
+					continue;
+				}
+
+				ChunkIterator items(dic.Data(), dic.Size());
+				while (items.Next())
+				{
+					if (items.ID() != FEBioPlotFile::PLT_DIC_ITEM) continue;
+
+					var.ntype = var.nfmt = 0;
+					var.name.clear();
+					ChunkIterator item(items.Data(), items.Size());
+					while (item.Next())
+					{
+						switch (item.ID())
+						{
+						case FEBioPlotFile::PLT_DIC_ITEM_TYPE: var.ntype = item.Value<unsigned int>(); break;
+						case FEBioPlotFile::PLT_DIC_ITEM_FMT : var.nfmt  = item.Value<unsigned int>(); break;
+						case FEBioPlotFile::PLT_DIC_ITEM_NAME:
+						{
+							const char* sz = (const char*)item.Data();
+							var.name.assign(sz, strnlen(sz, item.Size()));
+						}
+						break;
+						}
+					}
+					m_var.push_back(var);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::ReadIndex()
+{
+	// the last chunk in the file stores the location of the index
+	unsigned int nhdr[2];
+	long long noff = 0;
+	if (fseek64(m_fp, -(long long)(2*sizeof(unsigned int) + sizeof(long long)), SEEK_END) != 0) return false;
+	if (fread(nhdr, sizeof(unsigned int), 2, m_fp) != 2) return false;
+	if ((nhdr[0] != FEBioPlotFile::PLT_INDEX_OFFSET) || (nhdr[1] != sizeof(long long))) return false;
+	if (fread(&noff, sizeof(long long), 1, m_fp) != 1) return false;
+
+	// read the index chunk
+	if (fseek64(m_fp, noff, SEEK_SET) != 0) return false;
+	if (fread(nhdr, sizeof(unsigned int), 2, m_fp) != 2) return false;
+	if (nhdr[0] != FEBioPlotFile::PLT_INDEX) return false;
+	std::vector<unsigned char> buf(nhdr[1]);
+	if (buf.empty() || (fread(&buf[0], 1, buf.size(), m_fp) != buf.size())) return false;
+	m_index = noff;
+
+	ChunkIterator index(&buf[0], buf.size());
+	while (index.Next())
+	{
+		if (index.ID() != FEBioPlotFile::PLT_INDEX_STATE) continue;
+
+		STATE s;
+		s.offset = 0;
+		s.time = 0.f;
+		ChunkIterator state(index.Data(), index.Size());
+		while (state.Next())
+		{
+			switch (state.ID())
+			{
+			case FEBioPlotFile::PLT_INDEX_STATE_OFFSET: s.offset = state.Value<long long>(); break;
+			case FEBioPlotFile::PLT_INDEX_STATE_TIME  : s.time = state.Value<float>(); break;
+			case FEBioPlotFile::PLT_INDEX_STATE_VARS:
+			{
+				s.vars.resize(state.Size() / sizeof(unsigned int));
+				if (s.vars.empty() == false) memcpy(&s.vars[0], state.Data(), s.vars.size()*sizeof(unsigned int));
+			}
+			break;
+			}
+		}
+		m_state.push_back(s);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Builds the state index of a file that does not have one by walking over the
+// trees that follow the root. The scan stops at the first tree that is incomplete 
+// (e.g. when the run that wrote the file was killed) and m_index is set to the 
+// end of the last complete tree.
+bool PltReader::ScanStates(long long noff)
+{
+	if (fseek64(m_fp, 0, SEEK_END) != 0) return false;
+	long long nsize = ftell64(m_fp);
+
+	std::vector<unsigned char> buf;
+	while (noff < nsize)
+	{
+		// mesh trees are never compressed, so they can be skipped using their chunk size
+		unsigned int nhdr[2];
+		if (fseek64(m_fp, noff, SEEK_SET) != 0) break;
+		if (fread(nhdr, sizeof(unsigned int), 2, m_fp) != 2) break;
+		if (nhdr[0] == FEBioPlotFile::PLT_MESH)
+		{
+			long long nend = noff + 2*sizeof(unsigned int) + nhdr[1];
+			if (nend > nsize) break;
+			noff = nend;
+			continue;
+		}
+
+		// all other trees are states
+		long long nend = 0;
+		if ((ReadTree(noff, buf, nend) == false) || (nend > nsize)) break;
+
+		ChunkIterator tree(&buf[0], buf.size());
+		if ((tree.Next() == false) || (tree.ID() != FEBioPlotFile::PLT_STATE)) break;
+
+		STATE s;
+		s.offset = noff;
+		s.time = 0.f;
+		ChunkIterator state(tree.Data(), tree.Size());
+		while (state.Next())
+		{
+			if (state.ID() == FEBioPlotFile::PLT_STATE_HEADER)
+			{
+				ChunkIterator hdr(state.Data(), state.Size());
+				while (hdr.Next())
+				{
+					if (hdr.ID() == FEBioPlotFile::PLT_STATE_HDR_TIME) s.time = hdr.Value<float>();
+				}
+			}
+			else if (state.ID() == FEBioPlotFile::PLT_STATE_DATA)
+			{
+				// the variables are grouped by region, in the same order as PltArchive::GetChunkOffsets finds them
+				ChunkIterator data(state.Data(), state.Size());
+				while (data.Next())
+				{
+					ChunkIterator var(data.Data(), data.Size());
+					while (var.Next())
+					{
+						if (var.ID() != FEBioPlotFile::PLT_STATE_VARIABLE) continue;
+						size_t nvar = (var.Data() - &buf[0]) - 2*sizeof(unsigned int);
+						s.vars.push_back((unsigned int)nvar);
+					}
+				}
+			}
+		}
+		m_state.push_back(s);
+		noff = nend;
+	}
+	m_index = noff;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Reads (and decompresses) the whole tree that starts at file offset noff.
+// On return, nend is the file offset just past the tree.
+bool PltReader::ReadTree(long long noff, std::vector<unsigned char>& buf, long long& nend)
+{
+	buf.clear();
+	if (fseek64(m_fp, noff, SEEK_SET) != 0) return false;
+
+	int ncomp = m_ncompress & FEBioPlotFile::PLT_COMPRESS_MASK;
+	if (ncomp == FEBioPlotFile::PLT_COMPRESS_NONE)
+	{
+		unsigned int nhdr[2];
+		if (fread(nhdr, sizeof(unsigned int), 2, m_fp) != 2) return false;
+		buf.resize(2*sizeof(unsigned int) + (size_t)nhdr[1]);
+		memcpy(&buf[0], nhdr, sizeof(nhdr));
+		if (fread(&buf[sizeof(nhdr)], 1, nhdr[1], m_fp) != nhdr[1]) return false;
+		nend = noff + (long long)buf.size();
+		return true;
+	}
+
+#ifdef HAVE_ZLIB
+	if (ncomp == FEBioPlotFile::PLT_COMPRESS_ZLIB)
+	{
+		// inflate until the end of the stream
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		if (inflateInit(&strm) != Z_OK) return false;
+
+		const size_t CHUNK = 262144;
+		std::vector<unsigned char> in(CHUNK), out(CHUNK);
+		int ret = Z_OK;
+		while (ret != Z_STREAM_END)
+		{
+			strm.avail_in = (uInt)fread(&in[0], 1, CHUNK, m_fp);
+			if (strm.avail_in == 0) break;
+			strm.next_in = &in[0];
+			do
+			{
+				strm.avail_out = (uInt)CHUNK;
+				strm.next_out = &out[0];
+				ret = inflate(&strm, Z_NO_FLUSH);
+				if ((ret != Z_OK) && (ret != Z_STREAM_END)) { inflateEnd(&strm); return false; }
+				buf.insert(buf.end(), out.begin(), out.begin() + (CHUNK - strm.avail_out));
+			}
+			while ((strm.avail_out == 0) && (ret != Z_STREAM_END));
+		}
+		nend = noff + (long long)strm.total_in;
+		inflateEnd(&strm);
+		return (ret == Z_STREAM_END);
+	}
+	else if (ncomp == FEBioPlotFile::PLT_COMPRESS_BLOCKS)
+	{
+		// see FileStream::WriteBlocks for the layout
+		unsigned int nblocks = 0;
+		if (fread(&nblocks, sizeof(unsigned int), 1, m_fp) != 1) return false;
+		nend = noff + sizeof(unsigned int);
+		std::vector<unsigned char> in;
+		for (unsigned int i = 0; i < nblocks; ++i)
+		{
+			unsigned int nraw, nstored;
+			if (fread(&nraw   , sizeof(unsigned int), 1, m_fp) != 1) return false;
+			if (fread(&nstored, sizeof(unsigned int), 1, m_fp) != 1) return false;
+			in.resize(nstored);
+			if ((nstored > 0) && (fread(&in[0], 1, nstored, m_fp) != nstored)) return false;
+
+			size_t npos = buf.size();
+			buf.resize(npos + nraw);
+			if (nstored == nraw)
+			{
+				if (nraw > 0) memcpy(&buf[npos], &in[0], nraw);
+			}
+			else
+			{
+				uLongf nout = nraw;
+				if ((uncompress(&buf[npos], &nout, &in[0], nstored) != Z_OK) || (nout != nraw)) return false;
+			}
+			nend += 2*sizeof(unsigned int) + nstored;
+		}
+		return true;
+	}
+#endif
+
+	// unknown (or unsupported) compression
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+int PltReader::FindVariable(const char* szname) const
+{
+	for (size_t i = 0; i < m_var.size(); ++i)
+	{
+		if (m_var[i].name == szname) return (int)i;
+	}
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Reads the bytes [noff, noff + nsize) of the uncompressed state chunk.
+// For compressed states, only the part of the state up to (zlib) or around 
+// (blocks) the requested range is decompressed.
+bool PltReader::ReadState(int nstate, unsigned int noff, unsigned int nsize, std::vector<unsigned char>& buf)
+{
+	buf.resize(nsize);
+	if (nsize == 0) return true;
+	if (fseek64(m_fp, m_state[nstate].offset, SEEK_SET) != 0) return false;
+
+	int ncomp = m_ncompress & FEBioPlotFile::PLT_COMPRESS_MASK;
+	if (ncomp == FEBioPlotFile::PLT_COMPRESS_NONE)
+	{
+		if (fseek64(m_fp, noff, SEEK_CUR) != 0) return false;
+		return (fread(&buf[0], 1, nsize, m_fp) == nsize);
+	}
+
+#ifdef HAVE_ZLIB
+	const size_t nend = (size_t)noff + nsize;
+	if (ncomp == FEBioPlotFile::PLT_COMPRESS_ZLIB)
+	{
+		// inflate the stream until we have all the data we need
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		if (inflateInit(&strm) != Z_OK) return false;
+
+		const size_t CHUNK = 262144;
+		std::vector<unsigned char> in(CHUNK), out(CHUNK);
+		size_t npos = 0;	// position in uncompressed stream
+		int ret = Z_OK;
+		while ((ret != Z_STREAM_END) && (npos < nend))
+		{
+			strm.avail_in = (uInt)fread(&in[0], 1, CHUNK, m_fp);
+			if (strm.avail_in == 0) break;
+			strm.next_in = &in[0];
+			do
+			{
+				strm.avail_out = (uInt)CHUNK;
+				strm.next_out = &out[0];
+				ret = inflate(&strm, Z_NO_FLUSH);
+				if ((ret != Z_OK) && (ret != Z_STREAM_END)) { inflateEnd(&strm); return false; }
+				size_t have = CHUNK - strm.avail_out;
+
+				// copy the part that overlaps with the requested range
+				size_t n0 = (npos > noff ? npos : noff);
+				size_t n1 = (npos + have < nend ? npos + have : nend);
+				if (n1 > n0) memcpy(&buf[n0 - noff], &out[n0 - npos], n1 - n0);
+				npos += have;
+			}
+			while ((strm.avail_out == 0) && (npos < nend));
+		}
+		inflateEnd(&strm);
+		return (npos >= nend);
+	}
+	else if (ncomp == FEBioPlotFile::PLT_COMPRESS_BLOCKS)
+	{
+		// see FileStream::WriteBlocks for the layout
+		unsigned int nblocks = 0;
+		if (fread(&nblocks, sizeof(unsigned int), 1, m_fp) != 1) return false;
+		size_t npos = 0;	// position in uncompressed stream
+		std::vector<unsigned char> in, out;
+		for (unsigned int i = 0; (i < nblocks) && (npos < nend); ++i)
+		{
+			unsigned int nraw, nstored;
+			if (fread(&nraw   , sizeof(unsigned int), 1, m_fp) != 1) return false;
+			if (fread(&nstored, sizeof(unsigned int), 1, m_fp) != 1) return false;
+			if (npos + nraw <= noff)
+			{
+				// skip this block
+				if (fseek64(m_fp, nstored, SEEK_CUR) != 0) return false;
+			}
+			else
+			{
+				in.resize(nstored);
+				if (fread(&in[0], 1, nstored, m_fp) != nstored) return false;
+				const unsigned char* pd = &in[0];
+				if (nstored != nraw)
+				{
+					out.resize(nraw);
+					uLongf nout = nraw;
+					if ((uncompress(&out[0], &nout, &in[0], nstored) != Z_OK) || (nout != nraw)) return false;
+					pd = &out[0];
+				}
+
+				// copy the part that overlaps with the requested range
+				size_t n0 = (npos > noff ? npos : noff);
+				size_t n1 = (npos + nraw < nend ? npos + nraw : nend);
+				if (n1 > n0) memcpy(&buf[n0 - noff], pd + (n0 - npos), n1 - n0);
+			}
+			npos += nraw;
+		}
+		return (npos >= nend);
+	}
+#endif
+
+	// unknown (or unsupported) compression
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// read the PLT_STATE_HDR_DELTA flag of a state
+bool PltReader::ReadStateDelta(int nstate, int& ndelta)
+{
+	ndelta = 0;
+
+	// the state header is the first chunk of the state
+	std::vector<unsigned char> buf;
+	if (ReadState(nstate, 0, 4*sizeof(unsigned int), buf) == false) return false;
+	unsigned int nhdr[4];
+	memcpy(nhdr, &buf[0], sizeof(nhdr));
+	if ((nhdr[0] != FEBioPlotFile::PLT_STATE) || (nhdr[2] != FEBioPlotFile::PLT_STATE_HEADER)) return false;
+
+	if (ReadState(nstate, 4*sizeof(unsigned int), nhdr[3], buf) == false) return false;
+	ChunkIterator hdr(&buf[0], buf.size());
+	while (hdr.Next())
+	{
+		if (hdr.ID() == FEBioPlotFile::PLT_STATE_HDR_DELTA) ndelta = hdr.Value<int>();
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool PltReader::ReadVariable(int nstate, int nvar, std::vector<DATA>& data)
+{
+	data.clear();
+	if ((nstate < 0) || (nstate >= States())) return false;
+	if ((nvar < 0) || (nvar >= Variables())) return false;
+	const std::vector<unsigned int>& vars = m_state[nstate].vars;
+	if (nvar >= (int)vars.size()) return false;
+
+	// read the state variable chunk
+	std::vector<unsigned char> buf;
+	unsigned int noff = vars[nvar];
+	if (ReadState(nstate, noff, 2*sizeof(unsigned int), buf) == false) return false;
+	unsigned int nhdr[2];
+	memcpy(nhdr, &buf[0], sizeof(nhdr));
+	if (nhdr[0] != FEBioPlotFile::PLT_STATE_VARIABLE) return false;
+	if (ReadState(nstate, noff + 2*sizeof(unsigned int), nhdr[1], buf) == false) return false;
+
+	ChunkIterator var(buf.empty() ? 0 : &buf[0], buf.size());
+	while (var.Next())
+	{
+		if (var.ID() != FEBioPlotFile::PLT_STATE_VAR_DATA) continue;
+
+		ChunkIterator region(var.Data(), var.Size());
+		while (region.Next())
+		{
+			DATA d;
+			d.nid = (int)region.ID();
+			size_t N = region.Size() / sizeof(float);
+			d.a.resize(N);
+			if (N == 0) { data.push_back(d); continue; }
+
+			if (m_ncompress & FEBioPlotFile::PLT_FILTER_SHUFFLE)
+			{
+				// undo the byte shuffle
+				const unsigned char* src = region.Data();
+				unsigned char* dst = (unsigned char*)&d.a[0];
+				for (size_t i = 0; i < N; ++i)
+				{
+					for (size_t k = 0; k < sizeof(float); ++k) dst[i*sizeof(float) + k] = src[k*N + i];
+				}
+			}
+			else memcpy(&d.a[0], region.Data(), N*sizeof(float));
+
+			data.push_back(d);
+		}
+	}
+
+	// undo the delta filter
+	if ((m_ncompress & FEBioPlotFile::PLT_FILTER_DELTA) && (m_var[nvar].region == NODE_DATA) && (nstate > 0))
+	{
+		int ndelta = 0;
+		if (ReadStateDelta(nstate, ndelta) == false) return false;
+		if (ndelta)
+		{
+			std::vector<DATA> prev;
+			if (ReadVariable(nstate - 1, nvar, prev) == false) return false;
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				DATA& di = data[i];
+				for (size_t j = 0; j < prev.size(); ++j)
+				{
+					DATA& pj = prev[j];
+					if ((pj.nid == di.nid) && (pj.a.size() == di.a.size()) && (di.a.empty() == false))
+					{
+						unsigned int* pa = (unsigned int*)&di.a[0];
+						const unsigned int* pp = (const unsigned int*)&pj.a[0];
+						for (size_t k = 0; k < di.a.size(); ++k) pa[k] ^= pp[k];
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,123 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! This class provides random access to the states of a plot file that was 
+//! written with a state index (see FEBioPlotFile::SetStateIndex). The index 
+//! is stored at the end of the file, so the data of a single variable in any 
+//! state can be read without reading the preceding states.
+class PltReader
+{
+public:
+	// region types of the variables
+	enum { NODE_DATA, DOMAIN_DATA, SURFACE_DATA };
+
+	// plot variable info (from the dictionary)
+	struct VARIABLE
+	{
+		std::string		name;
+		int				region;		// one of the region types above
+		unsigned int	ntype;		// data type
+		unsigned int	nfmt;		// storage format
+	};
+
+	// the data of a variable on one region
+	struct DATA
+	{
+		int					nid;	// region ID (0 for node data, one-based domain or surface ID otherwise)
+		std::vector<float>	a;		// the data
+	};
+
+public:
+	PltReader();
+	~PltReader();
+
+	//! Open a plot file. Returns false if the file cannot be read or does not have a state index.
+	//! If bscan is true, the index of a file without one is rebuilt by scanning its states.
+	bool Open(const char* szfile, bool bscan = false);
+
+	//! close the file
+	void Close();
+
+public:
+	//! number of states in the file
+	int States() const { return (int)m_state.size(); }
+
+	//! time of a state
+	float StateTime(int n) const { return m_state[n].time; }
+
+	//! file offset of a state
+	long long StateOffset(int n) const { return m_state[n].offset; }
+
+	//! offsets of the state variables in the uncompressed state
+	const std::vector<unsigned int>& StateVariableOffsets(int n) const { return m_state[n].vars; }
+
+	//! file offset of the index chunk (or the end of the last complete tree of a scanned file)
+	long long IndexOffset() const { return m_index; }
+
+	//! number of plot variables
+	int Variables() const { return (int)m_var.size(); }
+
+	//! get a plot variable
+	const VARIABLE& Variable(int n) const { return m_var[n]; }
+
+	//! find a variable by name (returns -1 if not found)
+	int FindVariable(const char* szname) const;
+
+	//! read the data of a variable in a state
+	bool ReadVariable(int nstate, int nvar, std::vector<DATA>& data);
+
+private:
+	bool ReadRoot();
+	bool ReadIndex();
+	bool ScanStates(long long noff);
+	bool ReadTree(long long noff, std::vector<unsigned char>& buf, long long& nend);
+	bool ReadState(int nstate, unsigned int noff, unsigned int nsize, std::vector<unsigned char>& buf);
+	bool ReadStateDelta(int nstate, int& ndelta);
+
+private:
+	struct STATE
+	{
+		long long					offset;
+		float						time;
+		std::vector<unsigned int>	vars;
+	};
+
+	FILE*					m_fp;
+	int						m_ncompress;	// compression flags
+	long long				m_index;		// file offset of the index
+	std::vector<VARIABLE>	m_var;
+	std::vector<STATE>		m_state;
+};
@@ -33,6 +33,11 @@ SOFTWARE.*/
 #include "FETangentDiagnostic.h"
 #include "FERestartDiagnostics.h"
 #include "FEJFNKTangentDiagnostic.h"
+#include "FEMathBenchmark.h"
+#include "FEContactForceTest.h"
+#include "FEResidualBenchmark.h"
+#include "FEXMLBenchmark.h"
+#include "FESnapshotBenchmark.h"
 
 namespace FEBioTest
 {
@@ -42,5 +47,10 @@ void InitModule()
 	REGISTER_FECORE_CLASS(FEBioDiagnostic, "diagnose");
 	REGISTER_FECORE_CLASS(FERestartDiagnostic, "restart_test");
 	REGISTER_FECORE_CLASS(FEJFNKTangentDiagnostic, "jfnk tangent test");
+	REGISTER_FECORE_CLASS(FEMathBenchmark, "math_benchmark");
+	REGISTER_FECORE_CLASS(FEResidualBenchmark, "residual_benchmark");
+	REGISTER_FECORE_CLASS(FEContactForceTest, "contact_force_test");
+	REGISTER_FECORE_CLASS(FEXMLBenchmark, "xml_benchmark");
+	REGISTER_FECORE_CLASS(FESnapshotBenchmark, "snapshot_benchmark");
 }
 }
@@ -102,6 +102,7 @@ bool FEContactDiagnostic::Run()
 	// build the stiffness matrix
 	K0.Zero();
 	solver.ContactStiffness(LS);
+	LS.FlushDeferred();
 //	solver.StiffnessMatrix();
 
 	print_matrix(K0);
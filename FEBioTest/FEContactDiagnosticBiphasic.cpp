@@ -156,6 +156,7 @@ bool FEContactDiagnosticBiphasic::Run()
     // build the stiffness matrix
     K.Zero();
     solver.ContactStiffness(LS);
+    LS.FlushDeferred();
     
     print_matrix(K0);
     
@@ -0,0 +1,161 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "stdafx.h"
+#include "FEContactForceTest.h"
+#include <FEBioMech/FESolidSolver2.h>
+#include <FEBioMech/FEContactInterface.h>
+#include <FEBioMech/FEResidualVector.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEAnalysis.h>
+#include <FECore/log.h>
+#include <stdlib.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FEContactForceTest::FEContactForceTest(FEModel* fem) : FECoreTask(fem)
+{
+	m_tol = 1e-10;
+	m_nchecks = 0;
+	m_ncontact = 0;
+	m_nfail = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool contact_force_test_cb(FEModel* fem, unsigned int nwhen, void* pd)
+{
+	FEContactForceTest* task = (FEContactForceTest*)pd;
+	return task->Check();
+}
+
+//-----------------------------------------------------------------------------
+bool FEContactForceTest::Init(const char* sz)
+{
+	if (sz && (sz[0] != 0))
+	{
+		double tol = atof(sz);
+		if (tol > 0.0) m_tol = tol;
+	}
+
+	FEModel* fem = GetFEModel();
+	fem->AddCallback(contact_force_test_cb, CB_MAJOR_ITERS, this);
+	return fem->Init();
+}
+
+//-----------------------------------------------------------------------------
+bool FEContactForceTest::Run()
+{
+	FEModel* fem = GetFEModel();
+	bool bret = fem->Solve();
+
+	feLogEx(fem, "Contact force test\n");
+	feLogEx(fem, "\ttime steps checked         : %d\n", m_nchecks);
+	feLogEx(fem, "\ttime steps with contact    : %d\n", m_ncontact);
+	feLogEx(fem, "\ttime steps failed          : %d\n", m_nfail);
+
+	if (m_nchecks == 0)
+	{
+		feLogErrorEx(fem, "The contact force test requires at least one converged time step.");
+		return false;
+	}
+	if (m_ncontact == 0)
+	{
+		feLogErrorEx(fem, "The contact force test did not find any contact forces.");
+		return false;
+	}
+	if (m_nfail > 0)
+	{
+		feLogErrorEx(fem, "The contact forces are not applied in the residual.");
+		return false;
+	}
+
+	feLogEx(fem, "\tresult                     : PASSED\n");
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+bool FEContactForceTest::Check()
+{
+	FEModel* fem = GetFEModel();
+	FESolidSolver2* solver = dynamic_cast<FESolidSolver2*>(fem->GetCurrentStep()->GetFESolver());
+	if (solver == nullptr)
+	{
+		feLogErrorEx(fem, "The contact force test requires a solid, biphasic or multiphasic solver.");
+		return false;
+	}
+
+	// collect the active contact interfaces
+	vector<FEContactInterface*> contact;
+	for (int i = 0; i < fem->SurfacePairConstraints(); ++i)
+	{
+		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem->SurfacePairConstraint(i));
+		if (pci && pci->IsActive()) contact.push_back(pci);
+	}
+	if (contact.empty()) return true;
+
+	int neq = solver->NumberOfEquations();
+
+	// the contact forces on their own
+	vector<double> Fc(neq, 0.0), Fr(solver->m_Fr);
+	FEResidualVector RHS(*fem, Fc, Fr);
+	solver->ContactForces(RHS);
+
+	// the full residual
+	vector<double> R0(neq, 0.0);
+	solver->Residual(R0);
+
+	// the residual without contact
+	// (only the active flag is toggled, since some interfaces do work in Activate)
+	for (size_t i = 0; i < contact.size(); ++i) contact[i]->FEModelComponent::Deactivate();
+	vector<double> R1(neq, 0.0);
+	solver->Residual(R1);
+	for (size_t i = 0; i < contact.size(); ++i) contact[i]->FEModelComponent::Activate();
+
+	// restore the solver's residual data
+	solver->Residual(R0);
+
+	// the difference of the two residuals must be the contact forces
+	double diff = 0.0, norm = 0.0;
+	for (int i = 0; i < neq; ++i)
+	{
+		double d = R0[i] - R1[i] - Fc[i];
+		diff += d*d;
+		norm += Fc[i] * Fc[i];
+	}
+	norm = sqrt(norm);
+	diff = sqrt(diff);
+
+	m_nchecks++;
+	if (norm > 0.0) m_ncontact++;
+	bool bok = (diff <= m_tol*norm);
+	if (!bok) m_nfail++;
+
+	feLogEx(fem, "Contact force test: time = %lg, |Fc| = %lg, |R - R(no contact) - Fc| = %lg %s\n", fem->GetTime().currentTime, norm, diff, (bok ? "" : "(FAILED)"));
+
+	return true;
+}
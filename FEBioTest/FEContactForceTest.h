@@ -0,0 +1,60 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+
+//-----------------------------------------------------------------------------
+// This task checks that the contact forces are applied in the residual of the
+// solid solver and of the solvers derived from it (biphasic, biphasic-solute
+// and multiphasic). After each converged time step, the residual is evaluated 
+// with and without the contact interfaces, and the difference is compared to
+// the contact forces evaluated on their own. The task fails if the contact forces
+// are missing from the residual, or if no contact forces were found at all.
+// The relative tolerance can be passed as the argument of the task.
+class FEContactForceTest : public FECoreTask
+{
+public:
+	// constructor
+	FEContactForceTest(FEModel* fem);
+
+	// initialize the task
+	bool Init(const char* sz) override;
+
+	// run the model and report the result
+	bool Run() override;
+
+public:
+	// do the check (called after each converged time step)
+	bool Check();
+
+private:
+	double	m_tol;		// relative tolerance
+	int		m_nchecks;	// number of time steps that were checked
+	int		m_ncontact;	// number of time steps with nonzero contact forces
+	int		m_nfail;	// number of time steps that failed the check
+};
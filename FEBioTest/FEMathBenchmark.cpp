@@ -0,0 +1,113 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEMathBenchmark.h"
+#include <FECore/MathObject.h>
+#include <FECore/log.h>
+#include <math.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+FEMathBenchmark::FEMathBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_expr = "1 + 2*X^2 - 0.5*Y*Z + sin(3*X)*exp(-Z) + sqrt(1 + t)*cos(Y/4)";
+	m_neval = 10000000;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMathBenchmark::Init(const char* sz)
+{
+	if (sz && (sz[0] != 0)) m_expr = sz;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMathBenchmark::Run()
+{
+	FEModel* fem = GetFEModel();
+
+	MSimpleExpression math;
+	math.AddVariable("X");
+	math.AddVariable("Y");
+	math.AddVariable("Z");
+	math.AddVariable("t");
+	if (math.Create(m_expr) == false)
+	{
+		feLogErrorEx(fem, "Failed to create math expression: %s", m_expr.c_str());
+		return false;
+	}
+
+	feLogEx(fem, "Math expression benchmark\n");
+	feLogEx(fem, "\texpression: %s\n", m_expr.c_str());
+	feLogEx(fem, "\tevaluations: %d\n", m_neval);
+
+	// the variable values are generated on the fly so that the compiler
+	// cannot hoist the evaluations out of the loops
+	std::vector<double> var(4);
+	const double h = 1.0 / m_neval;
+
+	// NOTE: The FECore Timer only has a resolution of one second on some systems, 
+	// so we use a high resolution clock here.
+	typedef std::chrono::high_resolution_clock Clock;
+
+	// evaluate the expression tree
+	Clock::time_point t0 = Clock::now();
+	double sumTree = 0.0;
+	for (int i = 0; i < m_neval; ++i)
+	{
+		double s = i*h;
+		math.Variable(0)->value(s);
+		math.Variable(1)->value(1.0 - s);
+		math.Variable(2)->value(2.0*s);
+		math.Variable(3)->value(0.5);
+		sumTree += math.value();
+	}
+	Clock::time_point t1 = Clock::now();
+
+	// evaluate the compiled expression
+	double sumProg = 0.0;
+	for (int i = 0; i < m_neval; ++i)
+	{
+		double s = i*h;
+		var[0] = s;
+		var[1] = 1.0 - s;
+		var[2] = 2.0*s;
+		var[3] = 0.5;
+		sumProg += math.value_s(var);
+	}
+	Clock::time_point t2 = Clock::now();
+
+	double ttree = std::chrono::duration<double>(t1 - t0).count();
+	double tprog = std::chrono::duration<double>(t2 - t1).count();
+	feLogEx(fem, "\ttree interpreter    : %lg sec\n", ttree);
+	feLogEx(fem, "\tcompiled expression : %lg sec\n", tprog);
+	if (tprog > 0.0) feLogEx(fem, "\tspeedup             : %lg\n", ttree / tprog);
+	feLogEx(fem, "\tdifference          : %lg\n", fabs(sumTree - sumProg));
+
+	return true;
+}
@@ -0,0 +1,53 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// This task times the evaluation of a math expression, using the expression 
+// tree interpreter and the compiled expression. It is used to benchmark the 
+// evaluation of math parameters (FEMathValue). 
+// The expression can be passed as the argument of the task. It can use 
+// the variables X, Y, Z, and t.
+class FEMathBenchmark : public FECoreTask
+{
+public:
+	// constructor
+	FEMathBenchmark(FEModel* fem);
+
+	// initialize the task
+	bool Init(const char* sz) override;
+
+	// run the benchmark
+	bool Run() override;
+
+private:
+	std::string	m_expr;		// expression to evaluate
+	int			m_neval;	// number of evaluations
+};
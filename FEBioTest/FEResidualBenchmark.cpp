@@ -0,0 +1,142 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEResidualBenchmark.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEAnalysis.h>
+#include <FECore/FENewtonSolver.h>
+#include <FECore/FEMesh.h>
+#include <FECore/FEDomain.h>
+#include <FECore/log.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+FEResidualBenchmark::FEResidualBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_neval = 20;
+	m_bdone = false;
+}
+
+//-----------------------------------------------------------------------------
+bool residual_benchmark_cb(FEModel* fem, unsigned int nwhen, void* pd)
+{
+	FEResidualBenchmark* task = (FEResidualBenchmark*)pd;
+	task->Benchmark();
+
+	// stop the analysis
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEResidualBenchmark::Init(const char* sz)
+{
+	if (sz && (sz[0] != 0))
+	{
+		int n = atoi(sz);
+		if (n > 0) m_neval = n;
+	}
+
+	FEModel* fem = GetFEModel();
+	fem->AddCallback(residual_benchmark_cb, CB_MAJOR_ITERS, this);
+
+	return fem->Init();
+}
+
+//-----------------------------------------------------------------------------
+bool FEResidualBenchmark::Run()
+{
+	FEModel* fem = GetFEModel();
+	fem->Solve();
+	if (m_bdone == false)
+	{
+		feLogErrorEx(fem, "The residual benchmark requires at least one converged time step.");
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// evaluate the residual neval times and return the average time
+static double time_residual(FENewtonSolver* solver, vector<double>& R, int neval)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+
+	// do one evaluation first, so that we don't time any lazy initialization
+	solver->Residual(R);
+
+	Clock::time_point t0 = Clock::now();
+	for (int i = 0; i < neval; ++i) solver->Residual(R);
+	Clock::time_point t1 = Clock::now();
+
+	return std::chrono::duration<double>(t1 - t0).count() / neval;
+}
+
+//-----------------------------------------------------------------------------
+bool FEResidualBenchmark::Benchmark()
+{
+	FEModel* fem = GetFEModel();
+	m_bdone = true;
+
+	FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(fem->GetCurrentStep()->GetFESolver());
+	if (solver == nullptr)
+	{
+		feLogErrorEx(fem, "The residual benchmark requires a Newton solver.");
+		return false;
+	}
+
+	int neq = solver->NumberOfEquations();
+	vector<double> R0(neq, 0.0), R1(neq, 0.0);
+
+	// time the residual with the cached material point data
+	double t0 = time_residual(solver, R0, m_neval);
+
+	// clear the caches, and time again
+	FEMesh& mesh = fem->GetMesh();
+	for (int i = 0; i < mesh.Domains(); ++i) mesh.Domain(i).ClearMaterialPointCache();
+	double t1 = time_residual(solver, R1, m_neval);
+
+	// make sure we got the same answer
+	double diff = 0.0, norm = 0.0;
+	for (int i = 0; i < neq; ++i)
+	{
+		diff += (R1[i] - R0[i])*(R1[i] - R0[i]);
+		norm += R0[i] * R0[i];
+	}
+
+	feLogEx(fem, "Residual benchmark\n");
+	feLogEx(fem, "\tequations   : %d\n", neq);
+	feLogEx(fem, "\tevaluations : %d\n", m_neval);
+	feLogEx(fem, "\tcached material point data : %lg sec\n", t0);
+	feLogEx(fem, "\tExtractData                : %lg sec\n", t1);
+	if (t0 > 0.0) feLogEx(fem, "\tspeedup                    : %lg\n", t1 / t0);
+	feLogEx(fem, "\trelative difference        : %lg\n", (norm > 0.0 ? sqrt(diff / norm) : sqrt(diff)));
+
+	return true;
+}
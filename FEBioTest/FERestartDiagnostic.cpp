@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include <FECore/FEAnalysis.h>
 #include <FECore/DumpFile.h>
 #include <FECore/log.h>
+#include <FECore/Timer.h>
 
 //-----------------------------------------------------------------------------
 FERestartDiagnostic::FERestartDiagnostic(FEModel*pfem) : FECoreTask(pfem), m_dmp(*pfem)
@@ -64,8 +65,14 @@ bool restart_test_cb(FEModel* pfem, unsigned int nwen, void* pd)
 	}
 	else
 	{
+		// time the serialization, since this is the same path that is used
+		// to store the model state before each time step when retries are enabled.
+		Timer t;
+		t.start();
 		ptask->m_dmp.Open(true, false);
 		pfem->Serialize(ptask->m_dmp);
+		t.stop();
+		feLogEx(pfem, "Serialization time: %lg sec (%lu bytes)\n", t.GetTime(), (unsigned long)ptask->m_dmp.size());
 	}
 
 	// set the ok flag to tell the diagnostic that the restart 
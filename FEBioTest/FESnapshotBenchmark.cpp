@@ -0,0 +1,107 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FESnapshotBenchmark.h"
+#include <FECore/FEModel.h>
+#include <FECore/log.h>
+#include <stdlib.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+FESnapshotBenchmark::FESnapshotBenchmark(FEModel* fem) : FECoreTask(fem), m_dmp(*fem)
+{
+	m_neval = 10;
+	m_nsteps = 0;
+	m_ttotal = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+bool snapshot_benchmark_cb(FEModel* fem, unsigned int nwhen, void* pd)
+{
+	FESnapshotBenchmark* task = (FESnapshotBenchmark*)pd;
+	task->Benchmark();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FESnapshotBenchmark::Init(const char* sz)
+{
+	if (sz && (sz[0] != 0))
+	{
+		int n = atoi(sz);
+		if (n > 0) m_neval = n;
+	}
+
+	FEModel* fem = GetFEModel();
+	fem->AddCallback(snapshot_benchmark_cb, CB_MAJOR_ITERS, this);
+
+	return fem->Init();
+}
+
+//-----------------------------------------------------------------------------
+bool FESnapshotBenchmark::Run()
+{
+	FEModel* fem = GetFEModel();
+	bool bret = fem->Solve();
+
+	if (m_nsteps == 0)
+	{
+		feLogErrorEx(fem, "The snapshot benchmark requires at least one converged time step.");
+		return false;
+	}
+
+	feLogEx(fem, "Snapshot benchmark\n");
+	feLogEx(fem, "\ttime steps             : %d\n", m_nsteps);
+	feLogEx(fem, "\tsnapshots per step     : %d\n", m_neval);
+	feLogEx(fem, "\taverage snapshot time  : %lg sec\n", m_ttotal / m_nsteps);
+	feLogEx(fem, "\tsnapshot size          : %lu bytes\n", (unsigned long)m_dmp.size());
+
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+void FESnapshotBenchmark::Benchmark()
+{
+	typedef std::chrono::high_resolution_clock Clock;
+	FEModel* fem = GetFEModel();
+
+	// take the snapshots the same way as FEAnalysis does before each time step
+	Clock::time_point t0 = Clock::now();
+	for (int i = 0; i < m_neval; ++i)
+	{
+		m_dmp.Open(true, true);
+		fem->Serialize(m_dmp);
+	}
+	Clock::time_point t1 = Clock::now();
+
+	double t = std::chrono::duration<double>(t1 - t0).count() / m_neval;
+	m_ttotal += t;
+	m_nsteps++;
+
+	feLogEx(fem, "Snapshot time: %lg sec (%lu bytes)\n", t, (unsigned long)m_dmp.size());
+}
@@ -0,0 +1,60 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <FECore/DumpMemStream.h>
+
+//-----------------------------------------------------------------------------
+// This task times the snapshot of the model state that the analysis takes before
+// each time step when retries are enabled. After each converged time step, the model 
+// is serialized into a memory stream a number of times, and the average time and 
+// the size of the snapshot are reported. At the end, the average over all time steps 
+// is reported as well. The number of snapshots per time step can be passed as the 
+// argument of the task.
+class FESnapshotBenchmark : public FECoreTask
+{
+public:
+	// constructor
+	FESnapshotBenchmark(FEModel* fem);
+
+	// initialize the task
+	bool Init(const char* sz) override;
+
+	// run the model and report the result
+	bool Run() override;
+
+public:
+	// do the timings (called after each converged time step)
+	void Benchmark();
+
+private:
+	DumpMemStream	m_dmp;		// the stream that stores the snapshot
+	int				m_neval;	// number of snapshots per time step
+	int				m_nsteps;	// number of time steps that were timed
+	double			m_ttotal;	// total of the average snapshot times
+};
@@ -0,0 +1,169 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEXMLBenchmark.h"
+#include <FEBioXML/XMLReader.h>
+#include <FEBioLib/FEBioModel.h>
+#include <FECore/log.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+FEXMLBenchmark::FEXMLBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_npass = 3;
+}
+
+//-----------------------------------------------------------------------------
+bool FEXMLBenchmark::Init(const char* sz)
+{
+	if (sz && (sz[0] != 0)) m_file = sz;
+	else
+	{
+		FEBioModel* fem = dynamic_cast<FEBioModel*>(GetFEModel());
+		if (fem) m_file = fem->GetInputFileName();
+	}
+	return (m_file.empty() == false);
+}
+
+//-----------------------------------------------------------------------------
+// The different ways the tag values are processed
+enum XMLValueMode
+{
+	XML_SKIP_VALUES,	// only read the tags
+	XML_TAG_VALUES,		// parse values with XMLTag::value
+	XML_ATOF_VALUES		// parse values with atof
+};
+
+//-----------------------------------------------------------------------------
+// Read all the tags of the file. Returns the time (in seconds), or a negative 
+// number if the file could not be read.
+static double read_xml(const char* szfile, XMLValueMode mode, int& ntags, int& nvals, double& sum)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+	Clock::time_point t0 = Clock::now();
+
+	XMLReader xml;
+	if (xml.Open(szfile) == false) return -1.0;
+
+	XMLTag tag;
+	if (xml.FindTag("febio_spec", tag) == false) return -1.0;
+
+	const int MAX_VALS = 64;
+	double v[MAX_VALS];
+	ntags = nvals = 0;
+	sum = 0.0;
+	try {
+		++tag;
+		while ((tag.isend() == false) || (tag != "febio_spec"))
+		{
+			if ((tag.isend() == false) && tag.isleaf() && (tag.isempty() == false))
+			{
+				ntags++;
+				if (mode == XML_TAG_VALUES)
+				{
+					int n = tag.value(v, MAX_VALS);
+					for (int i = 0; i < n; ++i) sum += v[i];
+					nvals += n;
+				}
+				else if (mode == XML_ATOF_VALUES)
+				{
+					const char* sz = tag.szvalue();
+					for (int i = 0; i < MAX_VALS; ++i)
+					{
+						sum += atof(sz);
+						nvals++;
+
+						const char* sze = strchr(sz, ',');
+						if (sze) sz = sze + 1;
+						else break;
+					}
+				}
+			}
+			++tag;
+		}
+	}
+	catch (...)
+	{
+		return -1.0;
+	}
+	xml.Close();
+
+	Clock::time_point t1 = Clock::now();
+	return std::chrono::duration<double>(t1 - t0).count();
+}
+
+//-----------------------------------------------------------------------------
+bool FEXMLBenchmark::Run()
+{
+	FEModel* fem = GetFEModel();
+	const char* szfile = m_file.c_str();
+
+	// get the file size
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == nullptr)
+	{
+		feLogErrorEx(fem, "Failed to open file %s", szfile);
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	double mb = (double)ftell(fp) / (1024.0*1024.0);
+	fclose(fp);
+
+	feLogEx(fem, "XML reader benchmark\n");
+	feLogEx(fem, "\tfile   : %s\n", szfile);
+	feLogEx(fem, "\tsize   : %lg MB\n", mb);
+	feLogEx(fem, "\tpasses : %d\n", m_npass);
+
+	const char* szmode[] = { "tags only      ", "XMLTag::value  ", "atof           " };
+	double sum[3] = { 0 };
+	for (int mode = XML_SKIP_VALUES; mode <= XML_ATOF_VALUES; ++mode)
+	{
+		// we take the best time of all passes
+		double tmin = -1.0;
+		int ntags = 0, nvals = 0;
+		for (int i = 0; i < m_npass; ++i)
+		{
+			double t = read_xml(szfile, (XMLValueMode)mode, ntags, nvals, sum[mode]);
+			if (t < 0.0)
+			{
+				feLogErrorEx(fem, "Failed to read file %s", szfile);
+				return false;
+			}
+			if ((tmin < 0.0) || (t < tmin)) tmin = t;
+		}
+
+		feLogEx(fem, "\t%s: %lg sec (%lg MB/s", szmode[mode], tmin, (tmin > 0.0 ? mb / tmin : 0.0));
+		if (mode != XML_SKIP_VALUES) feLogEx(fem, ", %d values in %d tags", nvals, ntags);
+		feLogEx(fem, ")\n");
+	}
+	feLogEx(fem, "\tdifference     : %lg\n", fabs(sum[XML_TAG_VALUES] - sum[XML_ATOF_VALUES]));
+
+	return true;
+}
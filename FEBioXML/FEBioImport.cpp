@@ -265,6 +265,9 @@ bool FEBioImport::Load(FEModel& fem, const char* szfile)
 	m_szplot_type[0] = 0;
 	m_plot.clear();
 	m_nplot_compression = 0;
+	m_bplot_delta = false;
+	m_bplot_shuffle = false;
+	m_bplot_index = false;
 
 	m_data.clear();
 
@@ -479,6 +482,19 @@ void FEBioImport::SetPlotCompression(int n)
 	m_nplot_compression = n;
 }
 
+//-----------------------------------------------------------------------------
+void FEBioImport::SetPlotFilters(bool bdelta, bool bshuffle)
+{
+	m_bplot_delta = bdelta;
+	m_bplot_shuffle = bshuffle;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioImport::SetPlotStateIndex(bool b)
+{
+	m_bplot_index = b;
+}
+
 //-----------------------------------------------------------------------------
 // This tag parses a node set.
 FENodeSet* FEBioImport::ParseNodeSet(XMLTag& tag, const char* szatt)
@@ -174,6 +174,10 @@ public:
     void AddPlotVariable(const char* szvar, vector<int>& item, const char* szdom = "");
 
 	void SetPlotCompression(int n);
+
+	void SetPlotFilters(bool bdelta, bool bshuffle);
+
+	void SetPlotStateIndex(bool b);
     
 	void AddDataRecord(DataRecord* pd);
 
@@ -196,6 +200,9 @@ public:
 	char					m_szplot_type[256];
 	vector<PlotVariable>	m_plot;
 	int						m_nplot_compression;
+	bool					m_bplot_delta;		// apply the delta filter before compression
+	bool					m_bplot_shuffle;	// apply the shuffle filter before compression
+	bool					m_bplot_index;
 
 	vector<DataRecord*>		m_data;
 };
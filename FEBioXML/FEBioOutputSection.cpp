@@ -353,7 +353,32 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 			{
 				int ncomp;
 				tag.value(ncomp);
+
+				// optional filters that are applied before compression
+				bool bdelta = false, bshuffle = false;
+				const char* szfilter = tag.AttributeValue("filter", true);
+				if (szfilter)
+				{
+					char szbuf[256] = { 0 };
+					strncpy(szbuf, szfilter, 255);
+					char* sz = strtok(szbuf, ", ");
+					while (sz)
+					{
+						if      (strcmp(sz, "delta"  ) == 0) bdelta = true;
+						else if (strcmp(sz, "shuffle") == 0) bshuffle = true;
+						else throw XMLReader::InvalidAttributeValue(tag, "filter", szfilter);
+						sz = strtok(0, ", ");
+					}
+				}
+
 				GetFEBioImport()->SetPlotCompression(ncomp);
+				GetFEBioImport()->SetPlotFilters(bdelta, bshuffle);
+			}
+			else if (tag=="state_index")
+			{
+				bool b;
+				tag.value(b);
+				GetFEBioImport()->SetPlotStateIndex(b);
 			}
 			++tag;
 		}
@@ -85,50 +85,43 @@ FEModelBuilder* FEFileSection::GetBuilder() { return m_pim->GetBuilder(); }
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, int& n)
 {
-	n = atoi(tag.szvalue());
+	tag.value(n);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, double& g)
 {
-	g = atof(tag.szvalue());
+	tag.value(g);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, bool& b)
 {
-	const char* sz = tag.szvalue();
-	int n = 0;
-	sscanf(sz, "%d", &n);
-	b = (n != 0);
+	tag.value(b);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, vec3d& v)
 {
-	const char* sz = tag.szvalue();
-	int n = sscanf(sz, "%lg,%lg,%lg", &v.x, &v.y, &v.z);
-	if (n != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	double d[3];
+	if (tag.valueList(d, 3) == false) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	v = vec3d(d[0], d[1], d[2]);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, mat3d& m)
 {
-	const char* sz = tag.szvalue();
-	double xx, xy, xz, yx, yy, yz, zx, zy, zz;
-	int n = sscanf(sz, "%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg", &xx, &xy, &xz, &yx, &yy, &yz, &zx, &zy, &zz);
-	if (n != 9) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
-	m = mat3d(xx, xy, xz, yx, yy, yz, zx, zy, zz);
+	double d[9];
+	if (tag.valueList(d, 9) == false) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	m = mat3d(d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7], d[8]);
 }
 
 //-----------------------------------------------------------------------------
 void FEFileSection::value(XMLTag& tag, mat3ds& m)
 {
-	const char* sz = tag.szvalue();
-	double x, y, z, xy, yz, xz;
-	int n = sscanf(sz, "%lg,%lg,%lg,%lg,%lg,%lg", &x, &y, &z, &xy, &yz, &xz);
-	if (n != 6) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
-	m = mat3ds(x, y, z, xy, yz, xz);
+	double d[6];
+	if (tag.valueList(d, 6) == false) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+	m = mat3ds(d[0], d[1], d[2], d[3], d[4], d[5]);
 }
 
 //-----------------------------------------------------------------------------
@@ -175,37 +168,13 @@ void FEFileSection::value(XMLTag& tag, std::vector<int>& v)
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, int* pi, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i<n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pi[i] = atoi(sz);
-nr++;
-
-if (sze) sz = sze + 1;
-else break;
-	}
-	return nr;
+	return tag.value(pi, n);
 }
 
 //-----------------------------------------------------------------------------
 int FEFileSection::value(XMLTag& tag, double* pf, int n)
 {
-	const char* sz = tag.szvalue();
-	int nr = 0;
-	for (int i = 0; i < n; ++i)
-	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
-		nr++;
-
-		if (sze) sz = sze + 1;
-		else break;
-	}
-	return nr;
+	return tag.value(pf, n);
 }
 
 //-----------------------------------------------------------------------------
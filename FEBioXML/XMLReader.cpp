@@ -30,6 +30,165 @@ SOFTWARE.*/
 #include "XMLReader.h"
 #include <assert.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <locale.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//=============================================================================
+// Numeric parsing
+//=============================================================================
+// The following functions replace atof and atoi for reading tag values. They
+// work on a character range, so that the values can be read directly from the 
+// file buffer, and they do not depend on the locale. Like atof and atoi, leading
+// whitespace is skipped and parsing stops at the first character that cannot 
+// be part of the number.
+
+//-----------------------------------------------------------------------------
+static const double xml_pow10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+//-----------------------------------------------------------------------------
+// strtod with the "C" locale, so that the decimal point is always a '.'
+#ifdef WIN32
+static double xml_strtod(const char* sz, char** end)
+{
+	static _locale_t c_locale = _create_locale(LC_NUMERIC, "C");
+	return _strtod_l(sz, end, c_locale);
+}
+#else
+static double xml_strtod(const char* sz, char** end)
+{
+	static locale_t c_locale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+	return strtod_l(sz, end, c_locale);
+}
+#endif
+
+inline bool xml_isdigit(char c) { return ((c >= '0') && (c <= '9')); }
+inline bool xml_isspace(char c) { return ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\v') || (c == '\f')); }
+
+//-----------------------------------------------------------------------------
+// Read a floating point number from the range [sz, se). Returns the position 
+// after the number. Numbers with at most 19 significant digits whose mantissa 
+// and power of ten are exactly representable are converted with a single 
+// multiplication or division, which gives the correctly rounded result. All 
+// other numbers (and special values like inf or hex floats) are passed to strtod
+// with the "C" locale.
+// NOTE: The range must be followed by a character that cannot be part of a
+// number, (e.g. '<', or the terminating zero) since strtod is not bounded by se.
+static const char* xml_parse_double(const char* sz, const char* se, double& val)
+{
+	const char* s = sz;
+	while ((s < se) && xml_isspace(*s)) ++s;
+	const char* s0 = s;
+
+	bool neg = false;
+	if ((s < se) && ((*s == '-') || (*s == '+'))) { neg = (*s == '-'); ++s; }
+
+	uint64_t m = 0;
+	int nd = 0;		// number of significant digits
+	int e10 = 0;	// decimal exponent
+	bool bdigits = false;
+	bool bexact = true;
+
+	// integer part
+	while ((s < se) && xml_isdigit(*s))
+	{
+		bdigits = true;
+		if (nd < 19) { m = m*10 + (*s - '0'); if (m) nd++; }
+		else { e10++; if (*s != '0') bexact = false; }
+		++s;
+	}
+
+	// fractional part
+	if ((s < se) && (*s == '.'))
+	{
+		++s;
+		while ((s < se) && xml_isdigit(*s))
+		{
+			bdigits = true;
+			if (nd < 19) { m = m*10 + (*s - '0'); if (m) nd++; e10--; }
+			else if (*s != '0') bexact = false;
+			++s;
+		}
+	}
+
+	// exponent
+	if (bdigits && (s < se) && ((*s == 'e') || (*s == 'E')))
+	{
+		const char* t = s + 1;
+		bool eneg = false;
+		if ((t < se) && ((*t == '-') || (*t == '+'))) { eneg = (*t == '-'); ++t; }
+		if ((t < se) && xml_isdigit(*t))
+		{
+			int e = 0;
+			while ((t < se) && xml_isdigit(*t))
+			{
+				if (e < 10000) e = e*10 + (*t - '0');
+				++t;
+			}
+			e10 += (eneg ? -e : e);
+			s = t;
+		}
+	}
+
+	// see if we can do the conversion ourselves
+	if (bdigits && bexact && ((s >= se) || !isalpha((unsigned char)*s)))
+	{
+		const uint64_t maxExact = ((uint64_t)1 << 53);
+		if (m == 0)
+		{
+			val = (neg ? -0.0 : 0.0);
+			return s;
+		}
+		else if ((m <= maxExact) && (e10 >= -22) && (e10 <= 22))
+		{
+			double d = (double)m;
+			if (e10 < 0) d /= xml_pow10[-e10]; else d *= xml_pow10[e10];
+			val = (neg ? -d : d);
+			return s;
+		}
+	}
+
+	// let strtod handle this
+	char* end = 0;
+	val = xml_strtod(s0, &end);
+	return (end == s0 ? sz : end);
+}
+
+//-----------------------------------------------------------------------------
+// Read an integer from the range [sz, se). Returns the position after the 
+// number, or sz if no number was found (in which case val is set to zero).
+static const char* xml_parse_int(const char* sz, const char* se, int& val)
+{
+	const char* s = sz;
+	while ((s < se) && xml_isspace(*s)) ++s;
+
+	bool neg = false;
+	if ((s < se) && ((*s == '-') || (*s == '+'))) { neg = (*s == '-'); ++s; }
+
+	if ((s >= se) || !xml_isdigit(*s)) { val = 0; return sz; }
+
+	int64_t n = 0;
+	while ((s < se) && xml_isdigit(*s))
+	{
+		if (n < 1000000000000LL) n = n*10 + (*s - '0');
+		++s;
+	}
+	val = (int)(neg ? -n : n);
+	return s;
+}
 
 //=============================================================================
 // XMLAtt
@@ -61,6 +220,7 @@ XMLTag::XMLTag()
 {
 	m_preader = 0;
 	m_bend = false;
+	m_pval = m_pend = 0;
 
 	m_sztag[0] = 0;
 	m_nlevel = 0;
@@ -75,48 +235,132 @@ void XMLTag::clear()
 {
 	m_sztag[0] = 0;
 	m_szval.clear();
+	m_pval = m_pend = 0;
 	m_natt = 0;
 	m_bend = false;
 	m_bleaf = true;
 	m_bempty = false;
 }
 
+//-----------------------------------------------------------------------------
+//! Get the tag's value as a zero-terminated string. 
+const char* XMLTag::szvalue()
+{
+	// copy the value out of the reader's buffer
+	if (m_pval)
+	{
+		m_szval.assign(m_pval, m_pend);
+		m_pval = m_pend = 0;
+	}
+	return m_szval.c_str();
+}
+
+//-----------------------------------------------------------------------------
+//! Get the range of characters of the tag's value. Note that this range is not
+//! zero-terminated when it points into the reader's buffer.
+void XMLTag::valueRange(const char*& sz, const char*& se)
+{
+	if (m_pval) { sz = m_pval; se = m_pend; }
+	else { sz = m_szval.c_str(); se = sz + m_szval.size(); }
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(double& val)
+{
+	const char *sz, *se; valueRange(sz, se);
+	xml_parse_double(sz, se, val);
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(float& val)
+{
+	const char *sz, *se; valueRange(sz, se);
+	double d; xml_parse_double(sz, se, d);
+	val = (float) d;
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(int& val)
+{
+	const char *sz, *se; valueRange(sz, se);
+	xml_parse_int(sz, se, val);
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(long& val)
+{
+	const char *sz, *se; valueRange(sz, se);
+	int n; xml_parse_int(sz, se, n);
+	val = (long) n;
+}
+
+//-----------------------------------------------------------------------------
+void XMLTag::value(short& val)
+{
+	const char *sz, *se; valueRange(sz, se);
+	int n; xml_parse_int(sz, se, n);
+	val = (short) n;
+}
+
 //-----------------------------------------------------------------------------
 //! This function reads in a comma delimited list of doubles. The function reads
 //! in a maximum of n values. The actual number of values that are read is returned.
 //!
 int XMLTag::value(double* pf, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se; valueRange(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = atof(sz);
+		const char* sn = xml_parse_double(sz, se, pf[i]);
 		nr++;
 
+		const char* sze = (const char*) memchr(sn, ',', se - sn);
 		if (sze) sz = sze+1;
 		else break;
 	}
 	return nr;
 }
 
+//-----------------------------------------------------------------------------
+//! This function reads a comma delimited list of exactly n doubles. Unlike value,
+//! it returns false when the list has fewer than n fields, or when a field is 
+//! not a number (which value would read as zero).
+bool XMLTag::valueList(double* pf, int n)
+{
+	const char *sz, *se; valueRange(sz, se);
+	for (int i=0; i<n; ++i)
+	{
+		const char* sn = xml_parse_double(sz, se, pf[i]);
+		if (sn == sz) return false;
+
+		if (i < n - 1)
+		{
+			// the number must be followed by a comma
+			while ((sn < se) && xml_isspace(*sn)) ++sn;
+			if ((sn >= se) || (*sn != ',')) return false;
+			sz = sn + 1;
+		}
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! This function reads in a comma delimited list of floats. The function reads
 //! in a maximum of n values. The actual number of values that are read is returned.
 //!
 int XMLTag::value(float* pf, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se; valueRange(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
-
-		pf[i] = (float) atof(sz);
+		double d;
+		const char* sn = xml_parse_double(sz, se, d);
+		pf[i] = (float) d;
 		nr++;
 
+		const char* sze = (const char*) memchr(sn, ',', se - sn);
 		if (sze) sz = sze+1;
 		else break;
 	}
@@ -129,15 +373,14 @@ int XMLTag::value(float* pf, int n)
 //!
 int XMLTag::value(int* pi, int n)
 {
-	const char* sz = m_szval.c_str();
+	const char *sz, *se; valueRange(sz, se);
 	int nr = 0;
 	for (int i=0; i<n; ++i)
 	{
-		const char* sze = strchr(sz, ',');
-
-		pi[i] = atoi(sz);
+		const char* sn = xml_parse_int(sz, se, pi[i]);
 		nr++;
 
+		const char* sze = (const char*) memchr(sn, ',', se - sn);
 		if (sze) sz = sze+1;
 		else break;
 	}
@@ -151,7 +394,7 @@ int XMLTag::value(std::vector<string>& stringList, int n)
 
 	char tmp[256] = { 0 };
 
-	const char* sz = m_szval.c_str();
+	const char* sz = szvalue();
 	int nr = 0;
 	for (int i = 0; i<n; ++i)
 	{
@@ -176,28 +419,30 @@ int XMLTag::value(std::vector<string>& stringList, int n)
 //-----------------------------------------------------------------------------
 void XMLTag::value(bool& val)
 { 
+	const char *sz, *se; valueRange(sz, se);
 	int n=0; 
-	sscanf(m_szval.c_str(), "%d", &n); 
+	xml_parse_int(sz, se, n);
 	val = (n != 0); 
 }
 
 //-----------------------------------------------------------------------------
 void XMLTag::value(char* szstr)
 {
-	strcpy(szstr, m_szval.c_str()); 
+	strcpy(szstr, szvalue()); 
 }
 
 //-----------------------------------------------------------------------------
 void XMLTag::value(std::string& val)
 {
-	val = m_szval;
+	const char *sz, *se; valueRange(sz, se);
+	val.assign(sz, se);
 }
 
 //-----------------------------------------------------------------------------
 void XMLTag::value(vector<int>& l)
 {
 	int i, n = 0, n0, n1, nn;
-	char* szval = strdup(m_szval.c_str());
+	char* szval = strdup(szvalue());
 	char* ch;
 	char* sz = szval;
 	int nread;
@@ -333,7 +578,7 @@ bool XMLTag::AttributeValue(const char* szat, double& d, bool bopt)
 	const char* szv = AttributeValue(szat, bopt);
 	if (szv == 0) return false;
 
-	d = atof(szv);
+	xml_parse_double(szv, szv + strlen(szv), d);
 
 	return true;
 }
@@ -344,7 +589,7 @@ bool XMLTag::AttributeValue(const char* szat, int& n, bool bopt)
 	const char* szv = AttributeValue(szat, bopt);
 	if (szv == 0) return false;
 
-	n = atoi(szv);
+	xml_parse_int(szv, szv + strlen(szv), n);
 
 	return true;
 }
@@ -407,11 +652,14 @@ XMLReader::Error(tag, format_string("missing attribute \"%s\"", sza)) {}
 //-----------------------------------------------------------------------------
 XMLReader::XMLReader()
 {
-	m_fp = 0;
+	m_data = 0;
+	m_size = 0;
+	m_bmapped = false;
+#ifdef WIN32
+	m_hfile = INVALID_HANDLE_VALUE;
+	m_hmap = 0;
+#endif
 	m_nline = 0;
-	m_bufIndex = 0;
-	m_bufSize = 0;
-	m_eof = false;
 	m_currentPos = 0;
 }
 
@@ -424,16 +672,30 @@ XMLReader::~XMLReader()
 //-----------------------------------------------------------------------------
 void XMLReader::Close()
 {
-	if (m_fp)
+	if (m_data)
 	{
-		fclose(m_fp);
+		if (m_bmapped)
+		{
+#ifdef WIN32
+			UnmapViewOfFile(m_data);
+#else
+			munmap((void*)m_data, (size_t)m_size);
+#endif
+		}
+		else delete [] m_data;
 	}
 
-	m_fp = 0;
+#ifdef WIN32
+	if (m_hmap) CloseHandle((HANDLE)m_hmap);
+	if (m_hfile != INVALID_HANDLE_VALUE) CloseHandle((HANDLE)m_hfile);
+	m_hfile = INVALID_HANDLE_VALUE;
+	m_hmap = 0;
+#endif
+
+	m_data = 0;
+	m_size = 0;
+	m_bmapped = false;
 	m_nline = 0;
-	m_bufIndex = 0;
-	m_bufSize = 0;
-	m_eof = false;
 	m_currentPos = 0;
 }
 
@@ -441,20 +703,16 @@ void XMLReader::Close()
 bool XMLReader::Open(const char* szfile)
 {
 	// make sure this reader has not been attached to a file yet
-	if (m_fp != 0) return false;
+	if (m_data != 0) return false;
 
-	// open the file
-	m_fp = fopen(szfile, "rb");
-	if (m_fp == 0) return false;
+	// get the file's content
+	if (MapFile(szfile) == false) return false;
 
-	// read the first line
-	char szline[256] = {0};
-	fgets(szline, 255, m_fp);
-
-	// make sure it is correct
-	if (strncmp(szline,"<?xml", 5) != 0)
+	// make sure it is an xml file
+	if ((m_size < 5) || (strncmp(m_data, "<?xml", 5) != 0))
 	{
 		// This file is not an XML file
+		Close();
 		return false;
 	}
 
@@ -464,6 +722,80 @@ bool XMLReader::Open(const char* szfile)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// The whole file is mapped into memory so that the tags can be read without any
+// buffering and the tag values can be referenced directly. If the file cannot 
+// be mapped, it is read into memory instead.
+bool XMLReader::MapFile(const char* szfile)
+{
+#ifdef WIN32
+	HANDLE hfile = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hfile == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if ((GetFileSizeEx(hfile, &size) == FALSE) || (size.QuadPart == 0))
+	{
+		CloseHandle(hfile);
+		return false;
+	}
+	m_size = (int64_t)size.QuadPart;
+
+	HANDLE hmap = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hmap)
+	{
+		m_data = (const char*)MapViewOfFile(hmap, FILE_MAP_READ, 0, 0, 0);
+		if (m_data)
+		{
+			m_hfile = hfile;
+			m_hmap = hmap;
+			m_bmapped = true;
+			return true;
+		}
+		CloseHandle(hmap);
+	}
+	CloseHandle(hfile);
+#else
+	int fd = open(szfile, O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size == 0))
+	{
+		close(fd);
+		return false;
+	}
+	m_size = (int64_t)st.st_size;
+
+	void* pd = mmap(0, (size_t)m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pd != MAP_FAILED)
+	{
+		madvise(pd, (size_t)m_size, MADV_SEQUENTIAL);
+		m_data = (const char*)pd;
+		m_bmapped = true;
+		return true;
+	}
+#endif
+
+	// we could not map the file, so read it instead
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == 0) { m_size = 0; return false; }
+
+	char* buf = new char[m_size];
+	size_t nread = fread(buf, 1, (size_t)m_size, fp);
+	fclose(fp);
+	if (nread != (size_t)m_size)
+	{
+		delete [] buf;
+		m_size = 0;
+		return false;
+	}
+
+	m_data = buf;
+	m_bmapped = false;
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 
 class XMLPath
@@ -578,8 +910,6 @@ private:
 bool XMLReader::FindTag(const char* xpath, XMLTag& tag)
 {
 	// go to the beginning of the file
-	fseek(m_fp, 0, SEEK_SET);
-	m_bufIndex = m_bufSize = 0;
 	m_currentPos = 0;
 
 	// set the first tag
@@ -630,13 +960,7 @@ void XMLReader::NextTag(XMLTag& tag)
 	m_nline = tag.m_ncurrent_line;
 
 	// set the current file position
-	if (m_currentPos != tag.m_fpos)
-	{
-		fseek(m_fp, tag.m_fpos, SEEK_SET);
-		m_currentPos = tag.m_fpos;
-		m_bufSize = m_bufIndex = 0;
-		m_eof = false;
-	}
+	m_currentPos = tag.m_fpos;
 
 	// clear tag's content
 	tag.clear();
@@ -795,13 +1119,25 @@ void XMLReader::ReadValue(XMLTag& tag)
 	char ch;
 	if (!tag.isend())
 	{
+		// Most values are on a single line and have no entity references. 
+		// For those, we just point the tag to its value in the file buffer.
+		const char* sz = m_data + m_currentPos;
+		const char* se = (const char*) memchr(sz, '<', (size_t)(m_size - m_currentPos));
+		if (se && (memchr(sz, '\n', se - sz) == 0) && (memchr(sz, '&', se - sz) == 0))
+		{
+			tag.m_szval.clear();
+			tag.m_pval = sz;
+			tag.m_pend = se;
+			m_currentPos += (se - sz) + 1;
+			return;
+		}
+
 		tag.m_szval.clear();
 		tag.m_szval.reserve(256);
 		while ((ch=GetChar())!='<') 
 		{ 
 			tag.m_szval.push_back(ch);
 		}
-		tag.m_szval.push_back(0);
 	}
 	else while ((ch=GetChar())!='<');
 }
@@ -867,16 +1203,8 @@ void XMLReader::ReadEndTag(XMLTag& tag)
 //-----------------------------------------------------------------------------
 char XMLReader::readNextChar()
 {
-	if (m_bufIndex >= m_bufSize)
-	{
-		if (m_eof) throw EndOfFile();
-
-		m_bufSize = fread(m_buf, 1, BUF_SIZE, m_fp);
-		m_bufIndex = 0;
-		m_eof = (m_bufSize != BUF_SIZE);
-	}
-	m_currentPos++;
-	return m_buf[m_bufIndex++];
+	if (m_currentPos >= m_size) throw EndOfFile();
+	return m_data[m_currentPos++];
 }
 
 //-----------------------------------------------------------------------------
@@ -889,15 +1217,8 @@ int64_t XMLReader::currentPos()
 //! move the file pointer
 void XMLReader::rewind(int64_t nstep)
 {
-	m_bufIndex -= nstep;
 	m_currentPos -= nstep;
-
-	if (m_bufIndex < 0)
-	{
-		fseek(m_fp, m_bufIndex - m_bufSize, SEEK_CUR);
-		m_bufIndex = m_bufSize = 0;
-		m_eof = false;
-	}
+	assert(m_currentPos >= 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -82,7 +82,9 @@ public:
 
 public:
 	char		m_sztag[MAX_TAG];		// tag name
-	std::string m_szval;				// tag value
+	std::string m_szval;				// tag value (when it cannot be referenced in the reader's buffer)
+	const char*	m_pval;					// start of tag value in the reader's buffer (or null if m_szval holds the value)
+	const char*	m_pend;					// end of tag value in the reader's buffer
 
 	XMLAtt	m_att[MAX_ATT];				// attribute list
 	int		m_natt;						// nr of attributes
@@ -124,12 +126,13 @@ public:
 		
 	const char* Name() { return m_sztag; }
 
-	void value(double& val) { val = atof(m_szval.c_str()); } 
-	void value(float& val)  { val = (float) atof(m_szval.c_str()); }
-	void value(int& val) { val = atoi(m_szval.c_str()); }
-	void value(long& val) { val = (long) atoi(m_szval.c_str()); }
-	void value(short& val) { val = (short) atoi(m_szval.c_str()); }
+	void value(double& val);
+	void value(float& val);
+	void value(int& val);
+	void value(long& val);
+	void value(short& val);
 	int value(double* pf, int n);
+	bool valueList(double* pf, int n);
 	int value(float* pf, int n);
 	int value(int* pi, int n);
 	int value(std::vector<string>& stringList, int n);
@@ -138,7 +141,11 @@ public:
 	void value(std::string& val);
 	void value(vector<int>& l);
 
-	const char* szvalue() { return m_szval.c_str(); }
+	const char* szvalue();
+
+protected:
+	// get the range of characters of the tag's value
+	void valueRange(const char*& sz, const char*& se);
 };
 
 //-----------------------------------------------------------------------------
@@ -148,8 +155,6 @@ class FEBIOXML_API XMLReader
 public:
 	enum {MAX_TAG   = 128};
 
-	enum {BUF_SIZE = 32768};
-
 public:
 	// Base class for Exceptions
 	class FEBIOXML_API Error : public std::runtime_error
@@ -255,6 +260,9 @@ protected: // helper functions
 	//! Read the value of a tag
 	void ReadValue(XMLTag& tag);
 
+	//! Map the file into memory (or read it if it cannot be mapped)
+	bool MapFile(const char* szfile);
+
 	//! process end tag
 	void ReadEndTag(XMLTag& tag);
 
@@ -268,13 +276,15 @@ protected: // helper functions
     void rewind(int64_t nstep);
 
 protected:
-	FILE*	m_fp;			//!< the file pointer
+	const char*	m_data;			//!< the file's content
+	int64_t		m_size;			//!< size of file
+	bool		m_bmapped;		//!< the file's content is a memory mapping (otherwise it was read into a buffer)
+#ifdef WIN32
+	void*		m_hfile;		//!< file handle
+	void*		m_hmap;			//!< file mapping handle
+#endif
 	int		m_nline;		//!< current line (used only as temp storage)
     int64_t	m_currentPos;	//!< current file position
-
-	char	m_buf[BUF_SIZE];
-    int64_t    m_bufIndex, m_bufSize;
-	bool	m_eof;
 };
 
 //-----------------------------------------------------------------------------
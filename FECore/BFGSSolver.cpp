@@ -87,6 +87,7 @@ bool BFGSSolver::Update(double s, vector<double>& ui, vector<double>& R0, vector
 {
 	// calculate the BFGS update vectors
 	int neq = m_neq;
+	#pragma omp parallel for if (neq >= VEC_PARALLEL_MIN)
 	for (int i = 0; i<neq; ++i)
 	{
 		m_D[i] = s*ui[i];
@@ -121,6 +122,7 @@ bool BFGSSolver::Update(double s, vector<double>& ui, vector<double>& R0, vector
 		double* vn = m_V[n];
 		double* wn = m_W[n];
 
+		#pragma omp parallel for if (neq >= VEC_PARALLEL_MIN)
 		for (int i=0; i<neq; ++i)	
 		{
 			vn[i] = -m_H[i]*c - m_G[i];
@@ -158,17 +160,22 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop over all update vectors
-	for (int i=nups-1; i>=0; --i)
+	// The update of tmp with vector i and the dot product for vector i-1 are done in one pass.
+	if (nups > 0)
 	{
-		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double wr = 0;
-		for (int j = 0; j<m_neq; j++) wr += wi[j] * tmp[j];
-
-		for (int j = 0; j<m_neq; j++) tmp[j] += vi[j] * wr;
+		double wr = vdot(m_W[(n0 + nups - 1) % m_max_buf_size], &tmp[0], m_neq);
+		for (int i=nups-1; i>=0; --i)
+		{
+			int n = (n0 + i) % m_max_buf_size;
+			double* vi = m_V[n];
+
+			if (i > 0)
+			{
+				double* wnext = m_W[(n0 + i - 1) % m_max_buf_size];
+				wr = vadds_dot(&tmp[0], vi, wr, wnext, m_neq);
+			}
+			else vadds(&tmp[0], vi, wr, m_neq);
+		}
 	}
 
 	// perform a backsubstitution
@@ -178,16 +185,20 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop again over all update vectors
-	for (int i = 0; i<nups; ++i)
+	if (nups > 0)
 	{
-		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double vr = 0;
-		for (int j = 0; j<m_neq; ++j) vr += vi[j] * x[j];
-
-		for (int j = 0; j<m_neq; ++j) x[j] += wi[j] * vr;
+		double vr = vdot(m_V[n0], &x[0], m_neq);
+		for (int i = 0; i<nups; ++i)
+		{
+			int n = (n0 + i) % m_max_buf_size;
+			double* wi = m_W[n];
+
+			if (i < nups - 1)
+			{
+				double* vnext = m_V[(n0 + i + 1) % m_max_buf_size];
+				vr = vadds_dot(&x[0], wi, vr, vnext, m_neq);
+			}
+			else vadds(&x[0], wi, vr, m_neq);
+		}
 	}
 }
@@ -29,11 +29,16 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "CompactMatrix.h"
 #include <assert.h>
+#include <algorithm>
+#include <atomic>
 
 //=============================================================================
 // CompactMatrix
 //=============================================================================
 
+// counter for the structure IDs (matrices can be allocated on different threads)
+static std::atomic<int> structureCounter(0);
+
 //-----------------------------------------------------------------------------
 CompactMatrix::CompactMatrix(int offset)
 {
@@ -89,6 +94,9 @@ void CompactMatrix::alloc(int nr, int nc, int nz, double* pv, int* pi, int* pp,
 	m_ncol = nc;
 	m_nsize = nz;
 
+	// assign a new structure ID
+	m_structureID = ++structureCounter;
+
 	int nn = (isRowBased() ? nr : nc) + 1;
 }
 
@@ -128,3 +136,145 @@ int CompactMatrix::bandWidth()
 
 	return kmax;
 }
+
+//-----------------------------------------------------------------------------
+// find the location of entry (i,j) in the values array (or -1 if it's not stored)
+int CompactMatrix::EntryLocation(int i, int j)
+{
+	int k = (isRowBased() ? i : j);
+	int m = (isRowBased() ? j : i) + m_offset;
+	int n0 = m_ppointers[k] - m_offset;
+	int l = m_ppointers[k + 1] - m_ppointers[k];
+	const int* pi = m_pindices + n0;
+	for (int n = 0; n < l; ++n)
+		if (pi[n] == m) return n0 + n;
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// see if an equation number (other than a negative one) appears more than once
+bool CompactMatrix::HasRepeatedEquations(const std::vector<int>& lm)
+{
+	std::vector<int> eq;
+	eq.reserve(lm.size());
+	for (size_t i = 0; i < lm.size(); ++i) if (lm[i] >= 0) eq.push_back(lm[i]);
+	std::sort(eq.begin(), eq.end());
+	return (std::adjacent_find(eq.begin(), eq.end()) != eq.end());
+}
+
+//-----------------------------------------------------------------------------
+//! Build the scatter map for an element matrix. This does the same search as 
+//! the Assemble functions, but stores the location of each entry, so that 
+//! subsequent assemblies of the same element don't need to search. 
+//! In general, the map has an entry for each entry of ke (in row-major order), 
+//! which is -1 if the entry is not stored. For a symmetric matrix and a square 
+//! element matrix with lmi == lmj, only the upper triangle of ke is mapped 
+//! (packed by rows). Since only the lower triangle of the global matrix is stored,
+//! exactly one of ke[i][j] and ke[j][i] is assembled. Entries that use ke[j][i] 
+//! are stored as -(n + 2). If an equation appears more than once in lmi (e.g. 
+//! for a collapsed element), both ke[i][j] and ke[j][i] contribute to the same
+//! entry, so then the full map is used.
+bool CompactMatrix::BuildScatterMap(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map)
+{
+	const int N = ke.rows();
+	const int M = ke.columns();
+
+	if (isSymmetric() && (N == M) && (lmi == lmj) && (HasRepeatedEquations(lmi) == false))
+	{
+		map.assign(N*(N + 1) / 2, -1);
+		int* pm = &map[0];
+		for (int i = 0; i < N; ++i)
+		{
+			int I = lmi[i];
+			for (int j = i; j < N; ++j, ++pm)
+			{
+				int J = lmi[j];
+				if ((I < 0) || (J < 0)) continue;
+				if (I >= J) *pm = EntryLocation(I, J);
+				else
+				{
+					int n = EntryLocation(J, I);
+					if (n >= 0) *pm = -(n + 2);
+				}
+			}
+		}
+		return true;
+	}
+
+	map.assign(N*M, -1);
+	const bool bsymm = isSymmetric();
+	for (int i = 0; i < N; ++i)
+	{
+		int I = lmi[i];
+		if (I < 0) continue;
+		for (int j = 0; j < M; ++j)
+		{
+			int J = lmj[j];
+			if (J < 0) continue;
+
+			// symmetric matrices only store the lower triangular part
+			if (bsymm && (I < J)) continue;
+
+			map[i*M + j] = EntryLocation(I, J);
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! assemble an element matrix using its scatter map
+void CompactMatrix::ScatterAssemble(const matrix& ke, const std::vector<int>& map)
+{
+	const int N = ke.rows();
+	const int M = ke.columns();
+	const int* pm = &map[0];
+
+	if ((N == M) && ((int)map.size() == N*(N + 1) / 2))
+	{
+		// packed upper triangle of a symmetric matrix (see BuildScatterMap)
+		for (int i = 0; i < N; ++i)
+		{
+			for (int j = i; j < N; ++j, ++pm)
+			{
+				int n = *pm;
+				if (n == -1) continue;
+				double v = (n >= 0 ? ke[i][j] : ke[j][i]);
+				if (n < 0) n = -(n + 2);
+				if (m_batomic)
+				{
+#pragma omp atomic
+					m_pd[n] += v;
+				}
+				else m_pd[n] += v;
+			}
+		}
+		return;
+	}
+
+	assert((int)map.size() == N*M);
+	for (int i = 0; i < N; ++i, pm += M)
+	{
+		const double* ki = ke[i];
+		if (m_batomic)
+		{
+			for (int j = 0; j < M; ++j)
+			{
+				int n = pm[j];
+				if (n >= 0)
+				{
+#pragma omp atomic
+					m_pd[n] += ki[j];
+				}
+			}
+		}
+		else
+		{
+			for (int j = 0; j < M; ++j)
+			{
+				int n = pm[j];
+				if (n >= 0) m_pd[n] += ki[j];
+			}
+		}
+	}
+}
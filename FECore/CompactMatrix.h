@@ -73,6 +73,20 @@ public:
 	//! is this a row-based format or not
 	virtual bool isRowBased() = 0;
 
+public:
+	//! build the scatter map for an element matrix
+	bool BuildScatterMap(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map) override;
+
+	//! assemble an element matrix using its scatter map
+	void ScatterAssemble(const matrix& ke, const std::vector<int>& map) override;
+
+protected:
+	//! location of entry (i,j) in the values array (or -1 if not stored)
+	int EntryLocation(int i, int j);
+
+	//! see if an equation number appears more than once in lm (negative ones are ignored)
+	static bool HasRepeatedEquations(const std::vector<int>& lm);
+
 public:
 	//! Calculate the infinity norm
 	virtual double infNorm() const = 0;
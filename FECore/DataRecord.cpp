@@ -213,29 +213,36 @@ bool DataRecord::Write()
 		fprintf(fp,"*Data  = %s\n", m_szname);
 	}
 
-	// save the data
+	// Evaluate the data and convert it to text. Since evaluating the data
+	// can be expensive (e.g. element stresses), this is done in parallel. 
+	PrepareEvaluation();
+	int N = (int)m_item.size();
+	std::vector<std::string> out(N);
 	if (m_szfmt[0]==0)
 	{
-		for (size_t i=0; i<m_item.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 64)
+		for (int i=0; i<N; ++i)
 		{
-			std::string out = printToString((int)i);
-
-			if (fp) fprintf(fp, "%s", out.c_str());
-			else feLogEx(m_pfem, out.c_str(),"");
+			out[i] = printToString(i);
 		}
 	}
 	else
 	{
 		// print using the format string
-		for (size_t i=0; i<m_item.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 64)
+		for (int i=0; i<N; ++i)
 		{
-			std::string out = printToFormatString((int)i);
-
-			if (fp) fprintf(fp, "%s", out.c_str());
-			else feLogEx(m_pfem, out.c_str(),"");
+			out[i] = printToFormatString(i);
 		}
 	}
 
+	// save the data
+	for (int i=0; i<N; ++i)
+	{
+		if (fp) fprintf(fp, "%s", out[i].c_str());
+		else feLogEx(m_pfem, out[i].c_str(),"");
+	}
+
 	if (fp) fflush(fp);
 
 	return true;
@@ -79,6 +79,11 @@ public:
 	virtual void Parse(const char* sz) = 0;
 	virtual int Size() const = 0;
 
+protected:
+	//! This is called by Write before the data is evaluated. Since Evaluate is
+	//! called from multiple threads, derived classes should build any lookup data here.
+	virtual void PrepareEvaluation() {}
+
 private:
 	std::string printToString(int i);
 	std::string printToFormatString(int i);
@@ -54,6 +54,7 @@ bool DumpStream::IsShallow() const { return m_bshallow; }
 DumpStream::~DumpStream()
 {
 	m_ptr.clear();
+	m_ptrIndex.clear();
 	m_bytes_serialized = 0;
 }
 
@@ -67,8 +68,10 @@ void DumpStream::Open(bool bsave, bool bshallow)
 
 	// add the "null" pointer
 	m_ptr.clear();
+	m_ptrIndex.clear();
 	Pointer p = { 0, 0 };
 	m_ptr.push_back(p);
+	if (bsave) m_ptrIndex[0] = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -195,23 +198,21 @@ DumpStream& DumpStream::operator >> (double a[3][3])
 }
 
 //-----------------------------------------------------------------------------
+// NOTE: This is only used when saving, since the pointer index is not built when loading.
 int DumpStream::FindPointer(void* p)
 {
-	for (int i = 0; i < (int)m_ptr.size(); ++i)
-	{
-		if (m_ptr[i].pd == p) return i;
-	}
-	return -1;
+	assert(IsSaving());
+	std::unordered_map<void*, int>::const_iterator it = m_ptrIndex.find(p);
+	return (it != m_ptrIndex.end() ? it->second : -1);
 }
 
 //-----------------------------------------------------------------------------
+// The pointer IDs are assigned sequentially, so the ID is also the index into the pointer table.
 int DumpStream::FindPointer(int id)
 {
-	for (int i = 0; i < (int)m_ptr.size(); ++i)
-	{
-		if (m_ptr[i].id == id) return i;
-	}
-	return -1;
+	if ((id < 0) || (id >= (int)m_ptr.size())) return -1;
+	assert(m_ptr[id].id == id);
+	return id;
 }
 
 //-----------------------------------------------------------------------------
@@ -219,10 +220,14 @@ void DumpStream::AddPointer(void* p)
 {
 	if (m_ptr_lock) return;
 	if (p == nullptr) { assert(false); return;	}
-	assert(FindPointer(p) == -1);
 	Pointer ptr;
 	ptr.pd = p;
 	ptr.id = (int)m_ptr.size();
+	if (IsSaving())
+	{
+		bool bnew = m_ptrIndex.insert(std::make_pair(p, (int)ptr.id)).second;
+		assert(bnew); (void)bnew;
+	}
 	m_ptr.push_back(ptr);
 }
 
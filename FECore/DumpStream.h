@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <string.h>
 #include "vec3d.h"
 #include "mat3d.h"
@@ -145,7 +146,8 @@ private:
 	size_t	m_bytes_serialized;	//!< number or bytes serialized
 
 	bool					m_ptr_lock;
-	std::vector<Pointer>	m_ptr;
+	std::vector<Pointer>	m_ptr;		//!< pointer table (the pointer ID is the index in this table)
+	std::unordered_map<void*, int>	m_ptrIndex;	//!< maps pointers to their index in the pointer table (only used when saving)
 };
 
 template <typename T> DumpStream& DumpStream::write_raw(const T& o)
@@ -233,6 +235,48 @@ template <typename T> inline DumpStream& DumpStream::operator >> (std::vector<T>
 	return This;
 }
 
+// Vectors of plain data are written as a single block. The data in the stream
+// is the same as when writing the items one by one.
+template <> inline DumpStream& DumpStream::operator << (std::vector<double>& o)
+{
+	int N = (int) o.size();
+	write(&N, sizeof(int), 1);
+	if (N > 0) m_bytes_serialized += write(&o[0], sizeof(double), N);
+	return *this;
+}
+
+template <> inline DumpStream& DumpStream::operator >> (std::vector<double>& o)
+{
+	int N;
+	read(&N, sizeof(int), 1);
+	if (N > 0)
+	{
+		o.resize(N);
+		m_bytes_serialized += read(&o[0], sizeof(double), N);
+	}
+	return *this;
+}
+
+template <> inline DumpStream& DumpStream::operator << (std::vector<int>& o)
+{
+	int N = (int) o.size();
+	write(&N, sizeof(int), 1);
+	if (N > 0) m_bytes_serialized += write(&o[0], sizeof(int), N);
+	return *this;
+}
+
+template <> inline DumpStream& DumpStream::operator >> (std::vector<int>& o)
+{
+	int N;
+	read(&N, sizeof(int), 1);
+	if (N > 0)
+	{
+		o.resize(N);
+		m_bytes_serialized += read(&o[0], sizeof(int), N);
+	}
+	return *this;
+}
+
 template <> inline DumpStream& DumpStream::operator << (std::vector<bool>& o)
 {
 	DumpStream& This = *this;
@@ -67,10 +67,17 @@ void ElementDataRecord::Parse(const char *szexpr)
 }
 
 //-----------------------------------------------------------------------------
-double ElementDataRecord::Evaluate(int item, int ndata)
+void ElementDataRecord::PrepareEvaluation()
 {
 	// make sure we have an ELT
 	if (m_ELT.empty()) BuildELT();
+}
+
+//-----------------------------------------------------------------------------
+double ElementDataRecord::Evaluate(int item, int ndata)
+{
+	// the ELT is built in PrepareEvaluation
+	assert(m_ELT.empty() == false);
 
 	// find the element
 	FEMesh& mesh = m_pfem->GetMesh();
@@ -63,6 +63,7 @@ public:
 	void SetItemList(FEElementSet* pg);
 
 protected:
+	void PrepareEvaluation() override;
 	void BuildELT();
 
 protected:
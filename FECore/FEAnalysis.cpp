@@ -378,9 +378,11 @@ bool FEAnalysis::Solve()
 	{
 		// keep a copy of the current state, in case
 		// we need to retry this time step
+		// NOTE: We rewind the stream instead of clearing it, so that the buffer
+		// that was allocated for the previous time step is reused.
 		if (m_timeController && (m_timeController->m_maxretries > 0))
 		{ 
-			dmp.clear();
+			dmp.Open(true, true);
 			fem.Serialize(dmp); 
 		}
 
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FEException.h"
 #include "FENewtonSolver.h"
+#include "vector.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -92,28 +93,28 @@ bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0,
 		int n1 = (m_nups >= m_max_buf_size ? (m_nups) % m_max_buf_size : m_nups);
 
 		// loop over update vectors
+		// (the update of q and the dot product for the next vector are done in one pass)
+		double* q = &m_q[0];
+		double w = (nups > 0 ? vdot(m_D[n0], q, m_neq) : 0.0);
 		for (int j = 0; j<nups; ++j)
 		{
 			int n = (n0 + j) % m_max_buf_size;
-
-			double w = 0.0;
-			for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
+			double* dnext = (j < nups - 1 ? m_D[(n + 1) % m_max_buf_size] : nullptr);
 
 			double g = m_rho[n] * w;
-			for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
+			w = vadds_diff_dot(q, m_D[n], m_R[n], g, dnext, m_neq);
 		}
 
 		// form and store the next update vector
-		double rhoi = 0.0;
+		double* rn = m_R[n1];
+		double* dn = m_D[n1];
+		#pragma omp parallel for if (m_neq >= VEC_PARALLEL_MIN)
 		for (int i = 0; i<m_neq; ++i)
 		{
-			double ri = m_q[i] - ui[i];
-			double di = -s*ui[i];
-			m_R[n1][i] = ri;
-			m_D[n1][i] = di;
-
-			rhoi += di*ri;
+			rn[i] = m_q[i] - ui[i];
+			dn[i] = -s*ui[i];
 		}
+		double rhoi = vdot(dn, rn, m_neq);
 		m_rho[n1] = 1.0 / (rhoi);
 	}
 
@@ -148,34 +149,40 @@ void FEBroydenStrategy::SolveEquations(vector<double>& x, vector<double>& b)
 			n1 = (m_nups - 1) % m_max_buf_size;
 		}
 
+		double wq = 0.0;
 		if (m_bnewStep)
 		{
 			m_q = x;
 			if (m_plinsolve->BackSolve(m_q, b) == false)
 				throw LinearSolverFailed();
 
+			// (the update of q and the dot product for the next vector are done in one pass, 
+			// where the last pass calculates the dot product with the last update vector)
+			double* q = &m_q[0];
+			double w = (nups > 1 ? vdot(m_D[n0], q, m_neq) : 0.0);
 			for (int j = 0; j<nups - 1; ++j)
 			{
 				int n = (n0 + j) % m_max_buf_size;
-
-				double w = 0.0;
-				for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
+				double* dnext = (j < nups - 2 ? m_D[(n + 1) % m_max_buf_size] : m_D[n1]);
 
 				double g = m_rho[n] * w;
-				for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
+				w = vadds_diff_dot(q, m_D[n], m_R[n], g, dnext, m_neq);
 			}
+			wq = (nups > 1 ? w : vdot(m_D[n1], q, m_neq));
 
 			m_bnewStep = false;
 		}
+		else wq = vdot(m_D[n1], &m_q[0], m_neq);
 
 		// calculate solution
-		double rho = 0.0;
-		for (int i = 0; i<m_neq; ++i) rho += m_D[n1][i] * m_q[i];
-		rho *= m_rho[n1];
+		double rho = wq * m_rho[n1];
 
+		const double* dn = m_D[n1];
+		const double* rn = m_R[n1];
+		#pragma omp parallel for if (m_neq >= VEC_PARALLEL_MIN)
 		for (int i = 0; i<m_neq; ++i)
 		{
-			x[i] = m_q[i] + rho*(m_D[n1][i] - m_R[n1][i]);
+			x[i] = m_q[i] + rho*(dn[i] - rn[i]);
 		}
 	}
 }
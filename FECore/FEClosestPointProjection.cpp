@@ -41,6 +41,7 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 	m_bspecial = false;
 	m_projectBoundary = false;
 	m_handleQuads = false;
+	m_bvh = nullptr;
 
 	// calculate node-element list
 	m_NEL.Create(m_surf);
@@ -52,8 +53,7 @@ FEClosestPointProjection::FEClosestPointProjection(FESurface& s) : m_surf(s)
 bool FEClosestPointProjection::Init()
 {
 	// initialize the nearest neighbor search
-	m_SNQ.Attach(&m_surf);
-	m_SNQ.Init();
+	m_bvh = &m_surf.UpdateBVH();
 
 	return true;
 }
@@ -84,7 +84,8 @@ FESurfaceElement* FEClosestPointProjection::Project(vec3d& x, vec3d& q, vec2d& r
 	FEMesh& mesh = *m_surf.GetMesh();
 
 	// let's find the closest master node
-	int mn = m_SNQ.Find(x);
+	int mn = m_bvh->FindNearestNode(x);
+	if (mn < 0) return 0;
 
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
@@ -300,29 +301,9 @@ FESurfaceElement* FEClosestPointProjection::Project(int n, vec3d& q, vec2d& r)
 	// get the node's position
 	vec3d x = mesh.Node(n).m_rt;
 	
-	// see if we need to initialize the NQ structure
-//	if (binit_nq) m_SNQ.Init();
-	
-	// let's find the closest master node
-//	int mn = m_SNQ.Find(x);
-
-	// do it the hard way
-	int mn = -1;
-	double d0;
-	int N = m_surf.Nodes();
-	for (int i=0; i<N; ++i)
-	{
-		if (m_surf.NodeIndex(i) != n)
-		{
-			vec3d r = m_surf.Node(i).m_rt;
-			double d = (r - x)*(r - x);
-			if ((mn == -1) || (d < d0))
-			{
-				d0 = d;
-				mn = i;
-			}
-		}
-	}
+	// let's find the closest master node, skipping the node itself
+	int mn = m_bvh->FindNearestNode(x, n);
+	if (mn < 0) return 0;
 	
 	// mn is a local index, so get the global node number too
 	int m = m_surf.NodeIndex(mn);
@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FENNQuery.h"
+#include "FESurfaceBVH.h"
 #include "FEElemElemList.h"
 #include "FENodeElemList.h"
 
@@ -41,7 +41,7 @@ public:
 	//! constructor
 	FEClosestPointProjection(FESurface& s);
 
-	//! Initialization
+	//! Initialization (builds or refits the surface's search tree)
 	bool Init();
 
 	//! Project a point onto surface
@@ -78,7 +78,7 @@ protected:
 
 protected:
 	FESurface&		m_surf;		//!< reference to surface
-	FENNQuery		m_SNQ;		//!< used to find the nearest neighbour
+	const FESurfaceBVH*	m_bvh;	//!< used to find the nearest neighbour
 	FENodeElemList	m_NEL;		//!< node-element tree
 	FEElemElemList	m_EEL;		//!< element neighbor list
 };
@@ -29,11 +29,26 @@ SOFTWARE.*/
 #include "DumpStream.h"
 #include "FEMesh.h"
 #include "FEGlobalMatrix.h"
+#include "FELinearSystem.h"
+#include "FESolver.h"
 
 //-----------------------------------------------------------------------------
 FEDomain::FEDomain(int nclass, FEModel* fem) : FEMeshPartition(nclass, fem)
 {
+	m_colorElems = -1;
+	m_scatterID = 0;
+	m_scatterUses = 0;
+	m_bscatter = true;
+	m_pool = nullptr;
+}
 
+//-----------------------------------------------------------------------------
+FEDomain::~FEDomain()
+{
+	// The derived classes already deleted the elements (and their material point
+	// data), but the pool is only deleted after all its material points are deleted.
+	if (m_pool) m_pool->Release();
+	m_pool = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -53,12 +68,31 @@ void FEDomain::SetMatID(int mid)
 // This routine allocates the material point data for the element's integration points.
 // Currently, this has to be called after the elements have been assigned a type (since this
 // determines how many integration point an element gets). 
+// The material point data is allocated from the domain's material point pool, so that 
+// the data of all the integration points of this domain is stored contiguously.
 void FEDomain::CreateMaterialPointData()
 {
 	FEMaterial* pmat = GetMaterial();
-	if (pmat) ForEachElement([=](FEElement& el) {
+	if (pmat == nullptr) return;
+
+	// the old material point data is replaced, so the cache is no longer valid
+	ClearMaterialPointCache();
+
+	if (m_pool == nullptr) m_pool = new FEMaterialPointPool;
+	else m_pool->Reset();
+
+	FEMaterialPointPool::SetActive(m_pool);
+	ForEachElement([=](FEElement& el) {
 		for (int k = 0; k<el.GaussPoints(); ++k) el.SetMaterialPointData(pmat->CreateMaterialPointData(), k);
 	});
+	FEMaterialPointPool::SetActive(nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::ClearMaterialPointCache()
+{
+	m_mpCache.clear();
+	m_mpOffset.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -67,6 +101,9 @@ void FEDomain::Serialize(DumpStream& ar)
 {
 	FEMeshPartition::Serialize(ar);
 
+	// a deep load recreates the material point data
+	if ((ar.IsShallow() == false) && ar.IsLoading()) ClearMaterialPointCache();
+
 	if (ar.IsShallow())
 	{
 		int NEL = Elements();
@@ -182,3 +219,116 @@ void FEDomain::Activate(const FEDofList& dof)
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+int FEDomain::ElementColors()
+{
+	if (m_colorElems != Elements()) BuildElementColoring();
+	return (int)m_colors.size();
+}
+
+//-----------------------------------------------------------------------------
+// Greedy element coloring. Each element gets the lowest color that is not used
+// by any of the elements it shares a node with. The (local) node numbers are 
+// assigned in FEMeshPartition::Init, so this can only be called after that.
+void FEDomain::BuildElementColoring()
+{
+	m_colors.clear();
+	const int NE = Elements();
+	const int NN = Nodes();
+	m_colorElems = NE;
+	if (NE == 0) return;
+
+	// build the node-element table (in compressed row format)
+	vector<int> pos(NN + 1, 0);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) pos[el.m_lnode[j] + 1]++;
+	}
+	for (int i = 0; i < NN; ++i) pos[i + 1] += pos[i];
+	vector<int> nel(pos[NN]);
+	vector<int> tmp(pos.begin(), pos.end() - 1);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) nel[tmp[el.m_lnode[j]]++] = i;
+	}
+
+	// assign colors
+	vector<int> color(NE, -1);
+	vector<int> mark;
+	int ncolors = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		// mark the colors of all the neighbors
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j)
+		{
+			int n = el.m_lnode[j];
+			for (int k = pos[n]; k < pos[n + 1]; ++k)
+			{
+				int c = color[nel[k]];
+				if (c >= 0) mark[c] = i;
+			}
+		}
+
+		// pick the first free color
+		int c = 0;
+		while ((c < ncolors) && (mark[c] == i)) ++c;
+		if (c == ncolors) { mark.push_back(-1); ncolors++; }
+		color[i] = c;
+	}
+
+	// build the element lists
+	m_colors.resize(ncolors);
+	for (int i = 0; i < NE; ++i) m_colors[color[i]].push_back(i);
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::UpdateScatterMaps(FELinearSystem& LS)
+{
+	SparseMatrix& K = LS.GetSparseMatrix();
+	int nid = K.StructureID();
+	if ((nid != m_scatterID) || ((int)m_scatter.size() != Elements()))
+	{
+		// If the maps for the previous structure were only used once, building them
+		// doesn't pay off, since the structure is likely to change again. 
+		if ((m_scatterID != 0) && (m_scatterUses <= 1)) m_bscatter = false;
+
+		FESolver* solver = LS.GetSolver();
+		if (solver && (solver->m_bscatter == false)) m_bscatter = false;
+
+		// release the memory of the old maps
+		vector< vector<int> >().swap(m_scatter);
+		m_scatterID = 0;
+		m_scatterUses = 0;
+		if (m_bscatter == false) return;
+
+		m_scatter.resize(Elements());
+		m_scatterID = nid;
+	}
+	m_scatterUses++;
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::SetScatterMap(int iel, FEElementMatrix& ke, FELinearSystem& LS)
+{
+	// matrices that don't track their structure, don't support scatter maps either
+	if (m_scatterID == 0) return;
+
+	vector<int>& map = m_scatter[iel];
+	if (map.empty())
+	{
+		SparseMatrix& K = LS.GetSparseMatrix();
+		if (K.BuildScatterMap(ke, ke.RowIndices(), ke.ColumnsIndices(), map) == false)
+		{
+			map.clear();
+			return;
+		}
+	}
+	ke.SetScatterMap(&map);
+}
@@ -28,15 +28,19 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEMeshPartition.h"
+#include "FEMaterialPointPool.h"
 
 // forward declaration of material class
 class FEMaterial;
+class FELinearSystem;
+class FEElementMatrix;
 
 // Base class for solid and shell parts. Domains can also have materials assigned.
 class FECORE_API FEDomain : public FEMeshPartition
 {
 public:
 	FEDomain(int nclass, FEModel* fem);
+	~FEDomain();
 
 	//! get the material of this domain
 	virtual FEMaterial* GetMaterial() { return 0; }
@@ -74,10 +78,104 @@ public:
 	//! Activate the domain
 	virtual void Activate();
 
+public:
+	//! Return the number of element colors. Elements of the same color do not share
+	//! any nodes, so they can be assembled concurrently without synchronization.
+	//! The coloring is (re)built on the first call after the elements have changed.
+	int ElementColors();
+
+	//! Return the list of (local) element indices of color n
+	const vector<int>& ElementColor(int n) { return m_colors[n]; }
+
+	//! Prepare the element scatter maps for assembling into the linear system's matrix.
+	//! The maps are discarded when the structure of the matrix has changed. 
+	//! This must be called (serially) before the element loop that uses SetScatterMap.
+	//! A map stores one int per entry of the element matrix (or of its upper triangle 
+	//! for symmetric matrices), e.g. 1.2 KB per HEX8 and 7.3 KB per HEX20 element of an 
+	//! elastic domain with symmetric storage. The maps are turned off with the solver's 
+	//! scatter_maps parameter, and they are dropped for the rest of the run when the 
+	//! matrix structure changes before the maps were reused (e.g. contact models that 
+	//! recreate the matrix at each reformation).
+	void UpdateScatterMaps(FELinearSystem& LS);
+
+	//! Attach the scatter map of element iel to the element matrix, building it on first use.
+	//! This can be called concurrently for different elements.
+	void SetScatterMap(int iel, FEElementMatrix& ke, FELinearSystem& LS);
+
+public:
+	//! Look up the material point data of type T of all integration points and cache it.
+	//! This should be called (serially) during initialization, after the material point data
+	//! was created. Returns false (and caches nothing) if not all points have data of this type.
+	template <class T> bool CacheMaterialPointData();
+
+	//! Return the material point data of type T of integration point n of element iel.
+	//! This uses the cached data if available, and otherwise falls back to ExtractData.
+	template <class T> T* MaterialPointData(int iel, int n);
+
+	//! clear all cached material point data
+	void ClearMaterialPointCache();
+
+protected:
+	// build a greedy element coloring
+	void BuildElementColoring();
+
 protected:
 	// helper function for activating dof lists
 	void Activate(const FEDofList& dof);
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+private:
+	vector< vector<int> >	m_colors;		//!< element lists for each color
+	int						m_colorElems;	//!< number of elements when the coloring was built
+
+	vector< vector<int> >	m_scatter;		//!< scatter maps of each element
+	int						m_scatterID;	//!< structure ID of the matrix the scatter maps refer to
+	int						m_scatterUses;	//!< nr of assemblies that used the current scatter maps
+	bool					m_bscatter;		//!< are scatter maps used for this domain?
+
+	FEMaterialPointPool*	m_pool;			//!< pool that stores the material point data of this domain
+
+	vector<int>				m_mpOffset;		//!< index of the first integration point of each element in the caches
+	vector< vector<void*> >	m_mpCache;		//!< cached material point data for each material point type ID
 };
+
+//-----------------------------------------------------------------------------
+template <class T> inline bool FEDomain::CacheMaterialPointData()
+{
+	int id = FEMaterialPointTypeID<T>();
+	if (id >= (int)m_mpCache.size()) m_mpCache.resize(id + 1);
+	vector<void*>& cache = m_mpCache[id];
+	cache.clear();
+
+	int NE = Elements();
+	m_mpOffset.resize(NE + 1);
+	m_mpOffset[0] = 0;
+	for (int i = 0; i < NE; ++i) m_mpOffset[i + 1] = m_mpOffset[i] + ElementRef(i).GaussPoints();
+
+	cache.resize(m_mpOffset[NE]);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		for (int n = 0; n < el.GaussPoints(); ++n)
+		{
+			FEMaterialPoint* mp = el.GetMaterialPoint(n);
+			T* pt = (mp ? mp->ExtractData<T>() : nullptr);
+			if (pt == nullptr) { cache.clear(); return false; }
+			cache[m_mpOffset[i] + n] = pt;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+template <class T> inline T* FEDomain::MaterialPointData(int iel, int n)
+{
+	int id = FEMaterialPointTypeID<T>();
+	if ((id < (int)m_mpCache.size()) && (m_mpCache[id].empty() == false))
+	{
+		return static_cast<T*>(m_mpCache[id][m_mpOffset[iel] + n]);
+	}
+	return ElementRef(iel).GetMaterialPoint(n)->ExtractData<T>();
+}
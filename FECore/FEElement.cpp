@@ -160,6 +160,7 @@ FEElement::FEElement() : m_pT(0)
 	m_lid = -1;
 	m_part = nullptr;
 	m_status = ACTIVE;
+	m_bconstrained = true;
 }
 
 //! get the element ID
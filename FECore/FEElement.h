@@ -206,11 +206,17 @@ public:
 	void setActive() { m_status |= ACTIVE; }
 	void setInactive() { m_status &= ~ACTIVE; }
 
+	// Does this element touch a node with linearly constrained or rigid dofs?
+	// This is set by FESolver::InitEquations. Until then, elements are assumed to be constrained.
+	bool isConstrained() const { return m_bconstrained; }
+	void setConstrained(bool b) { m_bconstrained = b; }
+
 protected:
 	int		m_nID;		//!< element ID
 	int		m_lid;		//!< local ID
 	int		m_mat;		//!< material index
 	unsigned int	m_status;	//!< element status
+	bool			m_bconstrained;	//!< element touches constrained or rigid nodes
 	FEMeshPartition * m_part;	//!< parent mesh partition
 
 public:
@@ -36,6 +36,8 @@ SOFTWARE.*/
 FEElementMatrix::FEElementMatrix(const FEElement& el)
 {
 	m_node = el.m_node;
+	m_scatter = nullptr;
+	m_bconstrained = el.isConstrained();
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +46,8 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_scatter = ke.m_scatter;
+	m_bconstrained = ke.m_bconstrained;
 }
 
 //-----------------------------------------------------------------------------
@@ -52,6 +56,8 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_scatter = ke.m_scatter;
+	m_bconstrained = ke.m_bconstrained;
 	matrix& T = *this;
 	const matrix& K = ke;
 	T = (scale == 1.0 ? K : K*scale);
@@ -63,6 +69,8 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) :
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmi;
+	m_scatter = nullptr;
+	m_bconstrained = el.isConstrained();
 }
 
 //-----------------------------------------------------------------------------
@@ -71,6 +79,8 @@ FEElementMatrix::FEElementMatrix(const FEElement& el, vector<int>& lmi, vector<i
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmj;
+	m_scatter = nullptr;
+	m_bconstrained = el.isConstrained();
 };
 
 //-----------------------------------------------------------------------------
@@ -316,5 +326,8 @@ bool FEGlobalMatrix::Create(const FESurface& surf, const std::vector<int>& equat
 
 void FEGlobalMatrix::Assemble(const FEElementMatrix& ke)
 {
-	m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
+	// use the scatter map if the element matrix has one
+	const vector<int>* map = ke.ScatterMap();
+	if (map) m_pA->ScatterAssemble(ke, *map);
+	else m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
 }
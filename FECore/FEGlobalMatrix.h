@@ -45,8 +45,8 @@ class FECORE_API FEElementMatrix : public matrix
 {
 public:
 	// default constructor
-	FEElementMatrix(){}
-	FEElementMatrix(int nr, int nc) : matrix(nr, nc) {}
+	FEElementMatrix() : m_scatter(nullptr), m_bconstrained(true) {}
+	FEElementMatrix(int nr, int nc) : matrix(nr, nc), m_scatter(nullptr), m_bconstrained(true) {}
 	FEElementMatrix(const FEElement& el);
 
 	// constructor for symmetric matrices
@@ -77,15 +77,31 @@ public:
 	void SetIndices(const std::vector<int>& lmr, const std::vector<int>& lmc) { m_lmi = lmr; m_lmj = lmc; }
 
 	// Set the node indices
-	void SetNodes(const std::vector<int>& en) { m_node = en; }
+	// (This clears the constrained flag since the new nodes may have constraints.)
+	void SetNodes(const std::vector<int>& en) { m_node = en; m_bconstrained = true; }
 
 	// get the nodes
 	const std::vector<int>& Nodes() const { return m_node; }
 
+	// Set the scatter map (see SparseMatrix::BuildScatterMap). 
+	// The map is not owned by the element matrix and must remain valid until it is assembled.
+	void SetScatterMap(const std::vector<int>* map) { m_scatter = map; }
+
+	// get the scatter map (or null if not set)
+	const std::vector<int>* ScatterMap() const { return m_scatter; }
+
+	// Set whether the nodes may have linearly constrained or rigid dofs (see FEElement::isConstrained).
+	// When false, the linear system skips the constraint and rigid body assembly for this matrix.
+	void SetConstrained(bool b) { m_bconstrained = b; }
+	bool IsConstrained() const { return m_bconstrained; }
+
 private:
 	std::vector<int>	m_node;	//!< node indices
 	std::vector<int>	m_lmi;	//!< row indices
 	std::vector<int>	m_lmj;	//!< column indices
+
+	const std::vector<int>*	m_scatter;	//!< scatter map into the global matrix (optional)
+	bool					m_bconstrained;	//!< may touch constrained or rigid nodes
 };
 
 //-----------------------------------------------------------------------------
@@ -122,6 +122,7 @@ void FELinearConstraintManager::Serialize(DumpStream& ar)
 		{
 			ar.read(&m_LCT(0,0), sizeof(int), nr*nc);
 		}
+		InitNodeFlags();
 	}
 }
 
@@ -294,6 +295,38 @@ void FELinearConstraintManager::InitTable()
 
 		m_LCT(n, m) = i;
 	}
+
+	InitNodeFlags();
+}
+
+//-----------------------------------------------------------------------------
+// Flag the nodes that appear as a master node in the linear constraint table.
+// This allows element matrices that don't touch any of these nodes to skip the
+// (expensive) constraint assembly altogether.
+void FELinearConstraintManager::InitNodeFlags()
+{
+	int nr = m_LCT.rows();
+	int nc = m_LCT.columns();
+	m_nodeLC.assign(nr, 0);
+	for (int i = 0; i < nr; ++i)
+	{
+		for (int j = 0; j < nc; ++j)
+		{
+			if (m_LCT(i, j) >= 0) { m_nodeLC[i] = 1; break; }
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FELinearConstraintManager::HasConstrainedNodes(const vector<int>& en) const
+{
+	const int nn = (int)m_nodeLC.size();
+	for (size_t i = 0; i < en.size(); ++i)
+	{
+		int n = en[i];
+		if ((n >= 0) && (n < nn) && m_nodeLC[n]) return true;
+	}
+	return false;
 }
 
 //-----------------------------------------------------------------------------
@@ -383,6 +416,9 @@ void FELinearConstraintManager::AssembleResidual(vector<double>& R, vector<int>&
 //-----------------------------------------------------------------------------
 void FELinearConstraintManager::AssembleStiffness(FEGlobalMatrix& G, vector<double>& R, vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke)
 {
+	// nothing to do if this element doesn't touch any constrained nodes
+	if (HasConstrainedNodes(en) == false) return;
+
 	FEMesh& mesh = m_fem->GetMesh();
 
 	int ndof = ke.rows();
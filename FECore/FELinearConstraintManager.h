@@ -77,6 +77,9 @@ public:
 	// assemble element residual into global residual
 	void AssembleResidual(vector<double>& R, vector<int>& en, vector<int>& elm, vector<double>& fe);
 
+	// see if any of the nodes in the list has a constrained dof
+	bool HasConstrainedNodes(const vector<int>& en) const;
+
 	// assemble element matrix into (reduced) global matrix
 	void AssembleStiffness(FEGlobalMatrix& K, vector<double>& R, vector<double>& ui, const vector<int>& en, const vector<int>& lmi, const vector<int>& lmj, const matrix& ke);
 
@@ -88,10 +91,12 @@ public:
 
 protected:
 	void InitTable();
+	void InitNodeFlags();
 
 private:
 	FEModel* m_fem;
 	vector<FELinearConstraint>	m_LinC;		//!< linear constraints data
 	table<int>					m_LCT;		//!< linear constraint table
+	vector<char>				m_nodeLC;	//!< flags nodes that have at least one constrained dof
 	vector<double>				m_up;		//!< the inhomogenous component of the linear constraint
 };
@@ -30,17 +30,32 @@ SOFTWARE.*/
 #include "FELinearSystem.h"
 #include "FELinearConstraintManager.h"
 #include "FEModel.h"
+#include "sys.h"
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+// Returns an index that is unique for the calling thread. The index is assigned
+// the first time a thread asks for it. Unlike omp_get_thread_num, this does not
+// depend on the nesting of parallel regions (e.g. in concurrent tasks, see FETaskList).
+static std::atomic<int> threadCounter(0);
+static int ThreadBufferIndex()
+{
+	static thread_local int n = threadCounter++;
+	return n;
+}
 
 //-----------------------------------------------------------------------------
 FELinearSystem::FELinearSystem(FESolver* solver, FEGlobalMatrix& K, vector<double>& F, vector<double>& u, bool bsymm) : m_K(K), m_F(F), m_u(u), m_solver(solver)
 {
 	m_bsymm = bsymm;
+	m_bcolored = false;
+	m_deferred.resize(omp_get_max_threads());
 }
 
 //-----------------------------------------------------------------------------
 FELinearSystem::~FELinearSystem()
 {
-
+	FlushDeferred();
 }
 
 //-----------------------------------------------------------------------------
@@ -57,6 +72,13 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// Get the sparse matrix that stores the global stiffness matrix
+SparseMatrix& FELinearSystem::GetSparseMatrix()
+{
+	return m_K;
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
@@ -88,8 +110,12 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				if (I >= 0)
 				{
 					// dof i is not a prescribed degree of freedom
+					if (m_bcolored) m_F[I] -= ke[i][j] * m_u[J];
+					else
+					{
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+						m_F[I] -= ke[i][j] * m_u[J];
+					}
 				}
 			}
 
@@ -98,16 +124,91 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 	}
 
-#pragma omp critical
-	{
+	// the linear constraints couple to equations outside of the element
 	FEModel* fem = m_solver->GetFEModel();
 	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
-	if (LCM.LinearConstraints())
+	if (ke.IsConstrained() && LCM.LinearConstraints() && LCM.HasConstrainedNodes(ke.Nodes()))
 	{
-		const vector<int>& en = ke.Nodes();
-		LCM.AssembleStiffness(m_K, m_F, m_u, en, lmi, lmj, ke);
+		DeferAssembly(ke);
 	}
-	} // omp critical
+}
+
+//-----------------------------------------------------------------------------
+void FELinearSystem::BeginColoredAssembly()
+{
+	// When called from a task that runs concurrently with other tasks (see FETaskList), 
+	// the element loop is not split over threads, but other tasks may still assemble
+	// into the same matrix. We then simply keep using the atomic assembly.
+	if (omp_in_parallel()) return;
+
+	assert(m_bcolored == false);
+	m_bcolored = true;
+	SparseMatrix& K = m_K;
+	K.SetAtomicAssembly(false);
+}
+
+//-----------------------------------------------------------------------------
+void FELinearSystem::EndColoredAssembly()
+{
+	if (omp_in_parallel()) return;
+
+	assert(m_bcolored);
+	m_bcolored = false;
+	SparseMatrix& K = m_K;
+	K.SetAtomicAssembly(true);
+
+	// assemble all the contributions that were buffered during the colored pass
+	FlushDeferred();
+}
+
+//-----------------------------------------------------------------------------
+void FELinearSystem::FlushDeferred()
+{
+	assert(omp_in_parallel() == 0);
+	for (size_t i = 0; i < m_deferred.size(); ++i)
+	{
+		vector<FEElementMatrix>& buf = m_deferred[i];
+		for (size_t j = 0; j < buf.size(); ++j) AssembleDeferred(buf[j]);
+		buf.clear();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FELinearSystem::DeferAssembly(const FEElementMatrix& ke)
+{
+	// During a colored pass, the global matrix is not updated atomically, so the 
+	// contributions must always be buffered. The colored pass is only started outside
+	// of a parallel region, so the OpenMP thread number identifies the thread.
+	if (m_bcolored)
+	{
+		m_deferred[omp_get_thread_num()].push_back(ke);
+		return;
+	}
+
+	// no other threads are assembling, so we can do this right away
+	if (omp_in_parallel() == 0)
+	{
+		AssembleDeferred(ke);
+		return;
+	}
+
+	int n = ThreadBufferIndex();
+	if (n < (int)m_deferred.size()) m_deferred[n].push_back(ke);
+	else
+	{
+		// This thread has no buffer (e.g. threads of nested parallel regions)
+#pragma omp critical
+		AssembleDeferred(ke);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// assemble the linear constraint contributions
+void FELinearSystem::AssembleDeferred(const FEElementMatrix& ke)
+{
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	LCM.AssembleStiffness(m_K, m_F, m_u, ke.Nodes(), ke.RowIndices(), ke.ColumnsIndices(), ke);
 }
 
 //-----------------------------------------------------------------------------
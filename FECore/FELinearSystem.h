@@ -56,6 +56,9 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+	// Get the sparse matrix that stores the global stiffness matrix
+	SparseMatrix& GetSparseMatrix();
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -69,10 +72,40 @@ public:
 	// This assembles a vetor to the RHS
 	void AssembleRHS(vector<int>& lm, vector<double>& fe);
 
+public:
+	// Start a colored assembly pass. During this pass, the caller guarantees that 
+	// element matrices that are assembled concurrently never share a node (see FEDomain::ElementColors).
+	// The global matrix is then updated without atomics, and contributions that couple to
+	// equations outside of the element (e.g. linear constraints) are buffered per thread.
+	// Inside an active parallel region (i.e. when called from a concurrent task) this does nothing.
+	void BeginColoredAssembly();
+
+	// Ends the colored assembly pass and assembles the buffered contributions.
+	void EndColoredAssembly();
+
+	// Are we inside a colored assembly pass?
+	bool ColoredAssembly() const { return m_bcolored; }
+
+	// Assemble the contributions that were buffered by concurrent assembly calls.
+	// This must be called outside of a parallel region. It is also called by the destructor.
+	void FlushDeferred();
+
+protected:
+	// Assemble the non-local contributions of the element matrix (e.g. linear constraints).
+	// Outside of a parallel region this is done right away. Otherwise, a copy of the element
+	// matrix is stored in a buffer of the calling thread and assembled in FlushDeferred.
+	void DeferAssembly(const FEElementMatrix& ke);
+
+	// Assemble the contributions of a deferred element matrix that were skipped during the colored pass.
+	virtual void AssembleDeferred(const FEElementMatrix& ke);
+
 protected:
 	bool			m_bsymm;	//!< symmetry flag
 	FESolver*		m_solver;
 	FEGlobalMatrix& m_K;	//!< The global stiffness matrix
 	vector<double>&	m_F;	//!< Contributions from prescribed degrees of freedom
 	vector<double>&	m_u;	//!< the array with prescribed values
+
+	bool	m_bcolored;		//!< colored assembly flag
+	vector< vector<FEElementMatrix> >	m_deferred;	//!< deferred element matrices (one list per thread)
 };
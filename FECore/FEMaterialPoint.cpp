@@ -29,8 +29,28 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEMaterialPoint.h"
 #include "DumpStream.h"
+#include "FEMaterialPointPool.h"
 #include <string.h>
 
+void* FEMaterialPoint::operator new(size_t size)
+{
+	return FEMaterialPointPool::Allocate(size);
+}
+
+void FEMaterialPoint::operator delete(void* p)
+{
+	FEMaterialPointPool::Deallocate(p);
+}
+
+int FEMaterialPointNewTypeID()
+{
+	static int ntypes = 0;
+	int id;
+#pragma omp critical (FEMaterialPointNewTypeID)
+	id = ntypes++;
+	return id;
+}
+
 FEMaterialPoint::FEMaterialPoint(FEMaterialPoint* ppt)
 {
 	m_pPrev = 0;
@@ -50,6 +50,10 @@ public:
 	FEMaterialPoint(FEMaterialPoint* ppt = 0);
 	virtual ~FEMaterialPoint();
 
+	// Material point data is allocated via the material point pool (see FEMaterialPointPool)
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+
 public:
 	//! The init function is used to intialize data
 	virtual void Init();
@@ -103,6 +107,18 @@ protected:
 	FEMaterialPoint*	m_pPrev;	//<! previous data in the list
 };
 
+//-----------------------------------------------------------------------------
+// Material point classes are assigned a type ID on first use. The IDs are used to
+// look up cached material point data (see FEDomain::MaterialPointData).
+// NOTE: The ID of a class is not necessarily the same in different modules.
+FECORE_API int FEMaterialPointNewTypeID();
+
+template <class T> int FEMaterialPointTypeID()
+{
+	static int id = FEMaterialPointNewTypeID();
+	return id;
+}
+
 //-----------------------------------------------------------------------------
 template <class T> inline T* FEMaterialPoint::ExtractData()
 {
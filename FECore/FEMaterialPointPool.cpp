@@ -0,0 +1,150 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEMaterialPointPool.h"
+#include <assert.h>
+#include <new>
+
+//-----------------------------------------------------------------------------
+// Each allocation is preceded by a header that stores the pool the memory came 
+// from (or nullptr when the memory was allocated on the heap). The header size
+// keeps the data aligned to 16 bytes.
+const size_t HEADER_SIZE = 16;
+
+// the pool that is active for this thread
+static thread_local FEMaterialPointPool* activePool = nullptr;
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::FEMaterialPointPool()
+{
+	m_block = 0;
+	m_used = 0;
+	m_live = 0;
+	m_released = false;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::~FEMaterialPointPool()
+{
+	assert(m_live == 0);
+	for (size_t i = 0; i < m_blocks.size(); ++i) delete [] m_blocks[i];
+	m_blocks.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::Reset()
+{
+	if (m_live == 0)
+	{
+		m_block = 0;
+		m_used = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::Release()
+{
+	if (activePool == this) activePool = nullptr;
+
+	bool bdelete = false;
+#pragma omp critical (FEMaterialPointPool)
+	{
+		m_released = true;
+		bdelete = (m_live == 0);
+	}
+	if (bdelete) delete this;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::SetActive(FEMaterialPointPool* pool)
+{
+	assert((pool == nullptr) || (pool->m_released == false));
+	activePool = pool;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointPool::allocate(size_t size)
+{
+	// see if it fits in the current block, otherwise move on to the next block
+	if (m_blocks.empty() || (m_used + size > BLOCK_SIZE))
+	{
+		if (m_blocks.empty() == false) m_block++;
+		if (m_block >= m_blocks.size()) m_blocks.push_back(new char[BLOCK_SIZE]);
+		m_used = 0;
+	}
+
+	char* p = m_blocks[m_block] + m_used;
+	m_used += size;
+
+#pragma omp critical (FEMaterialPointPool)
+	m_live++;
+
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::deallocate()
+{
+	bool bdelete = false;
+#pragma omp critical (FEMaterialPointPool)
+	{
+		assert(m_live > 0);
+		m_live--;
+		bdelete = (m_released && (m_live == 0));
+	}
+	if (bdelete) delete this;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointPool::Allocate(size_t size)
+{
+	// round up to a multiple of the header size to keep the data aligned
+	size_t n = HEADER_SIZE + ((size + HEADER_SIZE - 1) / HEADER_SIZE)*HEADER_SIZE;
+
+	// large allocations are never pooled
+	FEMaterialPointPool* pool = activePool;
+	if (n > BLOCK_SIZE / 16) pool = nullptr;
+
+	char* p = nullptr;
+	if (pool) p = (char*)pool->allocate(n);
+	else p = (char*)::operator new(n);
+
+	*((FEMaterialPointPool**)p) = pool;
+	return p + HEADER_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::Deallocate(void* pd)
+{
+	if (pd == nullptr) return;
+
+	char* p = (char*)pd - HEADER_SIZE;
+	FEMaterialPointPool* pool = *((FEMaterialPointPool**)p);
+	if (pool) pool->deallocate();
+	else ::operator delete(p);
+}
@@ -0,0 +1,80 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//! The material point pool allocates material point data in large blocks. 
+//! A domain activates its pool while it creates the material point data of its 
+//! elements, so that the data of consecutive integration points is stored next to 
+//! each other in memory instead of being scattered over the heap.
+//!
+//! Memory is not returned to the pool when a material point is deleted. Instead, the
+//! pool counts the number of live material points, and the memory can be reused (see Reset)
+//! or is freed (see Release) once all the material points of the pool have been deleted. 
+class FECORE_API FEMaterialPointPool
+{
+	enum { BLOCK_SIZE = 1048576 };
+
+public:
+	FEMaterialPointPool();
+
+	//! Reset the pool so that its memory can be reused. This is only done
+	//! when the pool no longer has any live material points.
+	void Reset();
+
+	//! Release the pool. The pool is deleted as soon as all of its material points are deleted.
+	void Release();
+
+	//! Activate a pool for the calling thread. While a pool is active, all the material
+	//! point data that is created by this thread is allocated from this pool.
+	//! Pass nullptr to deactivate the pool.
+	static void SetActive(FEMaterialPointPool* pool);
+
+public:
+	//! allocate memory for material point data (called by FEMaterialPoint::operator new)
+	static void* Allocate(size_t size);
+
+	//! deallocate memory for material point data (called by FEMaterialPoint::operator delete)
+	static void Deallocate(void* p);
+
+private:
+	~FEMaterialPointPool();
+
+	void* allocate(size_t size);
+	void deallocate();
+
+private:
+	std::vector<char*>	m_blocks;	//!< allocated memory blocks
+	size_t	m_block;		//!< index of current block
+	size_t	m_used;			//!< number of bytes used in current block
+	int		m_live;			//!< number of live material points
+	bool	m_released;		//!< pool was released by its owner
+};
@@ -67,6 +67,7 @@ FEDataMap* CreateDataMap(int mapType)
 FEMesh::FEMesh(FEModel* fem) : m_fem(fem)
 {
 	m_LUT = 0;
+	m_geomRev = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -88,6 +89,9 @@ void FEMesh::Serialize(DumpStream& ar)
 	// clear the mesh if we are loading from an archive
 	if ((ar.IsShallow() == false) && (ar.IsLoading())) Clear();
 
+	// the nodal positions will be overwritten
+	if (ar.IsLoading()) GeometryChanged();
+
 	// we don't want to store pointers to all the nodes
 	// mostly for efficiency, so we tell the archive not to store the pointers
 	ar.LockPointerTable();
@@ -395,6 +399,7 @@ void FEMesh::Reset()
 
 	// update the mesh
 	UpdateBox();
+	GeometryChanged();
 
 	// reset domain data
 	for (int n=0; n<(int) m_Domain.size(); ++n) m_Domain[n]->Reset();
@@ -867,10 +872,22 @@ FEElement* FEElementLUT::Find(int nid)
 // update the domains of the mesh
 void FEMesh::Update(const FETimeInfo& tp)
 {
+	// The mesh is updated after the nodes have moved
+	GeometryChanged();
+
+	// NOTE: The domains are updated one at a time, since the domains
+	// parallelize the loops over their elements themselves.
 	for (int i = 0; i<Domains(); ++i)
 	{
 		FEDomain& dom = Domain(i);
-		if (dom.IsActive()) dom.Update(tp);
+		if (dom.IsActive())
+		{
+			// evaluate the cached kinematics first, so that the domain update can use it too
+			FESolidDomain* solidDomain = dynamic_cast<FESolidDomain*>(&dom);
+			if (solidDomain && solidDomain->KinematicsCache()) solidDomain->UpdateKinematicsCache(tp.alphaf);
+
+			dom.Update(tp);
+		}
 	}
 }
 
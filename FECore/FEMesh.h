@@ -244,6 +244,13 @@ public:
 	// update the domains of the mesh
 	void Update(const FETimeInfo& tp);
 
+	// The geometry revision is incremented each time the nodes (may) have moved. 
+	// Data that is evaluated from the current nodal positions can use this to check if it's still valid.
+	int GeometryRevision() const { return m_geomRev; }
+
+	// call this when the nodal positions are changed
+	void GeometryChanged() { m_geomRev++; }
+
 public: // data maps
 	void ClearDataMaps();
 	void AddDataMap(FEDataMap* map);
@@ -277,6 +284,8 @@ private:
 	FEElementLUT*	m_LUT;
 
 	FEModel*	m_fem;
+
+	int		m_geomRev;	//!< geometry revision
 private:
 	//! hide the copy constructor
 	FEMesh(FEMesh& m){}
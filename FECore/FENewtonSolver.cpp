@@ -39,6 +39,7 @@ SOFTWARE.*/
 #include "FEDomain.h"
 #include "DumpStream.h"
 #include "FELinearSystem.h"
+#include "FESolutionHistory.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -107,6 +108,9 @@ FENewtonSolver::FENewtonSolver(FEModel* pfem) : FESolver(pfem)
 	m_force_partition = 0;
 	m_breformtimestep = true;
 	m_breformAugment = false;
+
+	m_initialGuess = nullptr;
+	m_history = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -584,11 +588,36 @@ bool FENewtonSolver::SolveStep()
 		feLog("\nconvergence summary\n");
 		feLog("    number of iterations   : %d\n", m_niter);
 		feLog("    number of reformations : %d\n", m_nref);
+
+		// store the converged solution
+		if (m_history)
+		{
+			FEModel& fem = *GetFEModel();
+			m_history->Store(fem.GetCurrentStepIndex(), fem.GetTime().currentTime, m_Ut);
+		}
 	}
 
 	return bret;
 }
 
+//-----------------------------------------------------------------------------
+const std::vector<double>* FENewtonSolver::GetInitialGuess()
+{
+	if (m_initialGuess == nullptr) return nullptr;
+
+	FEModel& fem = *GetFEModel();
+	FETimeInfo& tp = fem.GetTime();
+
+	// the time points must match within a small fraction of the time step
+	double tol = 1e-6*tp.timeIncrement;
+	const std::vector<double>* U = m_initialGuess->Find(fem.GetCurrentStepIndex(), tp.currentTime, tol);
+
+	// make sure the equations match
+	if (U && ((int)U->size() != m_neq)) return nullptr;
+
+	return U;
+}
+
 //-----------------------------------------------------------------------------
 bool FENewtonSolver::Quasin()
 {
@@ -620,7 +649,7 @@ bool FENewtonSolver::Quasin()
 		double ls = QNSolve();
 
 		// update solution vector
-		for (int i = 0; i<m_neq; ++i) m_Ui[i] += ls*m_ui[i];
+		vadds(m_Ui, m_ui, ls);
 
 		feLog(" Nonlinear solution status: time= %lg\n", tp.currentTime);
 		feLog("\tstiffness updates             = %d\n", m_qnstrategy->m_nups);
@@ -1056,7 +1085,9 @@ void FENewtonSolver::Update(std::vector<double>& ui)
 
 	// update nodes
 	vector<double> U(m_Ut.size());
-	for (size_t i = 0; i<m_Ut.size(); ++i) U[i] = ui[i] + m_Ui[i] + m_Ut[i];
+	const int neq = (int)m_Ut.size();
+	#pragma omp parallel for if (neq >= VEC_PARALLEL_MIN)
+	for (int i = 0; i<neq; ++i) U[i] = ui[i] + m_Ui[i] + m_Ut[i];
 
 	// scatter solution to nodes
 	for (int i = 0; i < m_solutionNorm.size(); ++i)
@@ -1113,7 +1144,9 @@ void FENewtonSolver::Update2(const vector<double>& ui)
 
 	// total displacements
 	vector<double> U(m_Ut.size());
-	for (size_t i = 0; i<m_Ut.size(); ++i) U[i] = ui[i] + m_Ui[i] + m_Ut[i];
+	const int neq = (int)m_Ut.size();
+	#pragma omp parallel for if (neq >= VEC_PARALLEL_MIN)
+	for (int i = 0; i<neq; ++i) U[i] = ui[i] + m_Ui[i] + m_Ut[i];
 
 	// scatter solution to nodes
 	for (int i = 0; i < m_solutionNorm.size(); ++i)
@@ -37,6 +37,7 @@ SOFTWARE.*/
 class FEModel;
 class FEGlobalMatrix;
 class FELinearSystem;
+class FESolutionHistory;
 
 //-----------------------------------------------------------------------------
 enum QN_STRATEGY
@@ -173,6 +174,13 @@ public:
 	//! This is called from SolveStep.
 	virtual bool Quasin();
 
+	//! Set the solution history that provides the initial guesses of the time steps (null turns this off).
+	//! Only derived solvers that use GetInitialGuess after PrepStep support this.
+	void SetInitialGuess(const FESolutionHistory* guess) { m_initialGuess = guess; }
+
+	//! Set the solution history where the converged solutions are stored (null turns this off)
+	void SetSolutionHistory(FESolutionHistory* history) { m_history = history; }
+
     //! calculates the global stiffness matrix (needs to be overwritten by derived classes)
     virtual bool StiffnessMatrix();
 
@@ -209,6 +217,10 @@ public:
 protected:
 	bool AllocateLinearSystem();
 
+	//! returns the initial guess for the total solution vector of the current time step
+	//! or null if there is none
+	const std::vector<double>* GetInitialGuess();
+
 public:
 	// line search options
 	FELineSearch*	m_lineSearch;
@@ -251,6 +263,10 @@ public:
 	vector<double> m_up;	//!< solution increment of previous iteration
 	vector<double> m_Fd;	//!< residual correction due to prescribed degrees of freedom
 
+	// solution history
+	const FESolutionHistory*	m_initialGuess;	//!< initial guesses for time steps (not owned)
+	FESolutionHistory*			m_history;		//!< stores converged solutions (not owned)
+
 public:
 	// obsolete parameters
 	int					m_maxups;		//!< max number of quasi-newton updates
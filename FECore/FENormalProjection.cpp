@@ -35,13 +35,13 @@ FENormalProjection::FENormalProjection(FESurface& s) : m_surf(s)
 {
 	m_tol = 0.0;
 	m_rad = 0.0;
+	m_bvh = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 void FENormalProjection::Init()
 {
-	m_OT.Attach(&m_surf);
-	m_OT.Init(m_tol);
+	m_bvh = &m_surf.UpdateBVH();
 }
 
 //-----------------------------------------------------------------------------
@@ -53,12 +53,12 @@ void FENormalProjection::Init()
 FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
+	vector<int> selist;
+	m_bvh->FindRayCandidates(r, n, m_tol, selist);
 	
 	// now that we found candidate surface elements, lets see if we can find 
 	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	bool found = false;
 	double rsl[2], gl, g;
 	FESurfaceElement* pei = 0;
@@ -97,12 +97,12 @@ FESurfaceElement* FENormalProjection::Project(vec3d r, vec3d n, double rs[2])
 FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
+	vector<int> selist;
+	m_bvh->FindRayCandidates(r, n, m_tol, selist);
 	
 	// now that we found candidate surface elements, lets see if we can find 
 	// those that intersect the ray, then pick the closest intersection
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	bool found = false;
 	double rsl[2], gl, g;
 	FESurfaceElement* pei = 0;
@@ -140,15 +140,15 @@ FESurfaceElement* FENormalProjection::Project2(vec3d r, vec3d n, double rs[2])
 FESurfaceElement* FENormalProjection::Project3(const vec3d& r, const vec3d& n, double rs[2], int* pei)
 {
 	// let's find all the candidate surface elements
-	set<int>selist;
-	m_OT.FindCandidateSurfaceElements(r, n, selist);
+	vector<int> selist;
+	m_bvh->FindRayCandidates(r, n, m_tol, selist);
 
 	double g, gmax = -1e99, r2[2] = {rs[0], rs[1]};
 	int imin = -1;
 	FESurfaceElement* pme = 0;
 
 	// loop over all surface element
-	set<int>::iterator it;
+	vector<int>::iterator it;
 	for (it = selist.begin(); it != selist.end(); ++it)
 	{
 		FESurfaceElement& el = m_surf.Element(*it);
@@ -28,7 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FESurface.h"
-#include "FEOctree.h"
+#include "FESurfaceBVH.h"
 
 //-----------------------------------------------------------------------------
 //! This class calculates the normal projection on to a surface.
@@ -39,7 +39,7 @@ public:
 	//! constructor
 	FENormalProjection(FESurface& s);
 
-	// initialization
+	// initialization (builds or refits the surface's search tree)
 	void Init();
 
 	void SetTolerance(double tol) { m_tol = tol; }
@@ -60,5 +60,5 @@ private:
 
 private:
 	FESurface&	m_surf;	//!< the target surface
-	FEOctree	m_OT;	//!< used to optimize ray-surface intersections
+	const FESurfaceBVH*	m_bvh;	//!< used to optimize ray-surface intersections
 };
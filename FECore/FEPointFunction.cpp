@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEPointFunction.h"
 #include "DumpStream.h"
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 BEGIN_FECORE_CLASS(FEPointFunction, FEFunction1D)
@@ -41,6 +42,24 @@ END_FECORE_CLASS();
 //! default constructor
 FEPointFunction::FEPointFunction(FEModel* fem) : FEFunction1D(fem), m_fnc(LINEAR), m_ext(CONSTANT)
 {
+	m_cursor.store(0, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+FEPointFunction::FEPointFunction(const FEPointFunction& f) : FEFunction1D(f), m_fnc(f.m_fnc), m_ext(f.m_ext), m_points(f.m_points)
+{
+	m_cursor.store(0, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+FEPointFunction& FEPointFunction::operator = (const FEPointFunction& f)
+{
+	FEFunction1D::operator = (f);
+	m_fnc = f.m_fnc;
+	m_ext = f.m_ext;
+	m_points = f.m_points;
+	m_cursor.store(0, std::memory_order_relaxed);
+	return *this;
 }
 
 //-----------------------------------------------------------------------------
@@ -92,12 +111,10 @@ LOADPOINT FEPointFunction::LoadPoint(int i) const
 void FEPointFunction::Add(double x, double y)
 {
 	// find the place to insert the data point
-	int n = 0;
-	int nsize = Points();
-	while ((n<nsize) && (m_points[n].x() < x)) ++n;
+	std::vector<vec2d>::iterator it = std::lower_bound(m_points.begin(), m_points.end(), x, [](const vec2d& p, double x) { return p.x() < x; });
 
 	// insert loadpoint
-	m_points.insert(m_points.begin() + n, vec2d(x, y));
+	m_points.insert(it, vec2d(x, y));
 }
 
 //-----------------------------------------------------------------------------
@@ -127,6 +144,31 @@ inline double qerp(double t, double t0, double f0, double t1, double f1, double
 	return f0*q0 + f1*q1 + f2*q2;
 }
 
+//-----------------------------------------------------------------------------
+// Returns the index n of the first point for which x > t. This assumes that t lies
+// inside the domain of the function, so that 0 < n < Points().
+// Since functions are usually evaluated at (slowly) increasing times, we first check 
+// the segment that was found in the last call, and the one after that, before 
+// doing a binary search.
+// The cursor is only a hint (it is validated before it is used), but since the
+// function can be evaluated from several threads at once, it is accessed atomically.
+int FEPointFunction::FindSegment(double t) const
+{
+	const int N = (int)m_points.size();
+	int n = m_cursor.load(std::memory_order_relaxed);
+	if ((n > 0) && (n < N) && (m_points[n - 1].x() <= t))
+	{
+		if (t < m_points[n].x()) return n;
+		if ((n + 1 < N) && (t < m_points[n + 1].x())) { m_cursor.store(n + 1, std::memory_order_relaxed); return n + 1; }
+	}
+
+	std::vector<vec2d>::const_iterator it = std::upper_bound(m_points.begin(), m_points.end(), t, [](double t, const vec2d& p) { return t < p.x(); });
+	n = (int)(it - m_points.begin());
+	m_cursor.store(n, std::memory_order_relaxed);
+	return n;
+}
+
+//-----------------------------------------------------------------------------
 double FEPointFunction::value(double time) const
 {
 	int nsize = Points();
@@ -143,8 +185,7 @@ double FEPointFunction::value(double time) const
 
 	if (m_fnc == LINEAR)
 	{
-		int n = 0;
-		while (m_points[n].x() <= time) ++n;
+		int n = FindSegment(time);
 
 		double t0 = m_points[n - 1].x();
 		double t1 = m_points[n    ].x();
@@ -156,8 +197,7 @@ double FEPointFunction::value(double time) const
 	}
 	else if (m_fnc == STEP)
 	{
-		int n = 0;
-		while (m_points[n].x() <= time) ++n;
+		int n = FindSegment(time);
 
 		return m_points[n].y();
 	}
@@ -187,8 +227,7 @@ double FEPointFunction::value(double time) const
 		}
 		else
 		{
-			int n = 0;
-			while (m_points[n].x() <= time) ++n;
+			int n = FindSegment(time);
 
 			if (n == 1)
 			{
@@ -331,11 +370,8 @@ int FEPointFunction::FindPoint(double t, double& tval, int startIndex)
 	default:
 		if (startIndex < 0) startIndex = 0;
 		if (startIndex >= Points()) return -1;
-		for (int i = startIndex; i<Points(); ++i)
-		{
-			double ti = m_points[i].x();
-			if (ti > t) { tval = ti; return i; }
-		}
+		std::vector<vec2d>::const_iterator it = std::upper_bound(m_points.begin() + startIndex, m_points.end(), t, [](double t, const vec2d& p) { return t < p.x(); });
+		if (it != m_points.end()) { tval = it->x(); return (int)(it - m_points.begin()); }
 	}
 	return -1;
 }
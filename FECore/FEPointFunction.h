@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEFunction1D.h"
 
 #include <vector>
+#include <atomic>
 
 //-----------------------------------------------------------------------------
 class DumpStream;
@@ -61,6 +62,10 @@ public:
 	//! default constructor
 	FEPointFunction(FEModel* fem);
 
+	//! copy constructor and assignment (the cursor is not copied)
+	FEPointFunction(const FEPointFunction& f);
+	FEPointFunction& operator = (const FEPointFunction& f);
+
 	//! destructor
 	virtual ~FEPointFunction();
 
@@ -111,6 +116,8 @@ public: // implement from base class
 protected:
 	double ExtendValue(double t) const;
 
+	//! find the index of the first point whose x-value is larger than t
+	int FindSegment(double t) const;
 
 	// TODO: I need to make this public so the parameters can be mapped to the FELoadCurve
 public:
@@ -118,6 +125,9 @@ public:
 	int		m_ext;	//!< extend mode
 	std::vector<vec2d>	m_points;
 
+private:
+	mutable std::atomic<int>	m_cursor;	//!< segment that was found in the last call to FindSegment
+
 	DECLARE_FECORE_CLASS();
 };
 
@@ -159,7 +159,16 @@ FEScalarValuator* FEMathValue::copy()
 
 double FEMathValue::operator()(const FEMaterialPoint& pt)
 {
-	std::vector<double> var(4 + m_vars.size());
+	// This is called for each integration point, so we avoid allocating the variable array
+	// on the heap. Note that mapped parameters can evaluate other math values while
+	// we fill the array, so we cannot share one buffer between calls.
+	const int MAX_VARS = 16;
+	double buf[MAX_VARS];
+	std::vector<double> tmp;
+	double* var = buf;
+	int nvar = 4 + (int)m_vars.size();
+	if (nvar > MAX_VARS) { tmp.resize(nvar); var = &tmp[0]; }
+
 	var[0] = pt.m_r0.x;
 	var[1] = pt.m_r0.y;
 	var[2] = pt.m_r0.z;
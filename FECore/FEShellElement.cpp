@@ -50,6 +50,7 @@ FEShellElement::FEShellElement(const FEShellElement& el)
 	m_lm = el.m_lm;
 	m_val = el.m_val;
 	m_status = el.m_status;
+	m_bconstrained = el.m_bconstrained;
 
 	// copy shell data
 	m_h0 = el.m_h0;
@@ -75,6 +76,7 @@ FEShellElement& FEShellElement::operator = (const FEShellElement& el)
 	m_lm = el.m_lm;
 	m_val = el.m_val;
 	m_status = el.m_status;
+	m_bconstrained = el.m_bconstrained;
 
 	// copy shell data
 	m_h0 = el.m_h0;
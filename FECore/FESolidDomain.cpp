@@ -41,6 +41,102 @@ FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m
     m_dofSU.AddDof(pfem->GetDOFIndex("sx"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sy"));
 	m_dofSU.AddDof(pfem->GetDOFIndex("sz"));
+
+	m_bkinCache = false;
+	m_kinRev = -1;
+	m_kinAlpha = 1.0;
+}
+
+//-----------------------------------------------------------------------------
+void FESolidDomain::SetKinematicsCache(bool b)
+{
+	m_bkinCache = b;
+	m_kinRev = -1;
+	if (b == false)
+	{
+		m_kinData.clear();
+		m_kinOffset.clear();
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Evaluates the Jacobian determinant, the inverse Jacobian and the spatial shape
+//! function gradients at all integration points at the configuration alpha. 
+//! The cached data remains valid until the mesh geometry revision changes. 
+void FESolidDomain::UpdateKinematicsCache(double alpha)
+{
+	// invalidate the cache so that invjact evaluates the data
+	m_kinRev = -1;
+	if (m_bkinCache == false) return;
+
+	// setup the offsets
+	int NE = Elements();
+	m_kinOffset.resize(NE + 1);
+	m_kinOffset[0] = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		m_kinOffset[i + 1] = m_kinOffset[i] + el.GaussPoints()*(10 + 3*el.Nodes());
+	}
+	m_kinData.resize(m_kinOffset[NE]);
+
+	// evaluate the data
+	bool bok = true;
+#pragma omp parallel for shared(bok)
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+		double* d = &m_kinData[m_kinOffset[i]];
+		for (int n = 0; n < nint; ++n, d += 10 + 3*neln)
+		{
+			double Ji[3][3];
+			try {
+				d[0] = (alpha == 1.0 ? invjact(el, Ji, n) : invjact(el, Ji, n, alpha));
+			}
+			catch (NegativeJacobian&)
+			{
+				// Leave it to the element routines to report this.
+#pragma omp critical
+				bok = false;
+				break;
+			}
+
+			double* J = d + 1;
+			J[0] = Ji[0][0]; J[1] = Ji[0][1]; J[2] = Ji[0][2];
+			J[3] = Ji[1][0]; J[4] = Ji[1][1]; J[5] = Ji[1][2];
+			J[6] = Ji[2][0]; J[7] = Ji[2][1]; J[8] = Ji[2][2];
+
+			double* G = d + 10;
+			const double* Gr = el.Gr(n);
+			const double* Gs = el.Gs(n);
+			const double* Gt = el.Gt(n);
+			for (int j = 0; j < neln; ++j, G += 3)
+			{
+				// note that we need the transposed of Ji, not Ji itself !
+				G[0] = Ji[0][0] * Gr[j] + Ji[1][0] * Gs[j] + Ji[2][0] * Gt[j];
+				G[1] = Ji[0][1] * Gr[j] + Ji[1][1] * Gs[j] + Ji[2][1] * Gt[j];
+				G[2] = Ji[0][2] * Gr[j] + Ji[1][2] * Gs[j] + Ji[2][2] * Gt[j];
+			}
+		}
+	}
+
+	// only mark the cache as valid if all Jacobians were positive
+	if (bok)
+	{
+		m_kinAlpha = alpha;
+		m_kinRev = m_pMesh->GeometryRevision();
+	}
+}
+
+//-----------------------------------------------------------------------------
+const double* FESolidDomain::CachedKinematics(const FESolidElement& el, int n, double alpha) const
+{
+	if ((m_kinRev < 0) || (m_kinAlpha != alpha) || (m_kinRev != m_pMesh->GeometryRevision())) return nullptr;
+	int nel = el.GetLocalID();
+	assert(el.GetMeshPartition() == this);
+	return &m_kinData[m_kinOffset[nel] + n*(10 + 3*el.Nodes())];
 }
 
 //-----------------------------------------------------------------------------
@@ -1145,6 +1241,16 @@ double FESolidDomain::invjac0(const FESolidElement& el, double r, double s, doub
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n)
 {
+	// see if we can use the cached values
+	const double* d = CachedKinematics(el, n, 1.0);
+	if (d)
+	{
+		Ji[0][0] = d[1]; Ji[0][1] = d[2]; Ji[0][2] = d[3];
+		Ji[1][0] = d[4]; Ji[1][1] = d[5]; Ji[1][2] = d[6];
+		Ji[2][0] = d[7]; Ji[2][1] = d[8]; Ji[2][2] = d[9];
+		return d[0];
+	}
+
     // nodal coordinates
     vec3d rt[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, rt);
@@ -1249,6 +1355,16 @@ double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n, const
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjact(FESolidElement& el, double Ji[3][3], int n, const double alpha)
 {
+	// see if we can use the cached values
+	const double* d = CachedKinematics(el, n, alpha);
+	if (d)
+	{
+		Ji[0][0] = d[1]; Ji[0][1] = d[2]; Ji[0][2] = d[3];
+		Ji[1][0] = d[4]; Ji[1][1] = d[5]; Ji[1][2] = d[6];
+		Ji[2][0] = d[7]; Ji[2][1] = d[8]; Ji[2][2] = d[9];
+		return d[0];
+	}
+
     // nodal coordinates
     vec3d rt[FEElement::MAX_NODES];
 	GetCurrentNodalCoordinates(el, rt, alpha);
@@ -2194,6 +2310,16 @@ void FESolidDomain::gradTgradShape(FESolidElement& el, int j, vector<mat3d>& mn)
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH)
 {
+	// see if we can use the cached values
+	const double* d = CachedKinematics(el, n, 1.0);
+	if (d)
+	{
+		const double* G = d + 10;
+		int ne = el.Nodes();
+		for (int i = 0; i<ne; ++i, G += 3) GradH[i] = vec3d(G[0], G[1], G[2]);
+		return d[0];
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJt = invjact(el, Ji, n);
@@ -2219,6 +2345,16 @@ double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH)
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH, const double alpha)
 {
+	// see if we can use the cached values
+	const double* d = CachedKinematics(el, n, alpha);
+	if (d)
+	{
+		const double* G = d + 10;
+		int ne = el.Nodes();
+		for (int i = 0; i<ne; ++i, G += 3) GradH[i] = vec3d(G[0], G[1], G[2]);
+		return d[0];
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJt = invjact(el, Ji, n, alpha);
@@ -2384,11 +2520,10 @@ void FESolidDomain::LoadVector(
 
 	// degrees of freedom per node
 	int dofPerNode = dofList.Size();
-	std::vector<double> val(dofPerNode, 0.0);
 
 	// loop over all the elements
 	int NE = Elements();
-	//#pragma omp parallel for 
+	#pragma omp parallel for 
 	for (int i = 0; i<NE; ++i)
 	{
 		// get the next element
@@ -2398,6 +2533,8 @@ void FESolidDomain::LoadVector(
 		// only consider active elements
 		if (el.isActive()) 
 		{
+			std::vector<double> val(dofPerNode, 0.0);
+
 			// total size of the element vector
 			int ndof = dofPerNode * el.Nodes();
 
@@ -2450,75 +2587,82 @@ void FESolidDomain::LoadVector(
 //-----------------------------------------------------------------------------
 void FESolidDomain::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, FEVolumeMatrixIntegrand f)
 {
-	FEElementMatrix ke;
-
 	int dofPerNode_a = dofList_a.Size();
 	int dofPerNode_b = dofList_b.Size();
 
 	FEMesh& mesh = *GetMesh();
-	vec3d rt[FEElement::MAX_NODES];
 
-	matrix kab(dofPerNode_a, dofPerNode_b);
-
-	int NE = Elements();
-	for (int m = 0; m<NE; ++m)
+	// elements of the same color don't share nodes, so they can be assembled concurrently
+	LS.BeginColoredAssembly();
+	const int NC = ElementColors();
+	for (int ncol = 0; ncol < NC; ++ncol)
 	{
-		// get the element
-		FESolidElement& el = Element(m);
+		const vector<int>& elemList = ElementColor(ncol);
+		int NE = (int)elemList.size();
+		#pragma omp parallel for
+		for (int m = 0; m<NE; ++m)
+		{
+			FEElementMatrix ke;
+			matrix kab(dofPerNode_a, dofPerNode_b);
 
-		// calculate nodal normal tractions
-		int neln = el.Nodes();
+			// get the element
+			FESolidElement& el = Element(elemList[m]);
 
-		// get the element stiffness matrix
-		ke.SetNodes(el.m_node);
-		int ndof_a = dofPerNode_a * neln;
-		int ndof_b = dofPerNode_b * neln;
-		ke.resize(ndof_a, ndof_b);
+			// calculate nodal normal tractions
+			int neln = el.Nodes();
 
-		// calculate element stiffness
-		int nint = el.GaussPoints();
+			// get the element stiffness matrix
+			ke.SetNodes(el.m_node);
+			int ndof_a = dofPerNode_a * neln;
+			int ndof_b = dofPerNode_b * neln;
+			ke.resize(ndof_a, ndof_b);
+
+			// calculate element stiffness
+			int nint = el.GaussPoints();
 
-		// gauss weights
-		double* w = el.GaussWeights();
+			// gauss weights
+			double* w = el.GaussWeights();
 
-		// repeat over integration points
-		ke.zero();
-		for (int n = 0; n<nint; ++n)
-		{
-			FEMaterialPoint& pt = *el.GetMaterialPoint(n);
+			// repeat over integration points
+			ke.zero();
+			for (int n = 0; n<nint; ++n)
+			{
+				FEMaterialPoint& pt = *el.GetMaterialPoint(n);
 
-			// set the shape function values
-			pt.m_shape = el.H(n);
+				// set the shape function values
+				pt.m_shape = el.H(n);
 
-			// calculate stiffness component
-			for (int i = 0; i<neln; ++i)
-				for (int j = 0; j<neln; ++j)
-				{
-					// evaluate integrand
-					kab.zero();
-					f(pt, i, j, kab);
-					ke.adds(dofPerNode_a * i, dofPerNode_b * j, kab, w[n]);
-				}
-		}
+				// calculate stiffness component
+				for (int i = 0; i<neln; ++i)
+					for (int j = 0; j<neln; ++j)
+					{
+						// evaluate integrand
+						kab.zero();
+						f(pt, i, j, kab);
+						ke.adds(dofPerNode_a * i, dofPerNode_b * j, kab, w[n]);
+					}
+			}
 
-		// get the element's LM vector
-		std::vector<int>& lma = ke.RowIndices();
-		std::vector<int>& lmb = ke.ColumnsIndices();
-		lma.assign(ndof_a, -1);
-		lmb.assign(ndof_b, -1);
-		for (int j = 0; j < neln; ++j)
-		{
-			FENode& node = mesh.Node(el.m_node[j]);
-			std::vector<int>& ID = node.m_ID;
+			// get the element's LM vector
+			std::vector<int>& lma = ke.RowIndices();
+			std::vector<int>& lmb = ke.ColumnsIndices();
+			lma.assign(ndof_a, -1);
+			lmb.assign(ndof_b, -1);
+			for (int j = 0; j < neln; ++j)
+			{
+				FENode& node = mesh.Node(el.m_node[j]);
+				std::vector<int>& ID = node.m_ID;
 
-			for (int k = 0; k < dofPerNode_a; ++k)
-				lma[dofPerNode_a*j + k] = ID[dofList_a[k]];
+				for (int k = 0; k < dofPerNode_a; ++k)
+					lma[dofPerNode_a*j + k] = ID[dofList_a[k]];
 
-			for (int k = 0; k < dofPerNode_b; ++k)
-				lmb[dofPerNode_b*j + k] = ID[dofList_b[k]];
-		}
+				for (int k = 0; k < dofPerNode_b; ++k)
+					lmb[dofPerNode_b*j + k] = ID[dofList_b[k]];
+			}
 
-		// assemble element matrix in global stiffness matrix
-		LS.Assemble(ke);
+			// assemble element matrix in global stiffness matrix
+			LS.Assemble(ke);
+		}
 	}
+	LS.EndColoredAssembly();
 }
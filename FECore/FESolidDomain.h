@@ -244,6 +244,22 @@ public:
 	//! get the nodal coordinates at previous state
 	void GetPreviousNodalCoordinates(const FESolidElement& el, vec3d* rp);
 
+public:
+	//! Enable or disable the kinematics cache. When enabled, the Jacobian determinant, inverse Jacobian and 
+	//! spatial shape function gradients are stored at all integration points each time the mesh is updated, 
+	//! and invjact and ShapeGradient return the stored values until the nodes move again.
+	void SetKinematicsCache(bool b);
+
+	//! is the kinematics cache enabled
+	bool KinematicsCache() const { return m_bkinCache; }
+
+	//! re-evaluate the kinematics cache at the intermediate configuration alpha
+	void UpdateKinematicsCache(double alpha);
+
+protected:
+	//! returns the cached data of integration point n, or null if the cache is not valid for alpha
+	const double* CachedKinematics(const FESolidElement& el, int n, double alpha) const;
+
 public:
 	//! loop over elements
 	void ForEachSolidElement(std::function<void(FESolidElement& el)> f);
@@ -272,4 +288,11 @@ protected:
 
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
+
+private:
+	bool			m_bkinCache;	//!< kinematics cache flag
+	int				m_kinRev;		//!< geometry revision of the cached data
+	double			m_kinAlpha;		//!< the configuration (alpha) of the cached data
+	vector<double>	m_kinData;		//!< cached detJt, Ji and G for all integration points
+	vector<int>		m_kinOffset;	//!< offset into m_kinData for each element
 };
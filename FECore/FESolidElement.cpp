@@ -46,6 +46,7 @@ FESolidElement::FESolidElement(const FESolidElement& el)
 	m_lm = el.m_lm;
 	m_val = el.m_val;
 	m_status = el.m_status;
+	m_bconstrained = el.m_bconstrained;
 }
 
 FESolidElement& FESolidElement::operator = (const FESolidElement& el)
@@ -62,6 +63,7 @@ FESolidElement& FESolidElement::operator = (const FESolidElement& el)
 	m_lm = el.m_lm;
 	m_val = el.m_val;
 	m_status = el.m_status;
+	m_bconstrained = el.m_bconstrained;
 
 	return (*this);
 }
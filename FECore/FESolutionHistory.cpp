@@ -0,0 +1,75 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FESolutionHistory.h"
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+FESolutionHistory::FESolutionHistory()
+{
+	m_last = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FESolutionHistory::Clear()
+{
+	m_state.clear();
+	m_last = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FESolutionHistory::Store(int nstep, double time, const std::vector<double>& U)
+{
+	STATE s;
+	s.nstep = nstep;
+	s.time = time;
+	s.U = U;
+	m_state.push_back(s);
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<double>* FESolutionHistory::Find(int nstep, double time, double tol) const
+{
+	// States are usually requested in the order they were stored, so we start
+	// looking where the last search ended.
+	int N = (int) m_state.size();
+	for (int i = 0; i < N; ++i)
+	{
+		int n = (m_last + i) % N;
+		const STATE& s = m_state[n];
+		if ((s.nstep == nstep) && (fabs(s.time - time) <= tol))
+		{
+			m_last = n;
+			return &s.U;
+		}
+	}
+	return nullptr;
+}
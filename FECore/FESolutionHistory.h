@@ -0,0 +1,67 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <vector>
+#include "fecore_api.h"
+
+//-----------------------------------------------------------------------------
+//! This class stores the converged solution vectors of an analysis, for each
+//! step and time point. It can be used to provide initial guesses for another 
+//! analysis of the same model (e.g. with slightly different parameters).
+class FECORE_API FESolutionHistory
+{
+	struct STATE
+	{
+		int		nstep;				//!< analysis step index
+		double	time;				//!< time of converged state
+		std::vector<double>	U;		//!< total solution vector
+	};
+
+public:
+	FESolutionHistory();
+
+	//! clear all stored states
+	void Clear();
+
+	//! number of stored states
+	int States() const { return (int) m_state.size(); }
+
+	//! store the converged solution vector for the given step and time
+	void Store(int nstep, double time, const std::vector<double>& U);
+
+	//! find the solution vector for the given step and time. Time points that are
+	//! within tol of time are considered a match. Returns null if none is found.
+	const std::vector<double>* Find(int nstep, double time, double tol) const;
+
+private:
+	std::vector<STATE>	m_state;
+	mutable int			m_last;		//!< index of last state that was found
+};
@@ -45,6 +45,7 @@ BEGIN_FECORE_CLASS(FESolver, FECoreBase)
 	ADD_PARAMETER(m_eq_scheme, "equation_scheme");
 	ADD_PARAMETER(m_eq_order , "equation_order" );
 	ADD_PARAMETER(m_bwopt    , "optimize_bw");
+	ADD_PARAMETER(m_bscatter , "scatter_maps");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -61,6 +62,7 @@ FESolver::FESolver(FEModel* fem) : FECoreBase(fem)
 	m_neq = 0;
 
 	m_bwopt = 0;
+	m_bscatter = true;
 
 	m_eq_scheme = EQUATION_SCHEME::STAGGERED;
 	m_eq_order = EQUATION_ORDER::NORMAL_ORDER;
@@ -481,6 +483,9 @@ bool FESolver::InitEquations()
     m_neq = neq;
 
 	assert(m_dofMap.size() == m_neq);
+
+	// classify the elements for assembly
+	InitElementFlags();
     
     // All initialization is done
     return true;
@@ -672,6 +677,9 @@ bool FESolver::InitEquations2()
 
 	assert(m_dofMap.size() == m_neq);
 
+	// classify the elements for assembly
+	InitElementFlags();
+
 	// All initialization is done
 	return true;
 }
@@ -684,6 +692,36 @@ void FESolver::AddEquations(int neq, int partition)
 	m_part[partition] += neq;
 }
 
+//-----------------------------------------------------------------------------
+//! Flag the elements that have at least one node with a linearly constrained dof
+//! or a node that is attached to a rigid body. The linear system only needs to 
+//! process the constraints for these elements during assembly. This must be called
+//! after the rigid nodes and the linear constraint table are set up, which is the
+//! case when the equations are initialized. 
+void FESolver::InitElementFlags()
+{
+	FEModel& fem = *GetFEModel();
+	FEMesh& mesh = fem.GetMesh();
+	FELinearConstraintManager& LCM = fem.GetLinearConstraintManager();
+	bool blc = (LCM.LinearConstraints() > 0);
+
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		for (int j = 0; j < dom.Elements(); ++j)
+		{
+			FEElement& el = dom.ElementRef(j);
+			bool bc = (blc && LCM.HasConstrainedNodes(el.m_node));
+			for (int k = 0; (k < el.Nodes()) && (bc == false); ++k)
+			{
+				FENode& node = mesh.Node(el.m_node[k]);
+				if ((node.m_rid >= 0) || (node.HasFlags(FENode::SHELL) && node.HasFlags(FENode::RIGID_CLAMP))) bc = true;
+			}
+			el.setConstrained(bc);
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FESolver::Serialize(DumpStream& ar)
 {
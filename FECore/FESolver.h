@@ -112,6 +112,9 @@ public:
 	//! add equations
 	void AddEquations(int neq, int partition = 0);
 
+	//! flag the elements that touch nodes with linearly constrained or rigid dofs
+	void InitElementFlags();
+
 	//! initialize the step (This is called before SolveStep)
 	virtual bool InitStep(double time);
 
@@ -167,6 +170,7 @@ public:
 
 public: //TODO Move these parameters elsewhere
 	int					m_bwopt;	    //!< bandwidth optimization flag
+	bool				m_bscatter;		//!< cache the element scatter maps for assembly (see FEDomain::UpdateScatterMaps)
 	int					m_msymm;		//!< matrix symmetry flag for linear solver allocation
 	int					m_eq_scheme;	//!< equation number scheme (used in InitEquations)
 	int					m_eq_order;		//!< normal or reverse ordering
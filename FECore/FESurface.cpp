@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FEMesh.h"
 #include "FESolidDomain.h"
 #include "FEElemElemList.h"
+#include "FESurfaceBVH.h"
 #include "DumpStream.h"
 #include "matrix.h"
 
@@ -41,17 +42,19 @@ FESurface::FESurface(FEModel* fem) : FEMeshPartition(FE_DOMAIN_SURFACE, fem)
 	m_bitfc = false;
 	m_alpha = 1;
 	m_bshellb = false;
+	m_bvh = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 FESurface::~FESurface()
 {
-
+	delete m_bvh;
 }
 
 //-----------------------------------------------------------------------------
 void FESurface::Create(int nsize, int elemType)
 {
+	delete m_bvh; m_bvh = nullptr;
 	m_el.resize(nsize);
 	for (int i = 0; i < nsize; ++i)
 	{
@@ -185,7 +188,11 @@ FEMaterialPoint* FESurface::CreateMaterialPoint()
 // update surface data
 void FESurface::Update(const FETimeInfo& tp)
 {
-	ForEachSurfaceElement([=](FESurfaceElement& el) {
+	int NE = Elements();
+	#pragma omp parallel for
+	for (int iel = 0; iel < NE; ++iel)
+	{
+		FESurfaceElement& el = Element(iel);
 		int nint = el.GaussPoints();
 		int neln = el.Nodes();
 
@@ -207,7 +214,7 @@ void FESurface::Update(const FETimeInfo& tp)
 				mp.dxs += rt[i] * Gs[i];
 			}
 		}
-	});
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -243,6 +250,9 @@ void FESurface::InitSurface()
 	// allocate node index table
 	m_Node.resize(nn);
 
+	// the search tree needs to be rebuilt
+	delete m_bvh; m_bvh = nullptr;
+
 	// fill the node index table
 	for (int i = 0; i<mesh.Nodes(); ++i)
 	{
@@ -699,6 +709,18 @@ void FESurface::NodalCoordinates(FESurfaceElement& el, vec3d* re)
     else for (int i = 0; i < ne; ++i) re[i] = Node(el.m_lnode[i]).m_st();
 }
 
+//-----------------------------------------------------------------------------
+const FESurfaceBVH& FESurface::UpdateBVH()
+{
+	if (m_bvh == nullptr)
+	{
+		m_bvh = new FESurfaceBVH(this);
+		m_bvh->Build();
+	}
+	else m_bvh->Refit();
+	return *m_bvh;
+}
+
 //-----------------------------------------------------------------------------
 //! This function calculates the projection of x on the surface element el.
 //! It does this by finding the solution of the nonlinear equation (x-y)*y,[a]=0,
@@ -2153,14 +2175,16 @@ void FESurface::LoadVector(FEGlobalVector& R, const FEDofList& dofList, bool bre
 {
 	int dofPerNode = dofList.Size();
 	int order = (dofPerNode == 1 ? dofList.InterpolationOrder(0) : -1);
-	vector<double> fe;
-	vector<int> lm;
-	vec3d re[FEElement::MAX_NODES];
-	std::vector<double> G(dofPerNode, 0.0);
-	FESurfaceDofShape dof_a;
 	int NE = Elements();
+	#pragma omp parallel for
 	for (int i = 0; i < NE; ++i)
 	{
+		vector<double> fe;
+		vector<int> lm;
+		vec3d re[FEElement::MAX_NODES];
+		std::vector<double> G(dofPerNode, 0.0);
+		FESurfaceDofShape dof_a;
+
 		// get the next element
 		FESurfaceElement& el = Element(i);
 
@@ -2170,7 +2194,6 @@ void FESurface::LoadVector(FEGlobalVector& R, const FEDofList& dofList, bool bre
 		fe.assign(ndof, 0.0);
 
 		// get the nodal coordinates
-		FEMesh& mesh = *GetMesh();
 		if (breference)
 			GetReferenceNodalCoordinates(el, re);
 		else
@@ -2223,23 +2246,21 @@ void FESurface::LoadVector(FEGlobalVector& R, const FEDofList& dofList, bool bre
 //-----------------------------------------------------------------------------
 void FESurface::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, FESurfaceMatrixIntegrand f)
 {
-	FEElementMatrix ke;
-
 	int dofPerNode_a = dofList_a.Size();
 	int dofPerNode_b = dofList_b.Size();
 
 	int order_a = (dofPerNode_a == 1 ? dofList_a.InterpolationOrder(0) : -1);
 	int order_b = (dofPerNode_b == 1 ? dofList_b.InterpolationOrder(0) : -1);
 
-	FEMesh& mesh = *GetMesh();
-	vec3d rt[FEElement::MAX_NODES];
-
-	matrix kab(dofPerNode_a, dofPerNode_b);
-	FESurfaceDofShape dof_a, dof_b;
-
 	int NE = Elements();
+	#pragma omp parallel for
 	for (int m = 0; m<NE; ++m)
 	{
+		FEElementMatrix ke;
+		vec3d rt[FEElement::MAX_NODES];
+		matrix kab(dofPerNode_a, dofPerNode_b);
+		FESurfaceDofShape dof_a, dof_b;
+
 		// get the surface element
 		FESurfaceElement& el = Element(m);
 
@@ -40,6 +40,7 @@ class FEMesh;
 class FENodeSet;
 class FEFacetSet;
 class FELinearSystem;
+class FESurfaceBVH;
 
 //-----------------------------------------------------------------------------
 class FECORE_API FESurfaceMaterialPoint : public FEMaterialPoint
@@ -163,6 +164,10 @@ public:
 	//! Get the nodal coordinates of an element
 	void NodalCoordinates(FESurfaceElement& el, vec3d* re);
 
+	//! Get the bounding volume hierarchy of the surface facets. The tree is built on the
+	//! first call. Subsequent calls only refit the tree to the current nodal positions.
+	const FESurfaceBVH& UpdateBVH();
+
 public:
 	//! calculate the surface area of a surface element
 	double FaceArea(FESurfaceElement& el);
@@ -288,4 +293,5 @@ protected:
     bool                        m_bitfc;    //!< interface status
     double                      m_alpha;    //!< intermediate time fraction
 	bool						m_bshellb;	//!< true if this surface is the bottom of a shell domain
+	FESurfaceBVH*				m_bvh;		//!< bounding volume hierarchy, used for searches
 };
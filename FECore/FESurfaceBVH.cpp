@@ -0,0 +1,300 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FESurfaceBVH.h"
+#include "FESurface.h"
+#include "FEMesh.h"
+#include <algorithm>
+#include <float.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// max number of facets in a leaf
+#define BVH_LEAF_SIZE	4
+
+// max depth of the traversal stack. Since the tree is built with median splits
+// it is balanced, so this is more than enough. 
+#define BVH_STACK_SIZE	128
+
+//-----------------------------------------------------------------------------
+// squared distance from a point to a box (zero if the point is inside)
+static double BoxDistance2(const FESurfaceBVH::NODE& node, const vec3d& x)
+{
+	double dx = (x.x < node.cmin.x ? node.cmin.x - x.x : (x.x > node.cmax.x ? x.x - node.cmax.x : 0.0));
+	double dy = (x.y < node.cmin.y ? node.cmin.y - x.y : (x.y > node.cmax.y ? x.y - node.cmax.y : 0.0));
+	double dz = (x.z < node.cmin.z ? node.cmin.z - x.z : (x.z > node.cmax.z ? x.z - node.cmax.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+// see if the (infinite) line through p with direction n intersects the box [a,b]
+static bool LineIntersectsBox(const vec3d& p, const vec3d& n, const vec3d& a, const vec3d& b)
+{
+	double P[3] = { p.x, p.y, p.z };
+	double N[3] = { n.x, n.y, n.z };
+	double A[3] = { a.x, a.y, a.z };
+	double B[3] = { b.x, b.y, b.z };
+	double tmin = -DBL_MAX, tmax = DBL_MAX;
+	for (int i=0; i<3; ++i)
+	{
+		if (N[i] == 0.0)
+		{
+			if ((P[i] < A[i]) || (P[i] > B[i])) return false;
+		}
+		else
+		{
+			double t1 = (A[i] - P[i]) / N[i];
+			double t2 = (B[i] - P[i]) / N[i];
+			if (t1 > t2) { double t = t1; t1 = t2; t2 = t; }
+			if (t1 > tmin) tmin = t1;
+			if (t2 < tmax) tmax = t2;
+			if (tmin > tmax) return false;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FESurfaceBVH::FESurfaceBVH(FESurface* ps)
+{
+	m_ps = ps;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Build()
+{
+	assert(m_ps);
+	m_node.clear();
+	m_facet.clear();
+
+	int NF = m_ps->Elements();
+	if (NF == 0) return;
+
+	// calculate the facet centers, which are used to split the nodes
+	FEMesh& mesh = *m_ps->GetMesh();
+	vector<vec3d> center(NF);
+	for (int i=0; i<NF; ++i)
+	{
+		FESurfaceElement& el = m_ps->Element(i);
+		int ne = el.Nodes();
+		vec3d c(0,0,0);
+		for (int j=0; j<ne; ++j) c += mesh.Node(el.m_node[j]).m_rt;
+		center[i] = c / (double) ne;
+	}
+
+	m_facet.resize(NF);
+	for (int i=0; i<NF; ++i) m_facet[i] = i;
+
+	m_node.reserve(2*(NF / BVH_LEAF_SIZE + 1));
+	m_node.push_back(NODE());
+	BuildNode(0, 0, NF, center);
+
+	// calculate the bounding boxes
+	Refit();
+}
+
+//-----------------------------------------------------------------------------
+// Create the children of a node by splitting its facets at the median of the
+// longest axis of the facet centers. The children are stored next to each other
+// and always after their parent.
+void FESurfaceBVH::BuildNode(int inode, int first, int count, vector<vec3d>& center)
+{
+	m_node[inode].first = first;
+	m_node[inode].count = count;
+	m_node[inode].child = -1;
+	if (count <= BVH_LEAF_SIZE) return;
+
+	// find the extent of the facet centers
+	vec3d cmin = center[m_facet[first]], cmax = cmin;
+	for (int i=first+1; i<first+count; ++i)
+	{
+		const vec3d& c = center[m_facet[i]];
+		if (c.x < cmin.x) cmin.x = c.x;
+		if (c.x > cmax.x) cmax.x = c.x;
+		if (c.y < cmin.y) cmin.y = c.y;
+		if (c.y > cmax.y) cmax.y = c.y;
+		if (c.z < cmin.z) cmin.z = c.z;
+		if (c.z > cmax.z) cmax.z = c.z;
+	}
+	vec3d d = cmax - cmin;
+	int axis = 0;
+	if ((d.y > d.x) && (d.y >= d.z)) axis = 1;
+	else if ((d.z > d.x) && (d.z > d.y)) axis = 2;
+
+	// split at the median
+	int nl = count / 2;
+	vector<int>::iterator it0 = m_facet.begin() + first;
+	nth_element(it0, it0 + nl, it0 + count, [&](int a, int b) {
+		double va = (axis == 0 ? center[a].x : (axis == 1 ? center[a].y : center[a].z));
+		double vb = (axis == 0 ? center[b].x : (axis == 1 ? center[b].y : center[b].z));
+		return (va < vb) || ((va == vb) && (a < b));
+	});
+
+	int child = (int) m_node.size();
+	m_node[inode].child = child;
+	m_node.push_back(NODE());
+	m_node.push_back(NODE());
+	BuildNode(child    , first     , nl        , center);
+	BuildNode(child + 1, first + nl, count - nl, center);
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::FitLeaf(NODE& node)
+{
+	FEMesh& mesh = *m_ps->GetMesh();
+	node.cmin = vec3d(DBL_MAX, DBL_MAX, DBL_MAX);
+	node.cmax = -node.cmin;
+	for (int i=node.first; i<node.first + node.count; ++i)
+	{
+		FESurfaceElement& el = m_ps->Element(m_facet[i]);
+		int ne = el.Nodes();
+		for (int j=0; j<ne; ++j)
+		{
+			const vec3d& r = mesh.Node(el.m_node[j]).m_rt;
+			if (r.x < node.cmin.x) node.cmin.x = r.x;
+			if (r.x > node.cmax.x) node.cmax.x = r.x;
+			if (r.y < node.cmin.y) node.cmin.y = r.y;
+			if (r.y > node.cmax.y) node.cmax.y = r.y;
+			if (r.z < node.cmin.z) node.cmin.z = r.z;
+			if (r.z > node.cmax.z) node.cmax.z = r.z;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::Refit()
+{
+	// children are always stored after their parents, so a reverse
+	// loop visits all children before their parent.
+	for (int i=(int)m_node.size()-1; i>=0; --i)
+	{
+		NODE& node = m_node[i];
+		if (node.child == -1) FitLeaf(node);
+		else
+		{
+			const NODE& a = m_node[node.child];
+			const NODE& b = m_node[node.child + 1];
+			node.cmin.x = (a.cmin.x < b.cmin.x ? a.cmin.x : b.cmin.x);
+			node.cmin.y = (a.cmin.y < b.cmin.y ? a.cmin.y : b.cmin.y);
+			node.cmin.z = (a.cmin.z < b.cmin.z ? a.cmin.z : b.cmin.z);
+			node.cmax.x = (a.cmax.x > b.cmax.x ? a.cmax.x : b.cmax.x);
+			node.cmax.y = (a.cmax.y > b.cmax.y ? a.cmax.y : b.cmax.y);
+			node.cmax.z = (a.cmax.z > b.cmax.z ? a.cmax.z : b.cmax.z);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// If several nodes are at the same distance, the one with the lowest index is returned
+// so that the result does not depend on the traversal order.
+int FESurfaceBVH::FindNearestNode(const vec3d& x, int nodeExclude) const
+{
+	if (m_node.empty()) return -1;
+
+	int imin = -1;
+	double dmin = DBL_MAX;
+
+	int stack[BVH_STACK_SIZE];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+		if (BoxDistance2(node, x) > dmin) continue;
+
+		if (node.child == -1)
+		{
+			for (int i=node.first; i<node.first + node.count; ++i)
+			{
+				FESurfaceElement& el = m_ps->Element(m_facet[i]);
+				int ne = el.Nodes();
+				for (int j=0; j<ne; ++j)
+				{
+					if (el.m_node[j] == nodeExclude) continue;
+					int ln = el.m_lnode[j];
+					vec3d r = m_ps->Node(ln).m_rt;
+					double d = (r - x)*(r - x);
+					if ((d < dmin) || ((d == dmin) && (ln < imin)))
+					{
+						dmin = d;
+						imin = ln;
+					}
+				}
+			}
+		}
+		else
+		{
+			// visit the closest child first
+			int c0 = node.child, c1 = node.child + 1;
+			if (BoxDistance2(m_node[c0], x) < BoxDistance2(m_node[c1], x)) { int c = c0; c0 = c1; c1 = c; }
+			assert(ns + 2 <= BVH_STACK_SIZE);
+			stack[ns++] = c0;
+			stack[ns++] = c1;
+		}
+	}
+
+	return imin;
+}
+
+//-----------------------------------------------------------------------------
+void FESurfaceBVH::FindRayCandidates(const vec3d& p, const vec3d& n, double tol, vector<int>& facetList) const
+{
+	facetList.clear();
+	if (m_node.empty()) return;
+
+	int stack[BVH_STACK_SIZE];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const NODE& node = m_node[stack[--ns]];
+
+		// Inflating each box relative to its own size is conservative since
+		// a parent's box is never smaller than its children's.
+		double d = (node.cmax - node.cmin).norm()*tol;
+		vec3d a = node.cmin - vec3d(d, d, d);
+		vec3d b = node.cmax + vec3d(d, d, d);
+		if (LineIntersectsBox(p, n, a, b) == false) continue;
+
+		if (node.child == -1)
+		{
+			for (int i=node.first; i<node.first + node.count; ++i) facetList.push_back(m_facet[i]);
+		}
+		else
+		{
+			assert(ns + 2 <= BVH_STACK_SIZE);
+			stack[ns++] = node.child;
+			stack[ns++] = node.child + 1;
+		}
+	}
+
+	sort(facetList.begin(), facetList.end());
+}
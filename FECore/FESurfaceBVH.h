@@ -0,0 +1,87 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "vec3d.h"
+#include <vector>
+#include "fecore_api.h"
+
+//-----------------------------------------------------------------------------
+class FESurface;
+
+//-----------------------------------------------------------------------------
+//! Bounding volume hierarchy over the facets of a surface. 
+//! The tree topology is built once. When the surface deforms, the bounding
+//! boxes are refitted to the current nodal positions, which is much cheaper than
+//! rebuilding the tree. The query functions do not modify the tree, so they can
+//! be called concurrently from multiple threads.
+class FECORE_API FESurfaceBVH
+{
+public:
+	struct NODE
+	{
+		vec3d	cmin, cmax;		//!< bounding box
+		int		child;			//!< index of first child (second child is child+1), or -1 for leaves
+		int		first, count;	//!< range in facet list (leaves only)
+	};
+
+public:
+	FESurfaceBVH(FESurface* ps = 0);
+
+	//! attach to a surface
+	void Attach(FESurface* ps) { m_ps = ps; }
+
+	//! build the tree (topology and bounding boxes)
+	void Build();
+
+	//! recalculate the bounding boxes from the current nodal positions
+	void Refit();
+
+	//! returns true if the tree was built
+	bool IsValid() const { return (m_node.empty() == false); }
+
+public:
+	//! Find the (local) index of the surface node closest to x. If nodeExclude is 
+	//! a valid (global) node index, that node is skipped. Returns -1 if no node is found.
+	int FindNearestNode(const vec3d& x, int nodeExclude = -1) const;
+
+	//! Find all facets whose bounding box is intersected by the line through p with direction n.
+	//! The boxes are inflated by a fraction tol of their size. The list is sorted.
+	void FindRayCandidates(const vec3d& p, const vec3d& n, double tol, std::vector<int>& facetList) const;
+
+private:
+	void BuildNode(int inode, int first, int count, std::vector<vec3d>& center);
+	void FitLeaf(NODE& node);
+
+private:
+	FESurface*			m_ps;		//!< the surface
+	std::vector<NODE>	m_node;		//!< tree nodes (root is first)
+	std::vector<int>	m_facet;	//!< facet indices, ordered by leaf
+};
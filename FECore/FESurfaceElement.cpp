@@ -52,6 +52,7 @@ FESurfaceElement::FESurfaceElement(const FESurfaceElement& el) : FEElement(el)
 	m_lm = el.m_lm;
 	m_val = el.m_val;
 	m_status = el.m_status;
+	m_bconstrained = el.m_bconstrained;
 
 	// copy surface element data
 	m_lid = el.m_lid;
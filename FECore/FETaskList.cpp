@@ -0,0 +1,167 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FETaskList.h"
+#include "FEModel.h"
+#include "sys.h"
+#include <algorithm>
+#include <exception>
+
+//-----------------------------------------------------------------------------
+FETaskList::FETaskList()
+{
+	m_bconcurrent = true;
+	m_btiming = false;
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::Clear()
+{
+	m_task.clear();
+}
+
+//-----------------------------------------------------------------------------
+// A task is made exclusive when it is large enough to keep all threads busy with
+// its own element loop.
+double FETaskList::MinExclusiveCost() const
+{
+	return 256.0*omp_get_max_threads();
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::AddTask(const char* szname, int nid, std::function<void()> f, double cost)
+{
+	TASK task = { szname, nid, f, cost, (cost >= MinExclusiveCost()), 0.0 };
+	m_task.push_back(task);
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::AddExclusiveTask(const char* szname, int nid, std::function<void()> f)
+{
+	TASK task = { szname, nid, f, 0.0, true, 0.0 };
+	m_task.push_back(task);
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::RunTask(TASK& task)
+{
+	if (m_btiming)
+	{
+		double t0 = omp_get_wtime();
+		task.f();
+		task.time = omp_get_wtime() - t0;
+	}
+	else task.f();
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::Run()
+{
+	const int N = (int)m_task.size();
+
+	// collect the concurrent tasks
+	std::vector<int> conc;
+	if (m_bconcurrent && (omp_get_max_threads() > 1) && (omp_in_parallel() == 0))
+	{
+		for (int i = 0; i < N; ++i) if (m_task[i].bexcl == false) conc.push_back(i);
+	}
+
+	// it's not worth starting a parallel region for a single task
+	if (conc.size() < 2) conc.clear();
+
+	// run the exclusive tasks (or all tasks, if we're not running concurrently)
+	for (int i = 0; i < N; ++i)
+	{
+		TASK& task = m_task[i];
+		if (conc.empty() || task.bexcl) RunTask(task);
+	}
+
+	if (conc.empty() == false)
+	{
+		// start with the most expensive tasks so that the cheap ones fill the gaps at the end
+		std::stable_sort(conc.begin(), conc.end(), [=](int a, int b) { return m_task[a].cost > m_task[b].cost; });
+
+		// Exceptions cannot leave a parallel region, so we store the first one
+		// and rethrow it when all tasks are done.
+		std::exception_ptr err;
+		const int NC = (int)conc.size();
+		#pragma omp parallel for schedule(dynamic, 1)
+		for (int i = 0; i < NC; ++i)
+		{
+			try {
+				RunTask(m_task[conc[i]]);
+			}
+			catch (...)
+			{
+				#pragma omp critical (FETaskList_error)
+				if (!err) err = std::current_exception();
+			}
+		}
+
+		if (err) std::rethrow_exception(err);
+	}
+
+	// accumulate the timings
+	if (m_btiming)
+	{
+		for (int i = 0; i < N; ++i)
+		{
+			TASK& task = m_task[i];
+			TIMING& t = m_timing[std::make_pair(std::string(task.szname), task.nid)];
+			t.ncalls++;
+			t.time += task.time;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FETaskList::PrintTimings(FEModel* fem, const char* sztitle) const
+{
+	if (m_timing.empty()) return;
+
+	double total = 0.0;
+	std::map<std::pair<std::string, int>, TIMING>::const_iterator it;
+	for (it = m_timing.begin(); it != m_timing.end(); ++it) total += it->second.time;
+
+	fem->Logf(0, "\n%s\n", sztitle);
+	fem->Logf(0, "\t%-32s %10s %12s %8s\n", "task", "calls", "time (sec)", "%");
+	for (it = m_timing.begin(); it != m_timing.end(); ++it)
+	{
+		char szname[256];
+		if (it->first.second >= 0) sprintf(szname, "%s %d", it->first.first.c_str(), it->first.second + 1);
+		else sprintf(szname, "%s", it->first.first.c_str());
+
+		const TIMING& t = it->second;
+		double pct = (total > 0.0 ? 100.0*t.time / total : 0.0);
+		fem->Logf(0, "\t%-32s %10d %12.4lf %8.2lf\n", szname, t.ncalls, t.time, pct);
+	}
+	fem->Logf(0, "\n");
+}
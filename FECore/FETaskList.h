@@ -0,0 +1,118 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include <vector>
+#include <string>
+#include <map>
+#include <functional>
+#include "fecore_api.h"
+
+class FEModel;
+
+//-----------------------------------------------------------------------------
+//! This class executes a list of independent contributions to a global matrix 
+//! or vector (e.g. the domains, contact interfaces and loads of a model) concurrently.
+//! Tasks are either exclusive or concurrent:
+//! - Exclusive tasks are executed one at a time on the calling thread, in the 
+//!   order they were added. These are tasks that run their own parallel element
+//!   loops (e.g. large domains) or that modify data shared with other tasks 
+//!   (e.g. rigid body reaction forces).
+//! - Concurrent tasks are executed after the exclusive tasks. Each thread picks
+//!   the next task from the list (most expensive first) until the list is empty. 
+//!   Nested parallel loops inside these tasks run on the thread that picked the task.
+//! Concurrent tasks must assemble with the atomic assembly routines. Colored assembly
+//! is disabled while the tasks are running (see FELinearSystem::BeginColoredAssembly).
+//! If only one thread is available, all tasks are executed in the order they 
+//! were added, so the results are identical to a plain loop over the contributions.
+class FECORE_API FETaskList
+{
+	struct TASK
+	{
+		const char*				szname;		//!< task category
+		int						nid;		//!< index of task within category (or -1)
+		std::function<void()>	f;			//!< the work
+		double					cost;		//!< estimated cost (e.g. number of elements)
+		bool					bexcl;		//!< exclusive task
+		double					time;		//!< wall time of last execution
+	};
+
+	struct TIMING
+	{
+		int		ncalls;		//!< number of times the task was executed
+		double	time;		//!< total wall time spent in the task
+	};
+
+public:
+	FETaskList();
+
+	//! Concurrent execution of tasks (default on). When off, all tasks are executed in order.
+	void SetConcurrent(bool b) { m_bconcurrent = b; }
+
+	//! Collect timing data for each task (default off)
+	void SetTiming(bool b) { m_btiming = b; }
+	bool Timing() const { return m_btiming; }
+
+	//! remove all tasks (timing data is kept)
+	void Clear();
+
+	//! number of tasks in list
+	int Tasks() const { return (int) m_task.size(); }
+
+	//! add a task. The name and id only identify the task in the timing report.
+	//! Tasks with an estimated cost of at least MinExclusiveCost() are made exclusive, 
+	//! so that they can use all the threads for their own element loops.
+	void AddTask(const char* szname, int nid, std::function<void()> f, double cost);
+
+	//! add a task that is always executed exclusively
+	void AddExclusiveTask(const char* szname, int nid, std::function<void()> f);
+
+	//! execute all the tasks. If a task throws an exception, the remaining tasks 
+	//! are still executed and the first exception is rethrown afterwards.
+	void Run();
+
+	//! Tasks with an estimated cost of at least this value are executed exclusively.
+	double MinExclusiveCost() const;
+
+	//! print the timing report to the model's log
+	void PrintTimings(FEModel* fem, const char* sztitle) const;
+
+	//! clear the timing data
+	void ResetTimings() { m_timing.clear(); }
+
+private:
+	void RunTask(TASK& task);
+
+private:
+	bool				m_bconcurrent;
+	bool				m_btiming;
+	std::vector<TASK>	m_task;
+	std::map<std::pair<std::string, int>, TIMING>	m_timing;
+};
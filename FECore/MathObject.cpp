@@ -197,7 +197,158 @@ double MSimpleExpression::value(const MItem* pi, const std::vector<double>& var)
 }
 
 //-----------------------------------------------------------------------------
-MSimpleExpression::MSimpleExpression(const MSimpleExpression& mo) : MathObject(mo), m_item(mo.m_item)
+// Compile the expression into a program for a stack machine. Sub-expressions that 
+// do not depend on any variables are evaluated here and replaced by a single constant.
+// If the expression cannot be compiled, the program is left empty and the thread safe
+// evaluation falls back to evaluating the expression tree.
+void MSimpleExpression::Compile()
+{
+	m_prog.clear();
+	if (m_item.ItemPtr() == nullptr) return;
+
+	std::vector<Instruction> prog;
+	if (compile(m_item.ItemPtr(), prog) < 0) return;
+
+	// make sure the program does not need more stack than we have
+	int top = 0, maxTop = 0;
+	for (size_t i = 0; i < prog.size(); ++i)
+	{
+		switch (prog[i].op)
+		{
+		case OP_CONST:
+		case OP_VAR: top++; break;
+		case OP_ADD:
+		case OP_SUB:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_POW:
+		case OP_F2D: top--; break;
+		}
+		if (top > maxTop) maxTop = top;
+	}
+	if ((top != 1) || (maxTop > MAX_STACK_SIZE)) return;
+
+	m_prog = prog;
+}
+
+//-----------------------------------------------------------------------------
+// Adds the instructions for the item pi to the program. 
+// Returns 1 if the item is constant, 0 if it depends on variables, and -1 if the
+// item cannot be compiled.
+int MSimpleExpression::compile(const MItem* pi, std::vector<Instruction>& prog) const
+{
+	Instruction ins = { OP_CONST, -1, 0.0, nullptr, nullptr };
+	size_t start = prog.size();
+	int ret = -1;
+	switch (pi->Type())
+	{
+	case MCONST:
+	case MFRAC:
+	case MNAMED:
+		ins.op = OP_CONST;
+		ins.v = mnumber(pi)->value();
+		prog.push_back(ins);
+		return 1;
+	case MVAR:
+		ins.op = OP_VAR;
+		ins.n = mvar(pi)->index();
+		prog.push_back(ins);
+		return 0;
+	case MNEG:
+	case MF1D:
+		{
+			ret = compile(munary(pi)->Item(), prog);
+			if (ret < 0) return -1;
+			if (pi->Type() == MNEG) ins.op = OP_NEG;
+			else { ins.op = OP_F1D; ins.f1 = mfnc1d(pi)->funcptr(); }
+			prog.push_back(ins);
+		}
+		break;
+	case MADD:
+	case MSUB:
+	case MMUL:
+	case MDIV:
+	case MPOW:
+	case MF2D:
+		{
+			int l = compile(mbinary(pi)->LeftItem(), prog);
+			if (l < 0) return -1;
+			int r = compile(mbinary(pi)->RightItem(), prog);
+			if (r < 0) return -1;
+			ret = ((l == 1) && (r == 1) ? 1 : 0);
+			switch (pi->Type())
+			{
+			case MADD: ins.op = OP_ADD; break;
+			case MSUB: ins.op = OP_SUB; break;
+			case MMUL: ins.op = OP_MUL; break;
+			case MDIV: ins.op = OP_DIV; break;
+			case MPOW: ins.op = OP_POW; break;
+			case MF2D: ins.op = OP_F2D; ins.f2 = mfnc2d(pi)->funcptr(); break;
+			default:
+				assert(false);
+				return -1;
+			}
+			prog.push_back(ins);
+		}
+		break;
+	case MSFNC:
+		return compile(msfncnd(pi)->Value(), prog);
+	default:
+		return -1;
+	}
+
+	// fold constant sub-expressions
+	if (ret == 1)
+	{
+		prog.resize(start);
+		ins.op = OP_CONST;
+		ins.v = value(pi, std::vector<double>());
+		prog.push_back(ins);
+	}
+
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+// run the compiled program
+double MSimpleExpression::run(const double* var) const
+{
+	double s[MAX_STACK_SIZE];
+	int top = -1;
+	const Instruction* ins = &m_prog[0];
+	const int N = (int)m_prog.size();
+	for (int i = 0; i < N; ++i, ++ins)
+	{
+		switch (ins->op)
+		{
+		case OP_CONST: s[++top] = ins->v; break;
+		case OP_VAR  : s[++top] = var[ins->n]; break;
+		case OP_NEG  : s[top] = -s[top]; break;
+		case OP_ADD  : --top; s[top] = s[top] + s[top + 1]; break;
+		case OP_SUB  : --top; s[top] = s[top] - s[top + 1]; break;
+		case OP_MUL  : --top; s[top] = s[top] * s[top + 1]; break;
+		case OP_DIV  : --top; s[top] = s[top] / s[top + 1]; break;
+		case OP_POW  : --top; s[top] = pow(s[top], s[top + 1]); break;
+		case OP_F1D  : s[top] = (ins->f1)(s[top]); break;
+		case OP_F2D  : --top; s[top] = (ins->f2)(s[top], s[top + 1]); break;
+		}
+	}
+	assert(top == 0);
+	return s[0];
+}
+
+//-----------------------------------------------------------------------------
+double MSimpleExpression::value_s(const double* var) const
+{
+	if (m_prog.empty() == false) return run(var);
+
+	// the expression could not be compiled, so evaluate the expression tree instead
+	std::vector<double> v(var, var + m_Var.size());
+	return value(m_item.ItemPtr(), v);
+}
+
+//-----------------------------------------------------------------------------
+MSimpleExpression::MSimpleExpression(const MSimpleExpression& mo) : MathObject(mo), m_item(mo.m_item), m_prog(mo.m_prog)
 {
 	// The copy c'tor of MathObject copied the variables, but any MVarRefs still point to the mo object, not this object's var list.
 	// Calling the following function fixes this
@@ -212,6 +363,7 @@ void MSimpleExpression::operator=(const MSimpleExpression& mo)
 
 	// copy the item
 	m_item = mo.m_item;
+	m_prog = mo.m_prog;
 
 	// The = operator of MathObject copied the variables, but any MVarRefs still point to the mo object, not this object's var list.
 	// Calling the following function fixes this
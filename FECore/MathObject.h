@@ -69,12 +69,39 @@ protected:
 // setting the values of the variables.
 class FECORE_API MSimpleExpression : public MathObject
 {
+	// The expression is compiled into a program for a simple stack machine,
+	// which is used by the thread safe evaluation functions.
+	enum OpCode {
+		OP_CONST,	// push constant
+		OP_VAR,		// push variable
+		OP_NEG,
+		OP_ADD,
+		OP_SUB,
+		OP_MUL,
+		OP_DIV,
+		OP_POW,
+		OP_F1D,		// call function of one variable
+		OP_F2D		// call function of two variables
+	};
+
+	struct Instruction
+	{
+		int			op;		// op code
+		int			n;		// variable index (OP_VAR)
+		double		v;		// constant value (OP_CONST)
+		FUNCPTR		f1;		// function pointer (OP_F1D)
+		FUNC2PTR	f2;		// function pointer (OP_F2D)
+	};
+
+	// max stack size of the compiled program
+	enum { MAX_STACK_SIZE = 64 };
+
 public:
 	MSimpleExpression() {}
 	MSimpleExpression(const MSimpleExpression& mo);
 	void operator = (const MSimpleExpression& mo);
 
-	void SetExpression(MITEM& e) { m_item = e; }
+	void SetExpression(MITEM& e) { m_item = e; Compile(); }
 	MITEM& GetExpression() { return m_item; }
 	const MITEM& GetExpression() const { return m_item; }
 
@@ -95,18 +122,30 @@ public:
 	double value_s(const std::vector<double>& var) const
 	{ 
 		assert(var.size() == m_Var.size());
-		return value(m_item.ItemPtr(), var); 
+		return value_s(var.empty() ? nullptr : &var[0]);
 	}
 
+	// Same as above, but the variable values are passed as an array. 
+	// The array must have (at least) as many values as there are variables.
+	double value_s(const double* var) const;
+
 	int Items();
 
+	// Compile the expression. This is done automatically when the expression is set, but
+	// must be called again if the expression is modified via GetExpression.
+	void Compile();
+
 protected:
 	double value(const MItem* pi) const;
 	double value(const MItem* pi, const std::vector<double>& var) const;
 
+	int compile(const MItem* pi, std::vector<Instruction>& prog) const;
+	double run(const double* var) const;
+
 protected:
 	void fixVariableRefs(MItem* pi);
 
 protected:
 	MITEM	m_item;
+	std::vector<Instruction>	m_prog;	//!< compiled expression (empty if the expression could not be compiled)
 };
@@ -60,6 +60,17 @@ public:
 	//! return number of nonzeros
 	int NonZeroes() const { return m_nsize; }
 
+	//! Turn atomic updates in Assemble and set on or off. Atomics can only be turned off
+	//! when the caller guarantees that concurrent calls never write to the same entries.
+	void SetAtomicAssembly(bool b) { m_batomic = b; }
+
+	//! are assembly updates done atomically?
+	bool AtomicAssembly() const { return m_batomic; }
+
+	//! Returns an ID that changes each time the matrix structure is (re)allocated.
+	//! Data that depends on the structure (e.g. scatter maps) can use it to detect changes.
+	int StructureID() const { return m_structureID; }
+
 public: // functions to be overwritten in derived classes
 
 	//! set all matrix elements to zero
@@ -74,6 +85,15 @@ public: // functions to be overwritten in derived classes
 	//! assemble a matrix into the sparse matrix
 	virtual void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) = 0;
 
+	//! Build a scatter map for assembling the element matrix ke with row indices lmi and column indices lmj.
+	//! The map stores for the entries of the element matrix the location in the values array
+	//! where they are assembled. Its layout is defined by the matrix format. 
+	//! Returns false if this matrix format does not support scatter maps.
+	virtual bool BuildScatterMap(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj, std::vector<int>& map) { return false; }
+
+	//! assemble a matrix into the sparse matrix, using a scatter map created by BuildScatterMap
+	virtual void ScatterAssemble(const matrix& ke, const std::vector<int>& map) { assert(false); }
+
 	//! check if an entry was allocated
 	virtual bool check(int i, int j) = 0;
 
@@ -111,4 +131,6 @@ protected:
 	// NOTE: These values are set by derived classes
 	int	m_nrow, m_ncol;		//!< dimension of matrix
 	int	m_nsize;			//!< number of nonzeroes (i.e. matrix elements actually allocated)
+	bool	m_batomic;		//!< use atomic updates during assembly (default = true)
+	int		m_structureID;	//!< ID of the current matrix structure (0 = not allocated)
 };
@@ -49,7 +49,13 @@ SOFTWARE.*/
 #ifdef WIN32
 extern "C" int __cdecl omp_get_num_threads(void);
 extern "C" int __cdecl omp_get_thread_num(void);
+extern "C" int __cdecl omp_get_max_threads(void);
+extern "C" int __cdecl omp_in_parallel(void);
+extern "C" double __cdecl omp_get_wtime(void);
 #else
 extern "C" int omp_get_num_threads(void);
 extern "C" int omp_get_thread_num(void);
+extern "C" int omp_get_max_threads(void);
+extern "C" int omp_in_parallel(void);
+extern "C" double omp_get_wtime(void);
 #endif
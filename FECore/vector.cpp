@@ -33,21 +33,121 @@ SOFTWARE.*/
 #include "FEDofList.h"
 #include <algorithm>
 
-double operator*(const vector<double>& a, const vector<double>& b)
+//-----------------------------------------------------------------------------
+// Reductions (e.g. dot products) are summed over blocks of a fixed size. The 
+// partial sums of the blocks are added in order, so that the result does not 
+// depend on the number of threads.
+static const int VEC_BLOCK_SIZE = 4096;
+
+//-----------------------------------------------------------------------------
+// Evaluates a reduction over the range [0, n). The function f(i0, i1, sp, sn) 
+// calculates the positive and negative contributions of the range [i0, i1). 
+// Keeping the positive and negative terms separate reduces the cancellation error.
+template <class F> static double blocked_sum(int n, F f)
 {
-	double sum_p = 0, sum_n = 0;
-	for (size_t i = 0; i < a.size(); i++)
+	const int NB = (n + VEC_BLOCK_SIZE - 1) / VEC_BLOCK_SIZE;
+	if (NB <= 1)
 	{
-		double ab = a[i] * b[i];
-		if (ab >= 0.0) sum_p += ab; else sum_n += ab;
+		double sp = 0.0, sn = 0.0;
+		if (n > 0) f(0, n, sp, sn);
+		return sp + sn;
 	}
+
+	vector<double> sp(NB), sn(NB);
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int k = 0; k < NB; ++k)
+	{
+		int i0 = k*VEC_BLOCK_SIZE;
+		int i1 = (i0 + VEC_BLOCK_SIZE < n ? i0 + VEC_BLOCK_SIZE : n);
+		f(i0, i1, sp[k], sn[k]);
+	}
+
+	double sum_p = 0.0, sum_n = 0.0;
+	for (int k = 0; k < NB; ++k) { sum_p += sp[k]; sum_n += sn[k]; }
 	return sum_p + sum_n;
 }
 
+//-----------------------------------------------------------------------------
+// Dot product over a block. Four independent partial sums are used so that the
+// compiler can vectorize the loop.
+static inline void block_dot(const double* a, const double* b, int i0, int i1, double& sp, double& sn)
+{
+	double p0 = 0, p1 = 0, p2 = 0, p3 = 0;
+	double n0 = 0, n1 = 0, n2 = 0, n3 = 0;
+	int i = i0;
+	for (; i + 3 < i1; i += 4)
+	{
+		double ab0 = a[i    ] * b[i    ];
+		double ab1 = a[i + 1] * b[i + 1];
+		double ab2 = a[i + 2] * b[i + 2];
+		double ab3 = a[i + 3] * b[i + 3];
+		p0 += (ab0 >= 0.0 ? ab0 : 0.0); n0 += (ab0 < 0.0 ? ab0 : 0.0);
+		p1 += (ab1 >= 0.0 ? ab1 : 0.0); n1 += (ab1 < 0.0 ? ab1 : 0.0);
+		p2 += (ab2 >= 0.0 ? ab2 : 0.0); n2 += (ab2 < 0.0 ? ab2 : 0.0);
+		p3 += (ab3 >= 0.0 ? ab3 : 0.0); n3 += (ab3 < 0.0 ? ab3 : 0.0);
+	}
+	for (; i < i1; ++i)
+	{
+		double ab = a[i] * b[i];
+		if (ab >= 0.0) p0 += ab; else n0 += ab;
+	}
+	sp = (p0 + p1) + (p2 + p3);
+	sn = (n0 + n1) + (n2 + n3);
+}
+
+//-----------------------------------------------------------------------------
+double vdot(const double* a, const double* b, int n)
+{
+	return blocked_sum(n, [=](int i0, int i1, double& sp, double& sn) {
+		block_dot(a, b, i0, i1, sp, sn);
+	});
+}
+
+//-----------------------------------------------------------------------------
+void vadds(double* a, const double* b, double s, int n)
+{
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] += b[i] * s;
+}
+
+//-----------------------------------------------------------------------------
+double vadds_dot(double* a, const double* b, double s, const double* w, int n)
+{
+	return blocked_sum(n, [=](int i0, int i1, double& sp, double& sn) {
+		for (int i = i0; i < i1; ++i) a[i] += b[i] * s;
+		block_dot(w, a, i0, i1, sp, sn);
+	});
+}
+
+//-----------------------------------------------------------------------------
+double vadds_diff_dot(double* a, const double* b, const double* c, double s, const double* w, int n)
+{
+	if (w == nullptr)
+	{
+		#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+		for (int i = 0; i < n; ++i) a[i] += (b[i] - c[i]) * s;
+		return 0.0;
+	}
+
+	return blocked_sum(n, [=](int i0, int i1, double& sp, double& sn) {
+		for (int i = i0; i < i1; ++i) a[i] += (b[i] - c[i]) * s;
+		block_dot(w, a, i0, i1, sp, sn);
+	});
+}
+
+//-----------------------------------------------------------------------------
+double operator*(const vector<double>& a, const vector<double>& b)
+{
+	assert(a.size() == b.size());
+	if (a.empty()) return 0.0;
+	return vdot(&a[0], &b[0], (int)a.size());
+}
+
 vector<double> operator - (vector<double>& a, vector<double>& b)
 {
 	vector<double> c(a);
 	int n = (int) c.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
 	for (int i=0; i<n; ++i) c[i] -= b[i];
 	return c;
 }
@@ -55,69 +155,90 @@ vector<double> operator - (vector<double>& a, vector<double>& b)
 void operator += (vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i < a.size(); ++i) a[i] += b[i];
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] += b[i];
 }
 
 void operator -= (vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i < a.size(); ++i) a[i] -= b[i];
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] -= b[i];
 }
 
 void operator *= (vector<double>& a, double b)
 {
-	for (size_t i=0; i<a.size(); ++i) a[i] *= b;
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] *= b;
 }
 
 void vcopys(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i=0; i<a.size(); ++i) a[i] = b[i]*s;
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] = b[i]*s;
 }
 
 void vadds(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] += b[i] * s;
+	if (a.empty()) return;
+	vadds(&a[0], &b[0], s, (int)a.size());
 }
 
 void vsubs(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] -= b[i] * s;
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] -= b[i] * s;
 }
 
 void vscale(vector<double>& a, const vector<double>& s)
 {
 	assert(a.size() == s.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] *= s[i];
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] *= s[i];
 }
 
 void vsub(vector<double>& a, const vector<double>& l, const vector<double>& r)
 {
 	assert((a.size()==l.size())&&(a.size()==r.size()));
-	for (size_t i=0; i<a.size(); ++i) a[i] = l[i] - r[i];
+	int n = (int)a.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) a[i] = l[i] - r[i];
 }
 
 vector<double> operator + (const vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
 	vector<double> s(a);
-	for (size_t i = 0; i < s.size(); ++i) s[i] += b[i];
+	int n = (int)s.size();
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) s[i] += b[i];
 	return s;
 }
 
 vector<double> operator*(const vector<double>& a, double g)
 {
-	vector<double> s(a.size());
-	for (size_t i = 0; i < s.size(); ++i) s[i] = a[i]*g;
+	int n = (int)a.size();
+	vector<double> s(n);
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) s[i] = a[i]*g;
 	return s;
 }
 
 vector<double> FECORE_API operator - (const vector<double>& a)
 {
-	vector<double> s(a.size());
-	for (size_t i = 0; i < s.size(); ++i) s[i] = -a[i];
+	int n = (int)a.size();
+	vector<double> s(n);
+	#pragma omp parallel for if (n >= VEC_PARALLEL_MIN) schedule(static)
+	for (int i = 0; i < n; ++i) s[i] = -a[i];
 	return s;
 }
 
@@ -184,21 +305,16 @@ void scatter(vector<double>& v, FEMesh& mesh, const FEDofList& dofs)
 
 double l2_norm(const vector<double>& v)
 {
-	double s = 0.0;
-	for (auto vi : v) s += vi*vi;
-	return sqrt(s);
+	return sqrt(l2_sqrnorm(v));
 }
 
 double l2_sqrnorm(const vector<double>& v)
 {
-	double s = 0.0;
-	for (auto vi : v) s += vi*vi;
-	return s;
+	if (v.empty()) return 0.0;
+	return vdot(&v[0], &v[0], (int)v.size());
 }
 
 double l2_norm(double* x, int n)
 {
-	double s = 0.0;
-	for (int i = 0; i < n; ++i) s += x[i]*x[i];
-	return sqrt(s);
+	return sqrt(vdot(x, x, n));
 }
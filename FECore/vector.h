@@ -38,6 +38,9 @@ using namespace std;
 class FEMesh;
 class FEDofList;
 
+// Loops over fewer entries than this are not worth the overhead of a parallel region.
+const int VEC_PARALLEL_MIN = 32768;
+
 double FECORE_API operator*(const vector<double>& a, const vector<double>& b);
 vector<double> FECORE_API operator - (vector<double>& a, vector<double>& b);
 template<typename T> void zero(vector<T>& a) { fill(a.begin(), a.end(), T(0)); }
@@ -72,6 +75,22 @@ void FECORE_API scatter(vector<double>& v, FEMesh& mesh, int ndof);
 void FECORE_API scatter3(vector<double>& v, FEMesh& mesh, int ndof1, int ndof2, int ndof3);
 void FECORE_API scatter(vector<double>& v, FEMesh& mesh, const FEDofList& dofs);
 
+// Kernels for long arrays (e.g. of global equation length). These are parallelized 
+// for large n. The reductions are summed in fixed blocks, so the results do not 
+// depend on the number of threads.
+
+// dot product a.b
+double FECORE_API vdot(const double* a, const double* b, int n);
+
+// a += b*s
+void FECORE_API vadds(double* a, const double* b, double s, int n);
+
+// a += b*s, and return w.a (with the updated a) in the same pass
+double FECORE_API vadds_dot(double* a, const double* b, double s, const double* w, int n);
+
+// a += (b - c)*s, and return w.a (with the updated a) in the same pass (w may be null)
+double FECORE_API vadds_diff_dot(double* a, const double* b, const double* c, double s, const double* w, int n);
+
 // calculate l2 norm of vector
 double FECORE_API l2_norm(const vector<double>& v);
 double FECORE_API l2_sqrnorm(const vector<double>& v);
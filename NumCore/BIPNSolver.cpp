@@ -594,17 +594,22 @@ int BIPNSolver::gmressolve(SparseMatrix* K, LinearSolver* PC, vector<double>& x,
 
 #else	// ifdef MKL_ISS
 
-BIPNSolver::BIPNSolver() : LinearSolver(fem), m_A(0) {}
+BEGIN_FECORE_CLASS(BIPNSolver, LinearSolver)
+END_FECORE_CLASS();
+
+BIPNSolver::BIPNSolver(FEModel* fem) : LinearSolver(fem), m_A(0) {}
 bool BIPNSolver::PreProcess() { return false; }
 bool BIPNSolver::Factor() { return false; }
 bool BIPNSolver::BackSolve(double* x, double* b) { return false; }
 SparseMatrix* BIPNSolver::CreateSparseMatrix(Matrix_Type ntype) { return 0; }
+bool BIPNSolver::SetSparseMatrix(SparseMatrix* A) { return false; }
 void BIPNSolver::SetPrintLevel(int n) {}
 void BIPNSolver::SetMaxIterations(int n) {}
-void BIPNSolver::SetPartition(int n) {}
 void BIPNSolver::SetTolerance(double eps) {}
 void BIPNSolver::UseConjugateGradient(bool b) {}
 void BIPNSolver::SetCGParameters(int maxiter, double tolerance, bool doResidualStoppingTest) {}
-void BIPNSolver::SetGMRESParameters(int maxiter, double tolerance, bool doResidualStoppingTest, bool precondition) {}
+void BIPNSolver::SetGMRESParameters(int maxiter, double tolerance, bool doResidualStoppingTest, int precondition) {}
+void BIPNSolver::DoJacobiPreconditioner(bool b) {}
+void BIPNSolver::SetSchurPreconditioner(int n) {}
 
 #endif
@@ -220,8 +220,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-					#pragma omp atomic
-					pm[n] += ke[i][j];
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -256,8 +260,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 				for (int n = 0; n<l; ++n) 
 					if (pi[n] - m_offset == I)
 					{
-						#pragma omp atomic
-						pv[n] += ke[i][j];
+						if (m_batomic)
+						{
+							#pragma omp atomic
+							pv[n] += ke[i][j];
+						}
+						else pv[n] += ke[i][j];
 						break;
 					}
 			}
@@ -346,8 +354,12 @@ void CompactSymmMatrix::set(int i, int j, double v)
 			{
 				int k = m_ppointers[j] + n;
 				k -= m_offset;
+				if (m_batomic)
+				{
 #pragma omp critical
-				m_pd[k] = v;
+					m_pd[k] = v;
+				}
+				else m_pd[k] = v;
 				return;
 			}
 
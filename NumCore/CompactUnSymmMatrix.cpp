@@ -233,8 +233,12 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == J)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += kij;
+						pm[n] += kij;
+					}
+					else pm[n] += kij;
 					break;
 				}
 		}
@@ -308,8 +312,12 @@ void CRSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == j + m_offset)
 		{
+			if (m_batomic)
+			{
 #pragma omp critical
-			m_pd[m_ppointers[i] + n - m_offset] = v;
+				m_pd[m_ppointers[i] + n - m_offset] = v;
+			}
+			else m_pd[m_ppointers[i] + n - m_offset] = v;
 			return;
 		}
 	}
@@ -362,26 +370,26 @@ bool CRSSparseMatrix::mult_vector(double* x, double* r)
 	// get the matrix size
 	const int N = Rows();
 
+#ifdef MKL_ISS
 	if (Offset() == 1)
 	{
 		const char transa = 'N';
 		mkl_dcsrgemv(&transa, &N, m_pd, m_ppointers, m_pindices, x, r);
+		return true;
 	}
-	else
-	{
-		assert(m_offset == 0);
-		// loop over all rows
-	#pragma omp parallel for schedule(guided)
-		for (int i = 0; i < N; ++i)
+#endif
+
+	// loop over all rows
+#pragma omp parallel for schedule(guided)
+	for (int i = 0; i < N; ++i)
+	{
+		const double* pv = m_pd + (m_ppointers[i] - m_offset);
+		const int* pi = m_pindices + (m_ppointers[i] - m_offset);
+		const int n = m_ppointers[i + 1] - m_ppointers[i];
+		r[i] = 0.0;
+		for (int j = 0; j < n; j ++)
 		{
-			const double* pv = m_pd + (m_ppointers[i] - m_offset);
-			const int* pi = m_pindices + (m_ppointers[i] - m_offset);
-			const int n = m_ppointers[i + 1] - m_ppointers[i];
-			r[i] = 0.0;
-			for (int j = 0; j < n; j ++)
-			{
-				r[i] += (*pv++) * x[*pi++ - m_offset];
-			}
+			r[i] += (*pv++) * x[*pi++ - m_offset];
 		}
 	}
 
@@ -652,8 +660,12 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += ke[i][j];
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -726,8 +738,12 @@ void CCSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == i + m_offset)
 		{
+			if (m_batomic)
+			{
 #pragma omp critical
-			m_pd[m_ppointers[j] + n - m_offset] = v;
+				m_pd[m_ppointers[j] + n - m_offset] = v;
+			}
+			else m_pd[m_ppointers[j] + n - m_offset] = v;
 			return;
 		}
 	}
@@ -66,6 +66,7 @@ SparseMatrix* ILU0_Preconditioner::CreateSparseMatrix(Matrix_Type ntype)
 
 bool ILU0_Preconditioner::Factor()
 {
+#ifdef MKL_ISS
 	if (m_K == 0) return false;
 	assert(m_K->Offset() == 1);
 
@@ -95,10 +96,14 @@ bool ILU0_Preconditioner::Factor()
 	if (ierr != 0) return false;
 
 	return true;
+#else
+	return false;
+#endif
 }
 
 bool ILU0_Preconditioner::BackSolve(double* x, double* y)
 {
+#ifdef MKL_ISS
 	int ivar = m_K->Rows();
 	int* ia = m_K->Pointers();
 	int* ja = m_K->Indices();
@@ -113,4 +118,7 @@ bool ILU0_Preconditioner::BackSolve(double* x, double* y)
 	mkl_dcsrtrsv(&cvar1, &cvar, &cvar2, &ivar, &m_bilu0[0], ia, ja, &m_tmp[0], &x[0]);
 
 	return true;
+#else
+	return false;
+#endif
 }
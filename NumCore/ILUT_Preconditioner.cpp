@@ -60,6 +60,7 @@ ILUT_Preconditioner::ILUT_Preconditioner(FEModel* fem) : Preconditioner(fem)
 
 bool ILUT_Preconditioner::Factor()
 {
+#ifdef MKL_ISS
 	m_K = dynamic_cast<CRSSparseMatrix*>(GetSparseMatrix());
 	if (m_K == 0) return false;
 	assert(m_K->Offset() == 1);
@@ -97,10 +98,14 @@ bool ILUT_Preconditioner::Factor()
 	if (ierr != 0) return false;
 
 	return true;
+#else
+	return false;
+#endif
 }
 
 bool ILUT_Preconditioner::BackSolve(double* x, double* y)
 {
+#ifdef MKL_ISS
 	int ivar = m_K->Rows();
 	char cvar1 = 'L';
 	char cvar = 'N';
@@ -112,4 +117,7 @@ bool ILUT_Preconditioner::BackSolve(double* x, double* y)
 	mkl_dcsrtrsv(&cvar1, &cvar, &cvar2, &ivar, &m_bilut[0], &m_ibilut[0], &m_jbilut[0], &m_tmp[0], x);
 
 	return true;
+#else
+	return false;
+#endif
 }
@@ -0,0 +1,987 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "MultifrontalSolver.h"
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <algorithm>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// Approximate minimum degree ordering of a (weighted) graph.
+// The graph is stored in compressed format (xadj, adj) without the diagonal.
+// The weight of a node is the number of equations it represents. The elimination
+// graph is represented as a quotient graph, i.e. eliminated nodes become "elements"
+// that represent the cliques created by the elimination. The degree of a node
+// is approximated as in the AMD algorithm, i.e. the external degree of each 
+// adjacent element is computed with respect to the pivot element. Elements
+// that are covered by the pivot element are absorbed. Nodes that are (almost) dense
+// are removed from the graph and are ordered last.
+static void amd_order(int n, const std::vector<int>& xadj, const std::vector<int>& adj, const std::vector<int>& w, std::vector<int>& order)
+{
+	enum { VARIABLE, ELEMENT, ABSORBED, DENSE };
+
+	order.clear();
+	order.reserve(n);
+	if (n == 0) return;
+
+	std::vector< std::vector<int> > V(n);	// adjacent variables
+	std::vector< std::vector<int> > E(n);	// adjacent elements
+	std::vector< std::vector<int> > L(n);	// variables of elements
+	std::vector<int> status(n, VARIABLE);
+	std::vector<int> deg(n, 0);
+	std::vector<int> wL(n, 0);
+
+	// find dense nodes
+	int dense = (int)(10.0*sqrt((double)n));
+	if (dense < 16) dense = 16;
+	int Wtot = 0, Wrem = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		Wtot += w[i];
+		if (xadj[i + 1] - xadj[i] > dense) status[i] = DENSE; else Wrem += w[i];
+	}
+
+	// initialize the quotient graph
+	for (int i = 0; i < n; ++i)
+	{
+		if (status[i] != VARIABLE) continue;
+		V[i].reserve(xadj[i + 1] - xadj[i]);
+		for (int j = xadj[i]; j < xadj[i + 1]; ++j)
+		{
+			int k = adj[j];
+			if (status[k] == VARIABLE) { V[i].push_back(k); deg[i] += w[k]; }
+		}
+	}
+
+	// degree lists
+	std::vector<int> head(Wtot + 1, -1), next(n, -1), prev(n, -1);
+	int mindeg = Wtot;
+	for (int i = 0; i < n; ++i)
+	{
+		if (status[i] != VARIABLE) continue;
+		int d = deg[i];
+		next[i] = head[d]; prev[i] = -1;
+		if (head[d] >= 0) prev[head[d]] = i;
+		head[d] = i;
+		if (d < mindeg) mindeg = d;
+	}
+
+	std::vector<int> mark(n, 0), wext(n, 0), wmark(n, 0);
+	int tag = 0, wtag = 0;
+	while (Wrem > 0)
+	{
+		// pick the node with minimum degree
+		while (head[mindeg] < 0) mindeg++;
+		int p = head[mindeg];
+		head[mindeg] = next[p];
+		if (next[p] >= 0) prev[next[p]] = -1;
+
+		order.push_back(p);
+		status[p] = ELEMENT;
+		Wrem -= w[p];
+
+		// construct the new element
+		++tag;
+		mark[p] = tag;
+		std::vector<int>& Lp = L[p];
+		int wLp = 0;
+		for (size_t j = 0; j < V[p].size(); ++j)
+		{
+			int v = V[p][j];
+			if ((status[v] == VARIABLE) && (mark[v] != tag)) { mark[v] = tag; Lp.push_back(v); wLp += w[v]; }
+		}
+		for (size_t j = 0; j < E[p].size(); ++j)
+		{
+			int e = E[p][j];
+			if (status[e] != ELEMENT) continue;
+			for (size_t k = 0; k < L[e].size(); ++k)
+			{
+				int v = L[e][k];
+				if ((status[v] == VARIABLE) && (mark[v] != tag)) { mark[v] = tag; Lp.push_back(v); wLp += w[v]; }
+			}
+			status[e] = ABSORBED;
+			std::vector<int>().swap(L[e]);
+		}
+		wL[p] = wLp;
+		std::vector<int>().swap(V[p]);
+		std::vector<int>().swap(E[p]);
+
+		// calculate the external degrees |Le \ Lp| of the adjacent elements
+		++wtag;
+		for (size_t j = 0; j < Lp.size(); ++j)
+		{
+			int i = Lp[j];
+			for (size_t k = 0; k < E[i].size(); ++k)
+			{
+				int e = E[i][k];
+				if (status[e] != ELEMENT) continue;
+				if (wmark[e] != wtag) { wmark[e] = wtag; wext[e] = wL[e]; }
+				wext[e] -= w[i];
+			}
+		}
+
+		// update the variables of the new element
+		for (size_t j = 0; j < Lp.size(); ++j)
+		{
+			int i = Lp[j];
+
+			// remove from degree list
+			if (prev[i] >= 0) next[prev[i]] = next[i]; else head[deg[i]] = next[i];
+			if (next[i] >= 0) prev[next[i]] = prev[i];
+
+			// prune the variable list (variables in Lp are now covered by element p)
+			std::vector<int>& Vi = V[i];
+			int dv = 0, nv = 0;
+			for (size_t k = 0; k < Vi.size(); ++k)
+			{
+				int v = Vi[k];
+				if ((status[v] == VARIABLE) && (mark[v] != tag)) { Vi[nv++] = v; dv += w[v]; }
+			}
+			Vi.resize(nv);
+
+			// prune the element list and absorb elements that are covered by Lp
+			std::vector<int>& Ei = E[i];
+			int de = 0, ne = 0;
+			for (size_t k = 0; k < Ei.size(); ++k)
+			{
+				int e = Ei[k];
+				if (status[e] != ELEMENT) continue;
+				if (wext[e] <= 0)
+				{
+					status[e] = ABSORBED;
+					std::vector<int>().swap(L[e]);
+				}
+				else { Ei[ne++] = e; de += wext[e]; }
+			}
+			Ei.resize(ne);
+			Ei.push_back(p);
+
+			// approximate external degree
+			int d = dv + de + wLp - w[i];
+			int dmax = Wrem - w[i];
+			if (d > dmax) d = dmax;
+			if (d > deg[i] + wLp - w[i]) d = deg[i] + wLp - w[i];
+			if (d < 0) d = 0;
+			deg[i] = d;
+
+			// add to degree list
+			next[i] = head[d]; prev[i] = -1;
+			if (head[d] >= 0) prev[head[d]] = i;
+			head[d] = i;
+			if (d < mindeg) mindeg = d;
+		}
+	}
+
+	// add the dense nodes
+	for (int i = 0; i < n; ++i) if (status[i] == DENSE) order.push_back(i);
+}
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(MultifrontalSolver, LinearSolver)
+	ADD_PARAMETER(m_print_level, "print_level");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+MultifrontalSolver::MultifrontalSolver(FEModel* fem) : LinearSolver(fem), m_pA(0)
+{
+	m_bsymm = true;
+	m_print_level = 0;
+	m_bsymbolic = false;
+	m_bfactored = false;
+	m_nnzL = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+void MultifrontalSolver::SetPrintLevel(int n)
+{
+	m_print_level = n;
+}
+
+//-----------------------------------------------------------------------------
+//! Create a sparse matrix
+SparseMatrix* MultifrontalSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : m_bsymm = true ; m_pA = new CompactSymmMatrix(0); break;
+	case REAL_UNSYMMETRIC   : m_bsymm = false; m_pA = new CRSSparseMatrix(0); break;
+	case REAL_SYMM_STRUCTURE: m_bsymm = false; m_pA = new CRSSparseMatrix(0); break;
+	default:
+		assert(false);
+		m_pA = nullptr;
+	}
+	m_bsymbolic = false;
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+bool MultifrontalSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_pA = dynamic_cast<CompactMatrix*>(pA);
+	if (m_pA == nullptr) return false;
+	m_bsymm = m_pA->isSymmetric();
+	m_bsymbolic = false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// See if the sparsity pattern differs from the one used for the symbolic analysis
+bool MultifrontalSolver::PatternChanged() const
+{
+	int n = m_pA->Rows();
+	if ((int)m_ptr.size() != n + 1) return true;
+	const int* pp = m_pA->Pointers();
+	for (int i = 0; i <= n; ++i) if (pp[i] != m_ptr[i]) return true;
+
+	int nnz = m_pA->NonZeroes();
+	if ((int)m_ind.size() != nnz) return true;
+	const int* pi = m_pA->Indices();
+	for (int i = 0; i < nnz; ++i) if (pi[i] != m_ind[i]) return true;
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool MultifrontalSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+
+	// only redo the symbolic analysis when the sparsity pattern changed
+	if ((m_bsymbolic == false) || PatternChanged())
+	{
+		SymbolicAnalysis();
+
+		if (m_print_level > 0)
+		{
+			feLog("Multifrontal solver:\n");
+			feLog("\tNr of supernodes .......................... : %d\n", (int)m_sn.size());
+			feLog("\tNr of levels in assembly tree ............. : %d\n", (int)m_level.size());
+			feLog("\tNr of nonzeroes in factor ................. : %lg\n", m_nnzL);
+		}
+	}
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+void MultifrontalSolver::SymbolicAnalysis()
+{
+	int n = m_pA->Rows();
+	int nnz = m_pA->NonZeroes();
+
+	// store the sparsity pattern so we can detect changes
+	m_ptr.assign(m_pA->Pointers(), m_pA->Pointers() + n + 1);
+	m_ind.assign(m_pA->Indices(), m_pA->Indices() + nnz);
+
+	// build the adjacency graph of A + A^T
+	std::vector<int> xadj, adj;
+	BuildGraph(xadj, adj);
+
+	// find the fill-reducing ordering
+	Reorder(xadj, adj);
+
+	// find the elimination tree and supernodes
+	BuildSupernodes(xadj, adj);
+
+	// setup the map from matrix values to fronts
+	BuildAssemblyMap();
+
+	m_bsymbolic = true;
+}
+
+//-----------------------------------------------------------------------------
+// Build the adjacency graph of the (structurally symmetrized) matrix,
+// excluding the diagonal.
+void MultifrontalSolver::BuildGraph(std::vector<int>& xadj, std::vector<int>& adj)
+{
+	int n = m_pA->Rows();
+	int offset = m_pA->Offset();
+	const int* pp = m_pA->Pointers();
+	const int* pi = m_pA->Indices();
+
+	std::vector<int> cnt(n + 1, 0);
+	for (int j = 0; j < n; ++j)
+	{
+		for (int k = pp[j] - offset; k < pp[j + 1] - offset; ++k)
+		{
+			int i = pi[k] - offset;
+			if (i != j) { cnt[i]++; cnt[j]++; }
+		}
+	}
+
+	xadj.assign(n + 1, 0);
+	for (int i = 0; i < n; ++i) xadj[i + 1] = xadj[i] + cnt[i];
+	adj.resize(xadj[n]);
+	for (int i = 0; i < n; ++i) cnt[i] = xadj[i];
+	for (int j = 0; j < n; ++j)
+	{
+		for (int k = pp[j] - offset; k < pp[j + 1] - offset; ++k)
+		{
+			int i = pi[k] - offset;
+			if (i != j) { adj[cnt[i]++] = j; adj[cnt[j]++] = i; }
+		}
+	}
+
+	// remove duplicates
+	int m = 0;
+	for (int i = 0; i < n; ++i)
+	{
+		int* a = &adj[0] + xadj[i];
+		int na = xadj[i + 1] - xadj[i];
+		std::sort(a, a + na);
+		int n0 = m;
+		for (int k = 0; k < na; ++k)
+		{
+			if ((k == 0) || (a[k] != a[k - 1])) adj[m++] = a[k];
+		}
+		xadj[i] = n0;
+	}
+	xadj[n] = m;
+	adj.resize(m);
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the fill-reducing ordering. Since in FE problems all the degrees 
+// of freedom of a node have the same connectivity, the graph is first compressed
+// by merging equations with the same adjacency. The ordering is then done on the
+// compressed graph.
+void MultifrontalSolver::Reorder(const std::vector<int>& xadj, const std::vector<int>& adj)
+{
+	int n = (int)xadj.size() - 1;
+
+	// hash the adjacency (including the node itself)
+	std::vector<long long> hash(n);
+	for (int i = 0; i < n; ++i)
+	{
+		long long h = i;
+		for (int k = xadj[i]; k < xadj[i + 1]; ++k) h += adj[k];
+		hash[i] = h;
+	}
+
+	std::vector<int> idx(n);
+	for (int i = 0; i < n; ++i) idx[i] = i;
+	std::sort(idx.begin(), idx.end(), [&](int a, int b) {
+		if (hash[a] != hash[b]) return hash[a] < hash[b];
+		return a < b;
+	});
+
+	// find the indistinguishable nodes
+	std::vector<int> group(n, -1), mark(n, -1);
+	int ng = 0;
+	for (int i0 = 0; i0 < n;)
+	{
+		int i1 = i0 + 1;
+		while ((i1 < n) && (hash[idx[i1]] == hash[idx[i0]])) i1++;
+
+		for (int k = i0; k < i1; ++k)
+		{
+			int a = idx[k];
+			if (group[a] >= 0) continue;
+			group[a] = ng;
+
+			int na = xadj[a + 1] - xadj[a];
+			if (k + 1 < i1)
+			{
+				mark[a] = a;
+				for (int j = xadj[a]; j < xadj[a + 1]; ++j) mark[adj[j]] = a;
+
+				for (int l = k + 1; l < i1; ++l)
+				{
+					int b = idx[l];
+					if ((group[b] >= 0) || (xadj[b + 1] - xadj[b] != na) || (mark[b] != a)) continue;
+					bool same = true;
+					for (int j = xadj[b]; j < xadj[b + 1]; ++j)
+						if (mark[adj[j]] != a) { same = false; break; }
+					if (same) group[b] = ng;
+				}
+			}
+			ng++;
+		}
+		i0 = i1;
+	}
+
+	// members of each group
+	std::vector<int> gptr(ng + 1, 0), gmem(n), w(ng);
+	for (int i = 0; i < n; ++i) gptr[group[i] + 1]++;
+	for (int i = 0; i < ng; ++i) { w[i] = gptr[i + 1]; gptr[i + 1] += gptr[i]; }
+	std::vector<int> pos(gptr.begin(), gptr.end() - 1);
+	for (int i = 0; i < n; ++i) gmem[pos[group[i]]++] = i;
+
+	// build the compressed graph
+	std::vector<int> cxadj(ng + 1, 0), cadj;
+	cadj.reserve(adj.size() / 2);
+	std::vector<int> tag(ng, -1);
+	for (int g = 0; g < ng; ++g)
+	{
+		int a = gmem[gptr[g]];
+		tag[g] = g;
+		for (int j = xadj[a]; j < xadj[a + 1]; ++j)
+		{
+			int h = group[adj[j]];
+			if (tag[h] != g) { tag[h] = g; cadj.push_back(h); }
+		}
+		cxadj[g + 1] = (int)cadj.size();
+	}
+
+	// do the ordering on the compressed graph
+	std::vector<int> order;
+	amd_order(ng, cxadj, cadj, w, order);
+
+	// expand the ordering
+	m_perm.resize(n);
+	m_iperm.resize(n);
+	int m = 0;
+	for (int k = 0; k < ng; ++k)
+	{
+		int g = order[k];
+		for (int j = gptr[g]; j < gptr[g + 1]; ++j) m_perm[m++] = gmem[j];
+	}
+	assert(m == n);
+	for (int k = 0; k < n; ++k) m_iperm[m_perm[k]] = k;
+}
+
+//-----------------------------------------------------------------------------
+// Calculate the elimination tree of the permuted matrix and find the 
+// (fundamental) supernodes and their row structure. 
+void MultifrontalSolver::BuildSupernodes(const std::vector<int>& xadj, const std::vector<int>& adj)
+{
+	int n = (int)xadj.size() - 1;
+
+	// elimination tree
+	std::vector<int> parent(n, -1), ancestor(n, -1);
+	for (int k = 0; k < n; ++k)
+	{
+		int i = m_perm[k];
+		for (int l = xadj[i]; l < xadj[i + 1]; ++l)
+		{
+			int j = m_iperm[adj[l]];
+			while ((j != -1) && (j < k))
+			{
+				int jnext = ancestor[j];
+				ancestor[j] = k;
+				if (jnext == -1) parent[j] = k;
+				j = jnext;
+			}
+		}
+	}
+
+	// children of each column
+	std::vector<int> childHead(n, -1), childNext(n, -1), nchild(n, 0);
+	for (int j = n - 1; j >= 0; --j)
+	{
+		int p = parent[j];
+		if (p >= 0) { childNext[j] = childHead[p]; childHead[p] = j; nchild[p]++; }
+	}
+
+	// find the supernodes and their row structure
+	m_sn.clear();
+	m_snode.assign(n, -1);
+	std::vector<int> marker(n, -1);
+	for (int k = 0; k < n; ++k)
+	{
+		int i = m_perm[k];
+
+		// see if we can add this column to the previous supernode
+		bool merge = false;
+		if ((k > 0) && (nchild[k] == 1) && (parent[k - 1] == k))
+		{
+			int S = m_snode[k - 1];
+			merge = true;
+			for (int l = xadj[i]; l < xadj[i + 1]; ++l)
+			{
+				int r = m_iperm[adj[l]];
+				if ((r > k) && (marker[r] != S)) { merge = false; break; }
+			}
+		}
+
+		if (merge)
+		{
+			int S = m_snode[k - 1];
+			m_snode[k] = S;
+			m_sn[S].ncol++;
+		}
+		else
+		{
+			int T = (int)m_sn.size();
+			m_sn.push_back(Supernode());
+			Supernode& sn = m_sn.back();
+			sn.col0 = k;
+			sn.ncol = 1;
+			sn.parent = -1;
+
+			std::vector<int>& rows = sn.rows;
+			marker[k] = T; rows.push_back(k);
+			for (int l = xadj[i]; l < xadj[i + 1]; ++l)
+			{
+				int r = m_iperm[adj[l]];
+				if ((r > k) && (marker[r] != T)) { marker[r] = T; rows.push_back(r); }
+			}
+
+			for (int c = childHead[k]; c >= 0; c = childNext[c])
+			{
+				Supernode& sc = m_sn[m_snode[c]];
+				for (size_t l = sc.ncol; l < sc.rows.size(); ++l)
+				{
+					int r = sc.rows[l];
+					if (marker[r] != T) { marker[r] = T; rows.push_back(r); }
+				}
+			}
+
+			std::sort(rows.begin(), rows.end());
+			m_snode[k] = T;
+		}
+	}
+
+	// setup the supernodal tree
+	int nsn = (int)m_sn.size();
+	m_nnzL = 0.0;
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& sn = m_sn[s];
+		int p = parent[sn.col0 + sn.ncol - 1];
+		sn.parent = (p >= 0 ? m_snode[p] : -1);
+		if (sn.parent >= 0) m_sn[sn.parent].child.push_back(s);
+
+		double m = (double) sn.rows.size();
+		m_nnzL += sn.ncol*m - 0.5*sn.ncol*(sn.ncol - 1.0);
+	}
+
+	// find the location of the update rows in the parent's front
+	std::vector<int> pos(n, -1);
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& sn = m_sn[s];
+		for (size_t l = 0; l < sn.rows.size(); ++l) pos[sn.rows[l]] = (int)l;
+		for (size_t c = 0; c < sn.child.size(); ++c)
+		{
+			Supernode& sc = m_sn[sn.child[c]];
+			int nu = (int)sc.rows.size() - sc.ncol;
+			sc.relind.resize(nu);
+			for (int l = 0; l < nu; ++l) sc.relind[l] = pos[sc.rows[sc.ncol + l]];
+		}
+	}
+
+	// group the supernodes in levels. Supernodes in the same level are independent.
+	// (Note that children are always numbered before their parents)
+	std::vector<int> level(nsn, 0);
+	int maxLevel = 0;
+	for (int s = 0; s < nsn; ++s)
+	{
+		int p = m_sn[s].parent;
+		if ((p >= 0) && (level[p] < level[s] + 1)) level[p] = level[s] + 1;
+		if (level[s] > maxLevel) maxLevel = level[s];
+	}
+	m_level.assign(nsn > 0 ? maxLevel + 1 : 0, std::vector<int>());
+	for (int s = 0; s < nsn; ++s) m_level[level[s]].push_back(s);
+}
+
+//-----------------------------------------------------------------------------
+// For each matrix entry, find the front in which it is assembled and its position.
+void MultifrontalSolver::BuildAssemblyMap()
+{
+	int n = m_pA->Rows();
+	int nnz = m_pA->NonZeroes();
+	int offset = m_pA->Offset();
+	const int* pp = m_pA->Pointers();
+	const int* pi = m_pA->Indices();
+	bool rowBased = m_pA->isRowBased();
+	int nsn = (int)m_sn.size();
+
+	// find the (permuted) row and column of each entry
+	std::vector<int> prow(nnz), pcol(nnz);
+	for (int j = 0; j < n; ++j)
+	{
+		for (int k = pp[j] - offset; k < pp[j + 1] - offset; ++k)
+		{
+			int i = pi[k] - offset;
+			int r = (rowBased ? j : i);
+			int c = (rowBased ? i : j);
+			prow[k] = m_iperm[r];
+			pcol[k] = m_iperm[c];
+		}
+	}
+
+	// sort entries by supernode
+	m_amapPtr.assign(nsn + 1, 0);
+	for (int k = 0; k < nnz; ++k)
+	{
+		int c = (prow[k] < pcol[k] ? prow[k] : pcol[k]);
+		m_amapPtr[m_snode[c] + 1]++;
+	}
+	for (int s = 0; s < nsn; ++s) m_amapPtr[s + 1] += m_amapPtr[s];
+	std::vector<int> tmp(m_amapPtr.begin(), m_amapPtr.end() - 1);
+	m_amapNz.resize(nnz);
+	for (int k = 0; k < nnz; ++k)
+	{
+		int c = (prow[k] < pcol[k] ? prow[k] : pcol[k]);
+		m_amapNz[tmp[m_snode[c]]++] = k;
+	}
+
+	// calculate the position in the front
+	m_amapPos.resize(nnz);
+	std::vector<int> pos(n, -1);
+	for (int s = 0; s < nsn; ++s)
+	{
+		Supernode& sn = m_sn[s];
+		size_t m = sn.rows.size();
+		for (size_t l = 0; l < m; ++l) pos[sn.rows[l]] = (int)l;
+
+		for (int l = m_amapPtr[s]; l < m_amapPtr[s + 1]; ++l)
+		{
+			int k = m_amapNz[l];
+			int r = prow[k];
+			int c = pcol[k];
+
+			// for symmetric matrices we only assemble the lower triangular part
+			if (m_bsymm && (r < c)) { int t = r; r = c; c = t; }
+
+			m_amapPos[l] = (size_t)pos[r] + (size_t)pos[c] * m;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool MultifrontalSolver::Factor()
+{
+	if (m_bsymbolic == false) return false;
+
+	int nsn = (int)m_sn.size();
+	m_L.assign(nsn, std::vector<double>());
+	m_U.assign(m_bsymm ? 0 : nsn, std::vector<double>());
+	m_C.assign(nsn, std::vector<double>());
+	m_bfactored = false;
+
+	const double* pv = m_pA->Values();
+	int nthreads = omp_get_max_threads();
+
+	// process the assembly tree from the leaves to the roots
+	bool bok = true;
+	for (size_t l = 0; l < m_level.size(); ++l)
+	{
+		const std::vector<int>& level = m_level[l];
+		int nl = (int)level.size();
+
+		if ((nl > 1) && (nl >= nthreads))
+		{
+			// there are enough supernodes in this level to keep all threads busy
+			#pragma omp parallel for schedule(dynamic)
+			for (int i = 0; i < nl; ++i)
+			{
+				if (FactorSupernode(level[i], pv, false) == false)
+				{
+					#pragma omp critical
+					bok = false;
+				}
+			}
+		}
+		else
+		{
+			// process the supernodes one by one, but use threads within each front
+			for (int i = 0; i < nl; ++i)
+			{
+				if (FactorSupernode(level[i], pv, true) == false) bok = false;
+			}
+		}
+
+		if (bok == false) break;
+	}
+
+	m_C.clear();
+
+	if (bok == false)
+	{
+		feLogError("Zero pivot encountered in multifrontal solver.");
+		return false;
+	}
+
+	m_bfactored = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Assemble and factor the front of a supernode. This calculates the panels
+// of the factor and the contribution block that is passed on to the parent.
+// If bpar is true, the update of the front is done in parallel.
+bool MultifrontalSolver::FactorSupernode(int s, const double* pv, bool bpar)
+{
+	Supernode& sn = m_sn[s];
+	const int m = (int)sn.rows.size();
+	const int nc = sn.ncol;
+	const int nu = m - nc;
+
+	// assemble the matrix entries
+	std::vector<double> F((size_t)m*m, 0.0);
+	for (int l = m_amapPtr[s]; l < m_amapPtr[s + 1]; ++l) F[m_amapPos[l]] += pv[m_amapNz[l]];
+
+	// add the contribution blocks of the children
+	for (size_t c = 0; c < sn.child.size(); ++c)
+	{
+		int ci = sn.child[c];
+		std::vector<double>& C = m_C[ci];
+		const std::vector<int>& rel = m_sn[ci].relind;
+		const int mc = (int)rel.size();
+		for (int j = 0; j < mc; ++j)
+		{
+			double* Fj = &F[0] + (size_t)rel[j] * m;
+			const double* Cj = &C[0] + (size_t)j*mc;
+			for (int i = (m_bsymm ? j : 0); i < mc; ++i) Fj[rel[i]] += Cj[i];
+		}
+		std::vector<double>().swap(C);
+	}
+
+	bool bok = true;
+	if (m_bsymm)
+	{
+		// LDL^T factorization of the pivot columns
+		for (int k = 0; k < nc; ++k)
+		{
+			double* Fk = &F[0] + (size_t)k*m;
+			const double d = Fk[k];
+			if ((d == 0.0) || (d != d)) { bok = false; break; }
+
+			for (int i = k + 1; i < m; ++i) Fk[i] /= d;
+			for (int j = k + 1; j < nc; ++j)
+			{
+				double* Fj = &F[0] + (size_t)j*m;
+				const double a = Fk[j] * d;
+				if (a != 0.0) for (int i = j; i < m; ++i) Fj[i] -= a*Fk[i];
+			}
+		}
+
+		// update the contribution block
+		if (bok)
+		{
+			#pragma omp parallel for schedule(dynamic, 8) if (bpar && (nu > 64))
+			for (int jj = 0; jj < nu; ++jj)
+			{
+				const int j = nc + jj;
+				double* Fj = &F[0] + (size_t)j*m;
+				const double* Fk = &F[0];
+				int k = 0;
+				for (; k + 3 < nc; k += 4, Fk += 4*m)
+				{
+					const double* F0 = Fk;
+					const double* F1 = F0 + m;
+					const double* F2 = F1 + m;
+					const double* F3 = F2 + m;
+					const double a0 = F0[j] * F0[k    ];
+					const double a1 = F1[j] * F1[k + 1];
+					const double a2 = F2[j] * F2[k + 2];
+					const double a3 = F3[j] * F3[k + 3];
+					for (int i = j; i < m; ++i) Fj[i] -= a0*F0[i] + a1*F1[i] + a2*F2[i] + a3*F3[i];
+				}
+				for (; k < nc; ++k, Fk += m)
+				{
+					const double a = Fk[j] * Fk[k];
+					if (a != 0.0) for (int i = j; i < m; ++i) Fj[i] -= a*Fk[i];
+				}
+			}
+		}
+	}
+	else
+	{
+		// LU factorization of the pivot columns
+		for (int k = 0; k < nc; ++k)
+		{
+			double* Fk = &F[0] + (size_t)k*m;
+			const double d = Fk[k];
+			if ((d == 0.0) || (d != d)) { bok = false; break; }
+
+			for (int i = k + 1; i < m; ++i) Fk[i] /= d;
+			for (int j = k + 1; j < nc; ++j)
+			{
+				double* Fj = &F[0] + (size_t)j*m;
+				const double u = Fj[k];
+				if (u != 0.0) for (int i = k + 1; i < m; ++i) Fj[i] -= u*Fk[i];
+			}
+		}
+
+		// calculate the U panel and update the contribution block
+		if (bok)
+		{
+			#pragma omp parallel for schedule(dynamic, 8) if (bpar && (nu > 64))
+			for (int jj = 0; jj < nu; ++jj)
+			{
+				double* Fj = &F[0] + (size_t)(nc + jj)*m;
+
+				// U panel
+				for (int k = 0; k < nc; ++k)
+				{
+					const double* Fk = &F[0] + (size_t)k*m;
+					const double u = Fj[k];
+					if (u != 0.0) for (int i = k + 1; i < nc; ++i) Fj[i] -= u*Fk[i];
+				}
+
+				// contribution block
+				const double* Fk = &F[0];
+				int k = 0;
+				for (; k + 3 < nc; k += 4, Fk += 4*m)
+				{
+					const double* F0 = Fk;
+					const double* F1 = F0 + m;
+					const double* F2 = F1 + m;
+					const double* F3 = F2 + m;
+					const double u0 = Fj[k], u1 = Fj[k + 1], u2 = Fj[k + 2], u3 = Fj[k + 3];
+					for (int i = nc; i < m; ++i) Fj[i] -= u0*F0[i] + u1*F1[i] + u2*F2[i] + u3*F3[i];
+				}
+				for (; k < nc; ++k, Fk += m)
+				{
+					const double u = Fj[k];
+					if (u != 0.0) for (int i = nc; i < m; ++i) Fj[i] -= u*Fk[i];
+				}
+			}
+		}
+	}
+
+	if (bok == false) return false;
+
+	// store the L panel
+	m_L[s].assign(F.begin(), F.begin() + (size_t)nc*m);
+
+	// store the U panel
+	if (m_bsymm == false)
+	{
+		std::vector<double>& U = m_U[s];
+		U.resize((size_t)nc*nu);
+		for (int jj = 0; jj < nu; ++jj)
+		{
+			const double* Fj = &F[0] + (size_t)(nc + jj)*m;
+			for (int k = 0; k < nc; ++k) U[(size_t)jj*nc + k] = Fj[k];
+		}
+	}
+
+	// store the contribution block for the parent
+	if ((nu > 0) && (sn.parent >= 0))
+	{
+		std::vector<double>& C = m_C[s];
+		C.resize((size_t)nu*nu);
+		for (int jj = 0; jj < nu; ++jj)
+		{
+			const double* Fj = &F[0] + (size_t)(nc + jj)*m + nc;
+			double* Cj = &C[0] + (size_t)jj*nu;
+			for (int ii = 0; ii < nu; ++ii) Cj[ii] = Fj[ii];
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool MultifrontalSolver::BackSolve(double* x, double* b)
+{
+	if (m_bfactored == false) return false;
+
+	int n = (int)m_perm.size();
+	m_y.resize(n);
+	double* y = (n > 0 ? &m_y[0] : nullptr);
+	for (int k = 0; k < n; ++k) y[k] = b[m_perm[k]];
+
+	int nsn = (int)m_sn.size();
+
+	// forward substitution
+	for (int s = 0; s < nsn; ++s)
+	{
+		const Supernode& sn = m_sn[s];
+		const int m = (int)sn.rows.size();
+		const int* rows = &sn.rows[0];
+		for (int k = 0; k < sn.ncol; ++k)
+		{
+			const double yk = y[sn.col0 + k];
+			if (yk == 0.0) continue;
+			const double* Lk = &m_L[s][0] + (size_t)k*m;
+			for (int i = k + 1; i < m; ++i) y[rows[i]] -= Lk[i] * yk;
+		}
+	}
+
+	if (m_bsymm)
+	{
+		// diagonal scaling
+		for (int s = 0; s < nsn; ++s)
+		{
+			const Supernode& sn = m_sn[s];
+			const int m = (int)sn.rows.size();
+			for (int k = 0; k < sn.ncol; ++k) y[sn.col0 + k] /= m_L[s][(size_t)k*m + k];
+		}
+
+		// backward substitution
+		for (int s = nsn - 1; s >= 0; --s)
+		{
+			const Supernode& sn = m_sn[s];
+			const int m = (int)sn.rows.size();
+			const int* rows = &sn.rows[0];
+			for (int k = sn.ncol - 1; k >= 0; --k)
+			{
+				const double* Lk = &m_L[s][0] + (size_t)k*m;
+				double sum = 0.0;
+				for (int i = k + 1; i < m; ++i) sum += Lk[i] * y[rows[i]];
+				y[sn.col0 + k] -= sum;
+			}
+		}
+	}
+	else
+	{
+		// backward substitution
+		for (int s = nsn - 1; s >= 0; --s)
+		{
+			const Supernode& sn = m_sn[s];
+			const int m = (int)sn.rows.size();
+			const int nc = sn.ncol;
+			const int nu = m - nc;
+			const int* rows = &sn.rows[0];
+			const double* L = &m_L[s][0];
+			const double* U = (nu > 0 ? &m_U[s][0] : nullptr);
+			for (int k = nc - 1; k >= 0; --k)
+			{
+				double sum = y[sn.col0 + k];
+				for (int i = k + 1; i < nc; ++i) sum -= L[(size_t)i*m + k] * y[sn.col0 + i];
+				for (int jj = 0; jj < nu; ++jj) sum -= U[(size_t)jj*nc + k] * y[rows[nc + jj]];
+				y[sn.col0 + k] = sum / L[(size_t)k*m + k];
+			}
+		}
+	}
+
+	for (int k = 0; k < n; ++k) x[m_perm[k]] = y[k];
+
+	// update stats
+	UpdateStats(1);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void MultifrontalSolver::Destroy()
+{
+	// Only the numerical factorization is cleared. The symbolic analysis
+	// is kept so that it can be reused if the matrix structure does not change.
+	m_L.clear();
+	m_U.clear();
+	m_C.clear();
+	m_bfactored = false;
+	LinearSolver::Destroy();
+}
@@ -0,0 +1,121 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2020 University of Utah, The Trustees of Columbia University in 
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include "CompactSymmMatrix.h"
+#include "CompactUnSymmMatrix.h"
+
+//-----------------------------------------------------------------------------
+//! Multithreaded sparse direct solver that does not require any third-party
+//! libraries. 
+
+//! The equations are reordered with an approximate minimum degree ordering
+//! to reduce fill-in. A supernodal symbolic analysis then defines the assembly
+//! tree, which is used by a multifrontal numerical factorization. Independent 
+//! branches of the tree are processed in parallel, and the dense kernels of
+//! the large fronts near the root are threaded as well. 
+//! Symmetric matrices are factored as LDL^T, unsymmetric matrices as LU. Like
+//! the skyline solver, no pivoting is done. 
+//! The symbolic analysis is only redone when the sparsity pattern of the 
+//! matrix changes, so it is reused across stiffness reformations.
+
+class MultifrontalSolver : public LinearSolver
+{
+	// A supernode is a set of contiguous columns of the factor with the same
+	// sparsity pattern. Each supernode defines one front of the factorization.
+	struct Supernode
+	{
+		int		col0;	//!< first column
+		int		ncol;	//!< number of columns
+		int		parent;	//!< parent supernode (-1 for roots)
+		std::vector<int>	rows;	//!< row indices of front (first ncol are the supernode's columns)
+		std::vector<int>	relind;	//!< location of the update rows in the parent's front
+		std::vector<int>	child;	//!< child supernodes
+	};
+
+public:
+	//! constructor
+	MultifrontalSolver(FEModel* fem);
+
+	//! Preprocess (does the symbolic analysis)
+	bool PreProcess() override;
+
+	//! Factor matrix
+	bool Factor() override;
+
+	//! Backsolve the linear system
+	bool BackSolve(double* x, double* b) override;
+
+	//! Clean up
+	void Destroy() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! Set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	//! set the print level
+	void SetPrintLevel(int n) override;
+
+private:
+	bool PatternChanged() const;
+	void SymbolicAnalysis();
+	void BuildGraph(std::vector<int>& xadj, std::vector<int>& adj);
+	void Reorder(const std::vector<int>& xadj, const std::vector<int>& adj);
+	void BuildSupernodes(const std::vector<int>& xadj, const std::vector<int>& adj);
+	void BuildAssemblyMap();
+	bool FactorSupernode(int n, const double* pv, bool bpar);
+
+private:
+	CompactMatrix*	m_pA;		//!< the sparse matrix
+	bool			m_bsymm;	//!< symmetric (LDL^T) or unsymmetric (LU) factorization
+	int				m_print_level;
+
+	// symbolic data
+	bool				m_bsymbolic;	//!< symbolic analysis is valid
+	std::vector<int>	m_ptr, m_ind;	//!< copy of the sparsity pattern used for the symbolic analysis
+	std::vector<int>	m_perm;			//!< fill-reducing permutation (new to old)
+	std::vector<int>	m_iperm;		//!< inverse permutation (old to new)
+	std::vector<Supernode>	m_sn;		//!< supernodes
+	std::vector<int>	m_snode;		//!< supernode of each column
+	std::vector< std::vector<int> >	m_level;	//!< supernodes in each level of the assembly tree
+	std::vector<int>	m_amapPtr;		//!< assembly map: start of each supernode's entries
+	std::vector<int>	m_amapNz;		//!< assembly map: index into matrix values
+	std::vector<size_t>	m_amapPos;		//!< assembly map: position in front
+	double				m_nnzL;			//!< nr of nonzeroes in factor
+
+	// numeric data
+	std::vector< std::vector<double> >	m_L;	//!< L panels (with pivots on diagonal)
+	std::vector< std::vector<double> >	m_U;	//!< U panels (only for LU)
+	std::vector< std::vector<double> >	m_C;	//!< contribution blocks (temp storage during factorization)
+	std::vector<double>	m_y;	//!< work vector for backsolve
+	bool	m_bfactored;
+
+	DECLARE_FECORE_CLASS();
+};
@@ -44,6 +44,7 @@ SOFTWARE.*/
 #include "BlockSolver.h"
 #include "BiCGStabSolver.h"
 #include "StrategySolver.h"
+#include "MultifrontalSolver.h"
 #include <FECore/fecore_enum.h>
 #include <FECore/FECoreFactory.h>
 #include <FECore/FECoreKernel.h>
@@ -66,6 +67,7 @@ void NumCore::InitModule()
 	REGISTER_FECORE_CLASS(BIPNSolver          , "bipn");
 	REGISTER_FECORE_CLASS(BiCGStabSolver      , "bicgstab");
 	REGISTER_FECORE_CLASS(StrategySolver      , "strategy");
+	REGISTER_FECORE_CLASS(MultifrontalSolver  , "multifrontal");
 
 	// register preconditioners
 	REGISTER_FECORE_CLASS(ILU0_Preconditioner, "ilu0");
@@ -79,6 +81,6 @@ void NumCore::InitModule()
 #ifdef PARDISO
 	fecore.SetDefaultSolverType("pardiso");
 #else
-	fecore.SetDefaultSolverType("skyline");
+	fecore.SetDefaultSolverType("multifrontal");
 #endif
 }
@@ -320,4 +320,21 @@ void PardisoSolver::Destroy()
 	m_isFactored = false;
 }
 
-#endif
+#else
+
+BEGIN_FECORE_CLASS(PardisoSolver, LinearSolver)
+END_FECORE_CLASS();
+
+PardisoSolver::PardisoSolver(FEModel* fem) : LinearSolver(fem), m_pA(0) {}
+PardisoSolver::~PardisoSolver() {}
+bool PardisoSolver::PreProcess() { return false; }
+bool PardisoSolver::Factor() { return false; }
+bool PardisoSolver::BackSolve(double* x, double* b) { return false; }
+void PardisoSolver::Destroy() {}
+SparseMatrix* PardisoSolver::CreateSparseMatrix(Matrix_Type ntype) { return 0; }
+bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA) { return false; }
+void PardisoSolver::PrintConditionNumber(bool b) {}
+double PardisoSolver::condition_number() { return 0.0; }
+void PardisoSolver::UseIterativeFactorization(bool b) {}
+
+#endif // PARDISO